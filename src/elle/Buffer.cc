@@ -153,6 +153,7 @@ namespace elle
     : _size(0)
     , _capacity(elle_buffer_initial_size)
     , _contents(static_cast<Byte*>(malloc(elle_buffer_initial_size)))
+    , _offset(0)
   {
     if (this->_contents == nullptr)
       throw std::bad_alloc();
@@ -162,6 +163,7 @@ namespace elle
     : _size(0)
     , _capacity(0)
     , _contents(nullptr)
+    , _offset(0)
   {
     if (size == 0)
     {
@@ -186,6 +188,7 @@ namespace elle
     : _size(0)
     , _capacity(0)
     , _contents(nullptr)
+    , _offset(0)
   {
     (*this) = std::move(other);
   }
@@ -194,6 +197,7 @@ namespace elle
     : _size(source._size)
     , _capacity(source._size)
     , _contents(static_cast<Byte*>(::malloc(this->_capacity)))
+    , _offset(0)
   {
     if (!this->_contents)
       throw std::bad_alloc();
@@ -207,25 +211,28 @@ namespace elle
   Buffer&
   Buffer::operator = (Buffer&& other)
   {
-    ::free(this->_contents);
+    ::free(this->_contents - this->_offset);
     this->_size = other._size;
     this->_capacity = other._capacity;
     this->_contents = other._contents;
+    this->_offset = other._offset;
     other._contents = nullptr;
     other._size = 0;
     other._capacity = 0;
+    other._offset = 0;
     return *this;
   }
 
   Buffer::~Buffer()
   {
-    ::free(this->_contents);
+    ::free(this->_contents - this->_offset);
   }
 
   void
   Buffer::capacity(Size capacity_)
   {
     auto const capacity = std::max(capacity_, elle_buffer_initial_size);
+    this->_compact();
     if (auto tmp = ::realloc(this->_contents, capacity))
     {
       this->_contents = static_cast<Byte*>(tmp);
@@ -247,8 +254,23 @@ namespace elle
   void Buffer::pop_front(Size size)
   {
     ELLE_ASSERT(size <= _size);
-    memmove(_contents, _contents + size, _size - size);
-    _size -= size;
+    this->_contents += size;
+    this->_offset += size;
+    this->_capacity -= size;
+    this->_size -= size;
+  }
+
+  void
+  Buffer::_compact()
+  {
+    if (this->_offset)
+    {
+      auto const base = this->_contents - this->_offset;
+      memmove(base, this->_contents, this->_size);
+      this->_contents = base;
+      this->_capacity += this->_offset;
+      this->_offset = 0;
+    }
   }
 
   void
@@ -268,6 +290,7 @@ namespace elle
   Buffer::ContentPair
   Buffer::release()
   {
+    this->_compact();
     auto res = ContentPair{ContentPtr{this->_contents}, this->_size};
     this->_contents = nullptr;
     this->_size = 0;
@@ -387,6 +410,7 @@ namespace elle
   void
   Buffer::shrink_to_fit()
   {
+    this->_compact();
     auto capacity = std::max(elle_buffer_initial_size, this->_size);
     if (capacity < this->_capacity)
     {
@@ -88,7 +88,7 @@ namespace elle
   public:
     /// Size of the buffer.
     ELLE_ATTRIBUTE_Rw(Size, size);
-    /// Size of the underlying allocated memory.
+    /// Size of the underlying allocated memory, from contents.
     ELLE_ATTRIBUTE_Rw(Size, capacity);
     /// Buffer data.
     ELLE_ATTRIBUTE_R(Byte*, contents);
@@ -105,7 +105,13 @@ namespace elle
     void
     shrink_to_fit();
   private:
+    /// Bytes dropped by pop_front before contents in the allocation,
+    /// reclaimed when the buffer is reallocated.
+    ELLE_ATTRIBUTE(Size, offset);
     static Size _next_size(Size);
+    /// Move the contents back to the start of the allocation.
+    void
+    _compact();
 
   public:
     static constexpr Size max_size = std::numeric_limits<Size>::max();
@@ -118,7 +124,9 @@ namespace elle
     void
     append(void const* data, Size size);
     /// Drop a number of bytes.
-    /// Costly, as it memmoves the remaing bytes.
+    ///
+    /// Constant time: the contents are not moved, the dropped space is
+    /// reclaimed upon the next reallocation.
     void
     pop_front(Size size = 1);
     /// A subset of this buffer.
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <elle/Buffer.hh>
+#include <elle/das/model.hh>
+#include <elle/das/serializer.hh>
+
+namespace elle
+{
+  namespace das
+  {
+    /// Binary serialization of Models, without a Serializer.
+    ///
+    /// serialization::binary::SerializerOut and SerializerIn reach every
+    /// value through a virtual call and every object or array through a
+    /// std::function. Here the fields of the Model are walked at compile
+    /// time and read from, or written to, a Buffer directly. The format is
+    /// the same, magic byte included: either side may be replaced by the
+    /// generic serializers.
+    ///
+    /// Fields may be integers, booleans, doubles, strings, Buffers,
+    /// std::vectors and boost::optionals, and types serialized with
+    /// ELLE_DAS_SERIALIZE, with the Model it was given.
+    ///
+    /// \code{.cc}
+    ///
+    /// ELLE_DAS_SERIALIZE(User);
+    ///
+    /// auto const buffer = elle::das::binary::serialize(user);
+    /// assert(buffer == elle::serialization::binary::serialize(user));
+    /// assert(elle::das::binary::deserialize<User>(buffer) == user);
+    ///
+    /// \endcode
+    namespace binary
+    {
+      /// Append @a o to @a output.
+      ///
+      /// @tparam M The Model of @a o.
+      template <typename T, typename M = typename DefaultModel<T>::type>
+      void
+      serialize(T const& o, elle::Buffer& output);
+      /// Serialize @a o.
+      ///
+      /// @tparam M The Model of @a o.
+      template <typename T, typename M = typename DefaultModel<T>::type>
+      elle::Buffer
+      serialize(T const& o);
+      /// Deserialize a T from @a input.
+      ///
+      /// @tparam M The Model of T.
+      /// @throw serialization::Error if the magic is wrong, or if @a input is
+      ///        truncated or continues past the value.
+      /// @throw serialization::json::Overflow if an integer does not fit.
+      template <typename T, typename M = typename DefaultModel<T>::type>
+      T
+      deserialize(elle::ConstWeakBuffer input);
+    }
+  }
+}
+
+#include <elle/das/binary.hxx>
@@ -0,0 +1,485 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <elle/err.hh>
+#include <elle/serialization/Error.hh>
+#include <elle/serialization/binary/SerializerIn.hh>
+#include <elle/serialization/binary/SerializerOut.hh>
+#include <elle/serialization/json/Error.hh>
+
+namespace elle
+{
+  namespace das
+  {
+    namespace binary
+    {
+      namespace _details
+      {
+        using Byte = elle::Buffer::Byte;
+
+        /*-------.
+        | Writer |
+        `-------*/
+
+        /// Write at the end of a Buffer. The buffer is extended to its whole
+        /// capacity while writing, and cut to what was written on
+        /// destruction.
+        class Writer
+        {
+        public:
+          Writer(elle::Buffer& output)
+            : _output(output)
+            , _pos(output.mutable_contents() + output.size())
+            , _end(_pos)
+          {}
+
+          ~Writer()
+          {
+            this->_output.size(this->_pos - this->_output.contents());
+          }
+
+          /// Room for @a size bytes at the current position.
+          Byte*
+          reserve(std::size_t size)
+          {
+            if (static_cast<std::size_t>(this->_end - this->_pos) < size)
+              this->_grow(size);
+            return this->_pos;
+          }
+
+          void
+          write(void const* data, std::size_t size)
+          {
+            if (size)
+            {
+              std::memcpy(this->reserve(size), data, size);
+              this->_pos += size;
+            }
+          }
+
+          void
+          number(int64_t n)
+          {
+            using Out = serialization::binary::SerializerOut;
+            auto const output = this->reserve(Out::number_max_size);
+            // Small positive numbers, sizes and booleans, are a single byte.
+            if (0 <= n && n <= 0x3f)
+            {
+              *output = n;
+              ++this->_pos;
+            }
+            else
+              this->_pos += Out::serialize_number(output, n);
+          }
+
+        private:
+          void
+          _grow(std::size_t size)
+          {
+            auto const offset = this->_pos - this->_output.contents();
+            this->_output.size(offset + size);
+            this->_output.size(this->_output.capacity());
+            this->_pos = this->_output.mutable_contents() + offset;
+            this->_end =
+              this->_output.mutable_contents() + this->_output.size();
+          }
+
+          elle::Buffer& _output;
+          Byte* _pos;
+          Byte* _end;
+        };
+
+        /*-------.
+        | Reader |
+        `-------*/
+
+        class Reader
+        {
+        public:
+          Reader(elle::ConstWeakBuffer input)
+            : _pos(input.contents())
+            , _end(input.contents() + input.size())
+          {}
+
+          /// The next @a size bytes, skipped over.
+          Byte const*
+          take(std::size_t size)
+          {
+            if (this->remaining() < size)
+              elle::err<serialization::Error>(
+                "unable to read %s bytes: %s left", size, this->remaining());
+            auto const res = this->_pos;
+            this->_pos += size;
+            return res;
+          }
+
+          int64_t
+          number()
+          {
+            if (this->_pos != this->_end && !(*this->_pos & 0x40))
+            {
+              auto const c = *this->_pos++;
+              return (c & 0x80) ? -int64_t(c & 0x3f) : int64_t(c & 0x3f);
+            }
+            int64_t res;
+            this->_pos += serialization::binary::SerializerIn::serialize_number(
+              elle::ConstWeakBuffer(this->_pos, this->remaining()), res);
+            return res;
+          }
+
+          /// The size of a string or collection.
+          std::size_t
+          size()
+          {
+            auto const res = this->number();
+            if (res < 0)
+              elle::err<serialization::Error>("invalid size: %s", res);
+            return res;
+          }
+
+          std::size_t
+          remaining() const
+          {
+            return this->_end - this->_pos;
+          }
+
+          /// Check the whole input was read.
+          void
+          finish() const
+          {
+            if (this->remaining())
+              elle::err<serialization::Error>(
+                "%s trailing bytes after the value", this->remaining());
+          }
+
+        private:
+          Byte const* _pos;
+          Byte const* _end;
+        };
+
+        /*-------.
+        | Codecs |
+        `-------*/
+
+        /// How to encode a T, and decode it as field F. Unsupported types are
+        /// left incomplete.
+        template <typename T, typename = void>
+        struct Codec;
+
+        template <typename O, typename M>
+        M
+        serialized_model(das::Serializer<O, M> const*);
+
+        /// The Model T was given by ELLE_DAS_SERIALIZE.
+        template <typename T>
+        using SerializedModel = decltype(serialized_model(
+          std::declval<serialization::Serialize<T>*>()));
+
+        template <typename T>
+        struct Codec<
+          T,
+          std::enable_if_t<std::is_integral<T>::value &&
+                           !std::is_same<T, bool>::value>>
+        {
+          static
+          void
+          encode(Writer& writer, T v)
+          {
+            writer.number(v);
+          }
+
+          template <typename F>
+          static
+          T
+          decode(Reader& reader)
+          {
+            auto const value = reader.number();
+            using limits = std::numeric_limits<T>;
+            if (sizeof(T) < sizeof(int64_t))
+            {
+              if (value > int64_t(limits::max()))
+                throw serialization::json::Overflow(
+                  F::name(), sizeof(T) * 8, true, value);
+              if (value < int64_t(limits::min()))
+                throw serialization::json::Overflow(
+                  F::name(), sizeof(T) * 8, false, value);
+            }
+            return static_cast<T>(value);
+          }
+        };
+
+        template <>
+        struct Codec<bool>
+        {
+          static
+          void
+          encode(Writer& writer, bool v)
+          {
+            writer.number(v ? 1 : 0);
+          }
+
+          template <typename F>
+          static
+          bool
+          decode(Reader& reader)
+          {
+            auto const value = reader.number();
+            if (value != 0 && value != 1)
+              throw serialization::json::Overflow(F::name(), 1, true, value);
+            return value;
+          }
+        };
+
+        template <>
+        struct Codec<double>
+        {
+          static
+          void
+          encode(Writer& writer, double v)
+          {
+            writer.write(&v, sizeof v);
+          }
+
+          template <typename F>
+          static
+          double
+          decode(Reader& reader)
+          {
+            double res;
+            std::memcpy(&res, reader.take(sizeof res), sizeof res);
+            return res;
+          }
+        };
+
+        /// Strings, and classes deriving from them.
+        template <typename T>
+        struct Codec<
+          T, std::enable_if_t<std::is_base_of<std::string, T>::value>>
+        {
+          static
+          void
+          encode(Writer& writer, std::string const& v)
+          {
+            writer.number(v.size());
+            writer.write(v.data(), v.size());
+          }
+
+          template <typename F>
+          static
+          T
+          decode(Reader& reader)
+          {
+            auto const size = reader.size();
+            auto const data = reader.take(size);
+            return T(std::string(reinterpret_cast<char const*>(data), size));
+          }
+        };
+
+        template <>
+        struct Codec<elle::Buffer>
+        {
+          static
+          void
+          encode(Writer& writer, elle::Buffer const& v)
+          {
+            writer.number(v.size());
+            writer.write(v.contents(), v.size());
+          }
+
+          template <typename F>
+          static
+          elle::Buffer
+          decode(Reader& reader)
+          {
+            auto const size = reader.size();
+            return elle::Buffer(reader.take(size), size);
+          }
+        };
+
+        template <typename T, typename A>
+        struct Codec<std::vector<T, A>>
+        {
+          static
+          void
+          encode(Writer& writer, std::vector<T, A> const& v)
+          {
+            writer.number(v.size());
+            for (auto const& e: v)
+              Codec<T>::encode(writer, e);
+          }
+
+          template <typename F>
+          static
+          std::vector<T, A>
+          decode(Reader& reader)
+          {
+            auto const size = reader.size();
+            auto res = std::vector<T, A>{};
+            // Elements are at least a byte, unless they are empty objects:
+            // don't trust the size further.
+            res.reserve(std::min(size, reader.remaining()));
+            for (std::size_t i = 0; i < size; ++i)
+              res.emplace_back(Codec<T>::template decode<F>(reader));
+            return res;
+          }
+        };
+
+        template <typename T>
+        struct Codec<boost::optional<T>>
+        {
+          static
+          void
+          encode(Writer& writer, boost::optional<T> const& v)
+          {
+            Codec<bool>::encode(writer, bool(v));
+            if (v)
+              Codec<T>::encode(writer, v.get());
+          }
+
+          template <typename F>
+          static
+          boost::optional<T>
+          decode(Reader& reader)
+          {
+            if (Codec<bool>::template decode<F>(reader))
+              return Codec<T>::template decode<F>(reader);
+            else
+              return boost::none;
+          }
+        };
+
+        /// Objects, field by field.
+        template <typename O, typename M>
+        struct ModelCodec
+        {
+          template <typename F>
+          struct Encode
+          {
+            using type = int;
+            static
+            int
+            value(Writer& writer, O const& o)
+            {
+              using Field = typename M::template FieldType<F>;
+              Codec<typename Field::type>::encode(writer, Field::get(o));
+              return 0;
+            }
+          };
+
+          template <typename F>
+          struct Decode
+          {
+            using type = typename M::template FieldType<F>::type;
+            static
+            type
+            value(Reader& reader)
+            {
+              return Codec<type>::template decode<F>(reader);
+            }
+          };
+
+          template <typename F>
+          struct DecodeAssign
+          {
+            using type = bool;
+            static
+            bool
+            value(Reader& reader, O& o)
+            {
+              using Field = typename M::template FieldType<F>;
+              Field::get(o) =
+                Codec<typename Field::type>::template decode<F>(reader);
+              return false;
+            }
+          };
+
+          static
+          void
+          encode(Writer& writer, O const& o)
+          {
+            M::Fields::template map<Encode>::value(writer, o);
+          }
+
+          template <typename F = void>
+          static
+          O
+          decode(Reader& reader)
+          {
+            using constructible =
+              typename M::Types::template apply<std::is_constructible, O>;
+            return _decode(
+              reader, std::integral_constant<bool, constructible::value>{});
+          }
+
+        private:
+          /// Deserialize by constructor.
+          static
+          O
+          _decode(Reader& reader, std::true_type)
+          {
+            return std::forward_tuple(
+              [] (auto&& ... args) -> O
+              {
+                return O(std::move(args)...);
+              },
+              M::Fields::template map<Decode>::value(reader));
+          }
+
+          /// Deserialize via default construct and fields assignment.
+          static
+          O
+          _decode(Reader& reader, std::false_type)
+          {
+            O res;
+            M::Fields::template map<DecodeAssign>::value(reader, res);
+            return res;
+          }
+        };
+
+        template <typename T>
+        struct Codec<T, std::enable_if_exists_t<SerializedModel<T>>>
+          : public ModelCodec<T, SerializedModel<T>>
+        {};
+      }
+
+      template <typename T, typename M>
+      void
+      serialize(T const& o, elle::Buffer& output)
+      {
+        _details::Writer writer(output);
+        // The magic of serialization::binary::SerializerOut.
+        writer.number(0);
+        _details::ModelCodec<T, M>::encode(writer, o);
+      }
+
+      template <typename T, typename M>
+      elle::Buffer
+      serialize(T const& o)
+      {
+        auto res = elle::Buffer{};
+        binary::serialize<T, M>(o, res);
+        return res;
+      }
+
+      template <typename T, typename M>
+      T
+      deserialize(elle::ConstWeakBuffer input)
+      {
+        auto reader = _details::Reader(input);
+        if (auto const magic = *reader.take(1))
+          elle::err<serialization::Error>(
+            "wrong magic for binary serialization: 0x%02x (expected 0)",
+            int(magic));
+        auto res = _details::ModelCodec<T, M>::decode(reader);
+        reader.finish();
+        return res;
+      }
+    }
+  }
+}
@@ -0,0 +1,731 @@
+#include <elle/json/Value.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+#include <elle/Backtrace.hh>
+#include <elle/err.hh>
+#include <elle/json/exceptions.hh>
+#include <elle/printf.hh>
+#include <elle/unreachable.hh>
+
+namespace elle
+{
+  namespace json
+  {
+    namespace
+    {
+      bool
+      key_less(Value::Member const& member, std::string const& key)
+      {
+        return member.first < key;
+      }
+
+      void
+      write_string(std::string& output, std::string const& s)
+      {
+        static char const hex[] = "0123456789abcdef";
+        output += '"';
+        auto start = s.data();
+        auto const end = start + s.size();
+        for (auto it = start; it != end; ++it)
+        {
+          auto const c = static_cast<unsigned char>(*it);
+          if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+          output.append(start, it);
+          start = it + 1;
+          output += '\\';
+          switch (c)
+          {
+            case '"': output += '"'; break;
+            case '\\': output += '\\'; break;
+            case '\b': output += 'b'; break;
+            case '\f': output += 'f'; break;
+            case '\n': output += 'n'; break;
+            case '\r': output += 'r'; break;
+            case '\t': output += 't'; break;
+            default:
+              output += "u00";
+              output += hex[c >> 4];
+              output += hex[c & 0xf];
+          }
+        }
+        output.append(start, end);
+        output += '"';
+      }
+
+      void
+      write_scalar(std::string& output, Value const& value)
+      {
+        switch (value.type())
+        {
+          case Value::Type::null:
+            output += "null";
+            break;
+          case Value::Type::boolean:
+            output += value.boolean() ? "true" : "false";
+            break;
+          case Value::Type::integer:
+            output += std::to_string(value.integer());
+            break;
+          case Value::Type::unsigned_integer:
+            output += std::to_string(value.unsigned_integer());
+            break;
+          case Value::Type::real:
+          {
+            // The shortest of the two precisions that reads back exactly.
+            auto const v = value.real();
+            char digits[32];
+            auto size = std::snprintf(digits, sizeof(digits), "%.15g", v);
+            if (std::strtod(digits, nullptr) != v)
+              size = std::snprintf(digits, sizeof(digits), "%.17g", v);
+            output.append(digits, size);
+            // Keep the number a real number.
+            if (!std::strpbrk(digits, ".eani"))
+              output += ".0";
+            break;
+          }
+          case Value::Type::string:
+            write_string(output, value.string());
+            break;
+          case Value::Type::array:
+          case Value::Type::object:
+            elle::unreachable();
+        }
+      }
+
+      /// Write with an explicit stack of the containers being written and
+      /// the index of their current element, so deep nesting cannot overflow
+      /// the stack.
+      void
+      write(std::string& output, Value const& value)
+      {
+        auto stack = std::vector<std::pair<Value const*, std::size_t>>{};
+        auto next = &value;
+        while (true)
+        {
+          if (next->type() == Value::Type::array && next->size())
+          {
+            output += '[';
+            stack.emplace_back(next, 0);
+            next = &next->array().front();
+            continue;
+          }
+          else if (next->type() == Value::Type::object && next->size())
+          {
+            auto const& member = next->object().front();
+            output += '{';
+            write_string(output, member.first);
+            output += ':';
+            stack.emplace_back(next, 0);
+            next = &member.second;
+            continue;
+          }
+          else if (next->type() == Value::Type::array)
+            output += "[]";
+          else if (next->type() == Value::Type::object)
+            output += "{}";
+          else
+            write_scalar(output, *next);
+          // Move on to the next element of the innermost unfinished
+          // container.
+          while (true)
+          {
+            if (stack.empty())
+              return;
+            auto const container = stack.back().first;
+            auto const index = ++stack.back().second;
+            if (index < container->size())
+            {
+              output += ',';
+              if (container->type() == Value::Type::array)
+                next = &container->array()[index];
+              else
+              {
+                auto const& member = container->object()[index];
+                write_string(output, member.first);
+                output += ':';
+                next = &member.second;
+              }
+              break;
+            }
+            output += container->type() == Value::Type::array ? ']' : '}';
+            stack.pop_back();
+          }
+        }
+      }
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    Value::Value()
+      : _type(Type::null)
+    {}
+
+    Value::Value(NullType)
+      : Value()
+    {}
+
+    Value::Value(bool value)
+      : _type(Type::boolean)
+      , _boolean(value)
+    {}
+
+    Value::Value(double value)
+      : _type(Type::real)
+      , _real(value)
+    {}
+
+    Value::Value(std::string value)
+      : _type(Type::string)
+      , _string(std::move(value))
+    {}
+
+    Value::Value(char const* value)
+      : Value(std::string(value))
+    {}
+
+    Value::Value(Array elements)
+      : _type(Type::array)
+      , _array(std::move(elements))
+    {}
+
+    Value::Value(Object members)
+      : _type(Type::object)
+      , _object(std::move(members))
+    {
+      auto& object = this->_object;
+      auto const size = object.size();
+      auto const less = [&] (std::size_t lhs, std::size_t rhs)
+        {
+          return object[lhs].first < object[rhs].first;
+        };
+      // Members usually come sorted already.
+      auto sorted = true;
+      for (std::size_t i = 1; sorted && i < size; ++i)
+        sorted = less(i - 1, i);
+      if (sorted)
+        return;
+      // Sort indices so each member is only moved once. Objects are usually
+      // small: insertion sort them, without allocating.
+      auto small = std::array<std::size_t, 32>{};
+      auto large = std::vector<std::size_t>{};
+      auto order = small.data();
+      if (size > small.size())
+      {
+        large.resize(size);
+        order = large.data();
+      }
+      std::iota(order, order + size, 0);
+      if (size <= small.size())
+        for (std::size_t i = 1; i < size; ++i)
+        {
+          auto const index = order[i];
+          auto j = i;
+          for (; j > 0 && less(index, order[j - 1]); --j)
+            order[j] = order[j - 1];
+          order[j] = index;
+        }
+      else
+        std::stable_sort(order, order + size, less);
+      auto res = Object{};
+      res.reserve(size);
+      for (std::size_t i = 0; i < size; ++i)
+        // Keep the last of duplicate keys.
+        if (i + 1 == size || less(order[i], order[i + 1]))
+          res.emplace_back(std::move(object[order[i]]));
+      object = std::move(res);
+    }
+
+    Value::Value(Json const& json)
+      : Value()
+    {
+      auto const& type = json.type();
+      if (type == typeid(json::Object) || type == typeid(OrderedObject))
+      {
+        auto members = Value::Object{};
+        auto const add = [&] (auto const& object)
+          {
+            members.reserve(object.size());
+            for (auto const& member: object)
+              members.emplace_back(member.first, Value(member.second));
+          };
+        if (type == typeid(json::Object))
+          add(boost::any_cast<json::Object const&>(json));
+        else
+          add(boost::any_cast<OrderedObject const&>(json));
+        *this = Value(std::move(members));
+      }
+      else if (type == typeid(json::Array))
+      {
+        auto elements = Value::Array{};
+        auto const& array = boost::any_cast<json::Array const&>(json);
+        elements.reserve(array.size());
+        for (auto const& element: array)
+          elements.emplace_back(element);
+        *this = Value(std::move(elements));
+      }
+      else if (type == typeid(std::string))
+        *this = boost::any_cast<std::string const&>(json);
+      else if (type == typeid(char const*))
+        *this = boost::any_cast<char const*>(json);
+      else if (type == typeid(bool))
+        *this = boost::any_cast<bool>(json);
+      else if (type == typeid(double))
+        *this = boost::any_cast<double>(json);
+      else if (type == typeid(float))
+        *this = boost::any_cast<float>(json);
+      else if (type == typeid(NullType) || json.empty())
+      {}
+#define CASE(Type)                              \
+      else if (type == typeid(Type))            \
+        *this = boost::any_cast<Type>(json)
+      CASE(int16_t);
+      CASE(int32_t);
+      CASE(int64_t);
+      CASE(uint16_t);
+      CASE(uint32_t);
+      CASE(uint64_t);
+      CASE(long);
+      CASE(unsigned long);
+      CASE(long long);
+      CASE(unsigned long long);
+#undef CASE
+      else
+        throw TypeError(elle::sprintf("unable to make JSON from type: %s",
+                                      elle::demangle(type.name())));
+    }
+
+    Value::Value(Value const& value)
+    {
+      this->_construct(value);
+    }
+
+    Value::Value(Value&& value) noexcept
+    {
+      this->_construct(std::move(value));
+    }
+
+    Value::~Value()
+    {
+      this->_destroy();
+    }
+
+    Value&
+    Value::operator =(Value const& value)
+    {
+      if (this != &value)
+      {
+        // Copy first, value may be part of this.
+        auto copy = value;
+        *this = std::move(copy);
+      }
+      return *this;
+    }
+
+    Value&
+    Value::operator =(Value&& value) noexcept
+    {
+      if (this == &value)
+        return *this;
+      if (this->_type < Type::string)
+        // Scalars cannot contain value.
+        this->_construct(std::move(value));
+      else
+      {
+        // Move first, value may be part of this.
+        auto moved = Value(std::move(value));
+        this->_destroy();
+        this->_construct(std::move(moved));
+      }
+      return *this;
+    }
+
+    void
+    Value::_construct(Value const& value)
+    {
+      this->_type = value._type;
+      switch (value._type)
+      {
+        case Type::null:
+          break;
+        case Type::boolean:
+          this->_boolean = value._boolean;
+          break;
+        case Type::integer:
+          this->_integer = value._integer;
+          break;
+        case Type::unsigned_integer:
+          this->_unsigned_integer = value._unsigned_integer;
+          break;
+        case Type::real:
+          this->_real = value._real;
+          break;
+        case Type::string:
+          new (&this->_string) std::string(value._string);
+          break;
+        case Type::array:
+          new (&this->_array) Array(value._array);
+          break;
+        case Type::object:
+          new (&this->_object) Object(value._object);
+          break;
+      }
+    }
+
+    void
+    Value::_construct(Value&& value)
+    {
+      this->_type = value._type;
+      switch (value._type)
+      {
+        case Type::null:
+          break;
+        case Type::boolean:
+          this->_boolean = value._boolean;
+          break;
+        case Type::integer:
+          this->_integer = value._integer;
+          break;
+        case Type::unsigned_integer:
+          this->_unsigned_integer = value._unsigned_integer;
+          break;
+        case Type::real:
+          this->_real = value._real;
+          break;
+        case Type::string:
+          new (&this->_string) std::string(std::move(value._string));
+          break;
+        case Type::array:
+          new (&this->_array) Array(std::move(value._array));
+          break;
+        case Type::object:
+          new (&this->_object) Object(std::move(value._object));
+          break;
+      }
+      // Leave moved values null, cheaper to assign to.
+      value._destroy();
+    }
+
+    void
+    Value::_destroy()
+    {
+      switch (this->_type)
+      {
+        case Type::string:
+          this->_string.~basic_string();
+          break;
+        case Type::array:
+        case Type::object:
+        {
+          // Detach nested containers and destroy them one by one, so deep
+          // nesting cannot overflow the stack: each only holds leaves by the
+          // time it is destroyed.
+          auto nested = std::vector<Value>{};
+          auto const detach = [&] (Value& value)
+            {
+              if (value._type == Type::array)
+                for (auto& element: value._array)
+                  if (element._type >= Type::array)
+                    nested.emplace_back(std::move(element));
+              if (value._type == Type::object)
+                for (auto& member: value._object)
+                  if (member.second._type >= Type::array)
+                    nested.emplace_back(std::move(member.second));
+            };
+          detach(*this);
+          while (!nested.empty())
+          {
+            auto value = std::move(nested.back());
+            nested.pop_back();
+            detach(value);
+          }
+          if (this->_type == Type::array)
+            this->_array.~Array();
+          else
+            this->_object.~Object();
+          break;
+        }
+        default:
+          break;
+      }
+      this->_type = Type::null;
+    }
+
+    Json
+    Value::any() const
+    {
+      switch (this->_type)
+      {
+        case Type::null:
+          return NullType();
+        case Type::boolean:
+          return this->_boolean;
+        case Type::integer:
+          return this->_integer;
+        case Type::unsigned_integer:
+          return this->_unsigned_integer;
+        case Type::real:
+          return this->_real;
+        case Type::string:
+          return this->_string;
+        case Type::array:
+        {
+          auto res = json::Array{};
+          res.reserve(this->_array.size());
+          for (auto const& element: this->_array)
+            res.emplace_back(element.any());
+          return res;
+        }
+        case Type::object:
+        {
+          auto res = json::Object{};
+          res.reserve(this->_object.size());
+          for (auto const& member: this->_object)
+            res.emplace(member.first, member.second.any());
+          return res;
+        }
+      }
+      elle::unreachable();
+    }
+
+    /*-------.
+    | Access |
+    `-------*/
+
+    Value::Type
+    Value::type() const
+    {
+      return this->_type;
+    }
+
+    bool
+    Value::boolean() const
+    {
+      if (this->_type != Type::boolean)
+        this->_type_error(Type::boolean);
+      return this->_boolean;
+    }
+
+    int64_t
+    Value::integer() const
+    {
+      if (this->_type != Type::integer)
+        this->_type_error(Type::integer);
+      return this->_integer;
+    }
+
+    uint64_t
+    Value::unsigned_integer() const
+    {
+      if (this->_type == Type::unsigned_integer)
+        return this->_unsigned_integer;
+      if (this->_type != Type::integer)
+        this->_type_error(Type::unsigned_integer);
+      if (this->_integer < 0)
+        throw TypeError(elle::sprintf("JSON integer is negative: %s",
+                                      this->_integer));
+      return this->_integer;
+    }
+
+    double
+    Value::real() const
+    {
+      if (this->_type == Type::integer)
+        return this->_integer;
+      if (this->_type == Type::unsigned_integer)
+        return this->_unsigned_integer;
+      if (this->_type != Type::real)
+        this->_type_error(Type::real);
+      return this->_real;
+    }
+
+    std::string const&
+    Value::string() const
+    {
+      if (this->_type != Type::string)
+        this->_type_error(Type::string);
+      return this->_string;
+    }
+
+    std::string&
+    Value::string()
+    {
+      if (this->_type != Type::string)
+        this->_type_error(Type::string);
+      return this->_string;
+    }
+
+    Value::Array const&
+    Value::array() const
+    {
+      if (this->_type != Type::array)
+        this->_type_error(Type::array);
+      return this->_array;
+    }
+
+    Value::Array&
+    Value::array()
+    {
+      if (this->_type != Type::array)
+        this->_type_error(Type::array);
+      return this->_array;
+    }
+
+    Value::Object const&
+    Value::object() const
+    {
+      if (this->_type != Type::object)
+        this->_type_error(Type::object);
+      return this->_object;
+    }
+
+    std::size_t
+    Value::size() const
+    {
+      if (this->_type == Type::array)
+        return this->_array.size();
+      return this->object().size();
+    }
+
+    Value const*
+    Value::find(std::string const& key) const
+    {
+      auto const& object = this->object();
+      auto const it =
+        std::lower_bound(object.begin(), object.end(), key, &key_less);
+      if (it == object.end() || it->first != key)
+        return nullptr;
+      return &it->second;
+    }
+
+    Value*
+    Value::find(std::string const& key)
+    {
+      return const_cast<Value*>(
+        static_cast<Value const*>(this)->find(key));
+    }
+
+    Value const&
+    Value::operator [](std::string const& key) const
+    {
+      if (auto res = this->find(key))
+        return *res;
+      elle::err("missing JSON key: %s", key);
+    }
+
+    Value&
+    Value::operator [](std::string const& key)
+    {
+      if (this->_type == Type::null)
+        *this = Object{};
+      else if (this->_type != Type::object)
+        this->_type_error(Type::object);
+      auto& object = this->_object;
+      auto it = std::lower_bound(object.begin(), object.end(), key, &key_less);
+      if (it == object.end() || it->first != key)
+        it = object.emplace(it, key, Value());
+      return it->second;
+    }
+
+    Value const&
+    Value::operator [](std::size_t index) const
+    {
+      auto const& array = this->array();
+      if (index >= array.size())
+        elle::err("JSON array index out of range: %s", index);
+      return array[index];
+    }
+
+    Value&
+    Value::operator [](std::size_t index)
+    {
+      return const_cast<Value&>(static_cast<Value const&>(*this)[index]);
+    }
+
+    bool
+    Value::operator ==(Value const& other) const
+    {
+      if (this->_type != other._type)
+        return false;
+      switch (this->_type)
+      {
+        case Type::null:
+          return true;
+        case Type::boolean:
+          return this->_boolean == other._boolean;
+        case Type::integer:
+          return this->_integer == other._integer;
+        case Type::unsigned_integer:
+          return this->_unsigned_integer == other._unsigned_integer;
+        case Type::real:
+          return this->_real == other._real;
+        case Type::string:
+          return this->_string == other._string;
+        case Type::array:
+          return this->_array == other._array;
+        case Type::object:
+          return this->_object == other._object;
+      }
+      elle::unreachable();
+    }
+
+    bool
+    Value::operator !=(Value const& other) const
+    {
+      return !(*this == other);
+    }
+
+    void
+    Value::_type_error(Type expected) const
+    {
+      throw TypeError(elle::sprintf("JSON value is %s, not %s",
+                                    this->_type, expected));
+    }
+
+    /*----------.
+    | Printable |
+    `----------*/
+
+    void
+    Value::print(std::ostream& output) const
+    {
+      auto text = std::string{};
+      write(text, *this);
+      output.write(text.data(), text.size());
+    }
+
+    std::ostream&
+    operator <<(std::ostream& output, Value::Type type)
+    {
+      switch (type)
+      {
+        case Value::Type::null:
+          return output << "null";
+        case Value::Type::boolean:
+          return output << "a boolean";
+        case Value::Type::integer:
+          return output << "an integer";
+        case Value::Type::unsigned_integer:
+          return output << "an unsigned integer";
+        case Value::Type::real:
+          return output << "a real";
+        case Value::Type::string:
+          return output << "a string";
+        case Value::Type::array:
+          return output << "an array";
+        case Value::Type::object:
+          return output << "an object";
+      }
+      return output << "unknown JSON type " << static_cast<int>(type);
+    }
+  }
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <elle/Printable.hh>
+#include <elle/compiler.hh>
+#include <elle/json/json.hh>
+
+namespace elle
+{
+  namespace json
+  {
+    /// A JSON value, as a tagged union.
+    ///
+    /// Unlike Json, a boost::any that allocates every value, booleans,
+    /// numbers and null are stored inline, short strings benefit from the
+    /// small string optimization and checking the type is a comparison.
+    /// Objects are vectors of members sorted by key, looked up by binary
+    /// search. Integers are signed, unless built from an unsigned integer
+    /// past the int64_t range.
+    ///
+    /// Values convert from and to Json, so code using Json can migrate
+    /// gradually.
+    ///
+    /// Destroying and printing a Value use an explicit stack, like parsing,
+    /// so any nesting depth is safe. Copying, comparing and converting to Json
+    /// recurse, and are bounded by the stack of the calling Thread.
+    ///
+    /// \code{.cc}
+    ///
+    /// auto value = elle::json::read_value("{\"id\": 42, \"tags\": [\"a\"]}");
+    /// value["id"].integer(); // 42
+    /// value["name"] = "Paul";
+    /// std::cout << value; // {"id":42,"name":"Paul","tags":["a"]}
+    ///
+    /// \endcode
+    class ELLE_API Value
+      : public elle::Printable::as<Value>
+    {
+    /*------.
+    | Types |
+    `------*/
+    public:
+      enum class Type: uint8_t
+      {
+        null,
+        boolean,
+        integer,
+        /// An integer past the int64_t range.
+        unsigned_integer,
+        real,
+        string,
+        array,
+        object,
+      };
+      using Array = std::vector<Value>;
+      using Member = std::pair<std::string, Value>;
+      /// Members, sorted by key.
+      using Object = std::vector<Member>;
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// A null value.
+      Value();
+      Value(NullType);
+      Value(bool value);
+      template <typename T,
+                std::enable_if_t<std::is_integral<T>::value &&
+                                 !std::is_same<T, bool>::value, int> = 0>
+      Value(T value);
+      Value(double value);
+      Value(std::string value);
+      Value(char const* value);
+      Value(Array elements);
+      /// An object with @a members, in any order. If keys are duplicated,
+      /// the last one wins.
+      Value(Object members);
+      /// Convert @a json.
+      ///
+      /// @throw TypeError if @a json holds a type that is not JSON.
+      explicit
+      Value(Json const& json);
+      Value(Value const& value);
+      /// Move @a value, leaving it null.
+      Value(Value&& value) noexcept;
+      ~Value();
+      Value&
+      operator =(Value const& value);
+      Value&
+      operator =(Value&& value) noexcept;
+      /// Convert to a Json.
+      Json
+      any() const;
+
+    /*-------.
+    | Access |
+    `-------*/
+    public:
+      Type
+      type() const;
+      /// @throw TypeError if this is not a boolean.
+      bool
+      boolean() const;
+      /// @throw TypeError if this is not an integer in the int64_t range.
+      int64_t
+      integer() const;
+      /// @throw TypeError if this is not a positive or zero integer.
+      uint64_t
+      unsigned_integer() const;
+      /// The number, integers included.
+      ///
+      /// @throw TypeError if this is not a number.
+      double
+      real() const;
+      /// @throw TypeError if this is not a string.
+      std::string const&
+      string() const;
+      std::string&
+      string();
+      /// @throw TypeError if this is not an array.
+      Array const&
+      array() const;
+      Array&
+      array();
+      /// @throw TypeError if this is not an object.
+      Object const&
+      object() const;
+      /// The number of elements or members.
+      ///
+      /// @throw TypeError if this is not an array or an object.
+      std::size_t
+      size() const;
+      /// The member @a key, or null if there is none.
+      ///
+      /// @throw TypeError if this is not an object.
+      Value const*
+      find(std::string const& key) const;
+      Value*
+      find(std::string const& key);
+      /// The member @a key.
+      ///
+      /// @throw elle::Error if there is none.
+      /// @throw TypeError if this is not an object.
+      Value const&
+      operator [](std::string const& key) const;
+      /// The member @a key, added as null if there is none. A null value
+      /// becomes an empty object first.
+      ///
+      /// @throw TypeError if this is not an object.
+      Value&
+      operator [](std::string const& key);
+      /// The element at @a index.
+      ///
+      /// @throw elle::Error if @a index is out of range.
+      /// @throw TypeError if this is not an array.
+      Value const&
+      operator [](std::size_t index) const;
+      Value&
+      operator [](std::size_t index);
+      /// Whether both values are the same. Integers and reals are never
+      /// equal.
+      bool
+      operator ==(Value const& other) const;
+      bool
+      operator !=(Value const& other) const;
+
+    /*----------.
+    | Printable |
+    `----------*/
+    public:
+      /// Print as compact JSON.
+      void
+      print(std::ostream& output) const;
+
+    private:
+      void
+      _construct(Value const& value);
+      void
+      _construct(Value&& value);
+      void
+      _destroy();
+      ELLE_COMPILER_ATTRIBUTE_NORETURN
+      void
+      _type_error(Type expected) const;
+      Type _type;
+      union
+      {
+        bool _boolean;
+        int64_t _integer;
+        uint64_t _unsigned_integer;
+        double _real;
+        std::string _string;
+        Array _array;
+        Object _object;
+      };
+    };
+
+    ELLE_API
+    std::ostream&
+    operator <<(std::ostream& output, Value::Type type);
+
+    /// Read a Value from @a stream, leaving what follows the value.
+    ///
+    /// @throw ParseError if the value is invalid.
+    ELLE_API
+    Value
+    read_value(std::istream& stream);
+    /// Read a Value from @a json.
+    ///
+    /// @throw ParseError if the value is invalid.
+    /// @throw elle::Error if @a json continues past the value.
+    ELLE_API
+    Value
+    read_value(std::string const& json);
+  }
+}
+
+#include <elle/json/Value.hxx>
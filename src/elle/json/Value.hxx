@@ -0,0 +1,21 @@
+namespace elle
+{
+  namespace json
+  {
+    template <typename T,
+              std::enable_if_t<std::is_integral<T>::value &&
+                               !std::is_same<T, bool>::value, int>>
+    Value::Value(T value)
+      : _type(Type::integer)
+      , _integer(static_cast<int64_t>(value))
+    {
+      if (std::is_unsigned<T>::value &&
+          static_cast<uint64_t>(value) >
+          static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+      {
+        this->_type = Type::unsigned_integer;
+        this->_unsigned_integer = static_cast<uint64_t>(value);
+      }
+    }
+  }
+}
@@ -7,5 +7,9 @@ namespace elle
     ParseError::ParseError(std::string const& message):
       Super(message)
     {}
+
+    TypeError::TypeError(std::string const& message):
+      Super(message)
+    {}
   }
 }
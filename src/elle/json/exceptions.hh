@@ -13,5 +13,13 @@ namespace elle
       using Super = elle::Error;
       ParseError(std::string const& message);
     };
+
+    class TypeError:
+      public elle::Error
+    {
+    public:
+      using Super = elle::Error;
+      TypeError(std::string const& message);
+    };
   }
 }
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace boost
+{
+  class any;
+}
+
+namespace elle
+{
+  namespace json
+  {
+    using Json = boost::any;
+    using Array = std::vector<Json>;
+    using Object = std::unordered_map<std::string, Json>;
+    using OrderedObject = std::map<std::string, Json>;
+  }
+}
@@ -1,4 +1,3 @@
-#include <json_spirit/reader.h>
 #include <json_spirit/value.h>
 #include <json_spirit/writer.h>
 
@@ -20,45 +19,6 @@ namespace elle
 
     namespace
     {
-      Json
-      from_spirit(json_spirit::Value const& value)
-      {
-        switch (value.type())
-        {
-          case json_spirit::Value::OBJECT_TYPE:
-          {
-            auto res = Object{};
-            for (auto const& element: value.getObject())
-            {
-              // Enforce evulation order.
-              auto key = Config::get_name(element);
-              auto value = from_spirit(Config::get_value(element));
-              res.emplace(key, value);
-            }
-            return res;
-          }
-          case json_spirit::Value::ARRAY_TYPE:
-          {
-            auto res = Array{};
-            for (auto const& element: value.getArray())
-              res.emplace_back(from_spirit(element));
-            return res;
-          }
-          case json_spirit::Value::STRING_TYPE:
-            return value.getString();
-          case json_spirit::Value::BOOL_TYPE:
-            return value.getBool();
-          case json_spirit::Value::INT_TYPE:
-            return value.getInt64();
-          case json_spirit::Value::REAL_TYPE:
-            return value.getReal();
-          case json_spirit::Value::NULL_TYPE:
-            return NullType();
-          default:
-            ELLE_ABORT("unknown JSON value type");
-        }
-      }
-
       json_spirit::Value
       to_spirit(Json const& any)
       {
@@ -132,29 +92,6 @@ namespace elle
       }
     }
 
-    Json
-    read(std::istream& stream)
-    {
-      ELLE_TRACE_SCOPE("read json from stream");
-      json_spirit::Value value;
-      if (!json_spirit::read(stream, value))
-        throw ParseError(elle::sprintf("JSON error"));
-      return from_spirit(value);
-    }
-
-    Json
-    read(std::string const& json)
-    {
-      std::stringstream s(json);
-      auto res = read(s);
-      {
-        std::string word;
-        if (s >> word)
-          elle::err("garbage at end of JSON value: %s", word);
-      }
-      return res;
-    }
-
     void
     write(std::ostream& stream,
           Json const& any,
@@ -8,16 +8,12 @@
 #include <boost/any.hpp>
 
 #include <elle/compiler.hh>
+#include <elle/json/fwd.hh>
 
 namespace elle
 {
   namespace json ELLE_API
   {
-    using Json = boost::any;
-    using Array = std::vector<Json>;
-    using Object = std::unordered_map<std::string, Json>;
-    using OrderedObject = std::map<std::string, Json>;
-
     class NullType
     {};
 
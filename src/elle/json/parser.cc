@@ -0,0 +1,1035 @@
+#include <elle/json/parser.hh>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#if defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+# define ELLE_JSON_X86
+# include <immintrin.h>
+#endif
+
+#include <elle/attribute.hh>
+#include <elle/err.hh>
+#include <elle/json/Value.hh>
+#include <elle/json/exceptions.hh>
+#include <elle/log.hh>
+#include <elle/os/environ.hh>
+#include <elle/printf.hh>
+
+ELLE_LOG_COMPONENT("elle.json.parser");
+
+namespace elle
+{
+  namespace json
+  {
+    namespace parser
+    {
+      namespace
+      {
+        /// A parse error at a given position, located by the caller.
+        struct Failure
+        {
+          char const* where;
+          char const* what;
+        };
+
+        [[noreturn]]
+        void
+        fail(char const* where, char const* what)
+        {
+          throw Failure{where, what};
+        }
+
+        bool
+        whitespace(char c)
+        {
+          return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+        }
+
+        /// Characters ending a number or a literal.
+        bool
+        delimiter(char c)
+        {
+          return whitespace(c) || c == ',' || c == ']' || c == '}' ||
+            c == '[' || c == '{' || c == '"' || c == ':';
+        }
+      }
+
+      /*----------------.
+      | Instruction set |
+      `----------------*/
+
+      namespace
+      {
+        using Scan = char const* (*)(char const*, char const*);
+
+        /// The scanning primitives, for one instruction set.
+        struct Scanner
+        {
+          InstructionSet set;
+          /// The first double quote or backslash.
+          Scan string_special;
+          /// The first double quote or bracket.
+          Scan structural;
+          /// The first byte that is not ASCII.
+          Scan non_ascii;
+        };
+
+        char const*
+        string_special_scalar(char const* p, char const* end)
+        {
+          while (p != end && *p != '"' && *p != '\\')
+            ++p;
+          return p;
+        }
+
+        char const*
+        structural_scalar(char const* p, char const* end)
+        {
+          for (; p != end; ++p)
+            switch (*p)
+            {
+              case '"': case '[': case ']': case '{': case '}':
+                return p;
+            }
+          return p;
+        }
+
+        char const*
+        non_ascii_scalar(char const* p, char const* end)
+        {
+          while (p != end && !(*p & 0x80))
+            ++p;
+          return p;
+        }
+
+        Scanner const scalar_scanner = {
+          InstructionSet::scalar,
+          &string_special_scalar,
+          &structural_scalar,
+          &non_ascii_scalar,
+        };
+
+#if defined ELLE_JSON_X86 && defined __SSE2__
+# define ELLE_JSON_SSE2
+        char const*
+        string_special_sse2(char const* p, char const* end)
+        {
+          auto const quote = _mm_set1_epi8('"');
+          auto const backslash = _mm_set1_epi8('\\');
+          for (; end - p >= 16; p += 16)
+          {
+            auto const v = _mm_loadu_si128(
+              reinterpret_cast<__m128i const*>(p));
+            auto const mask = _mm_movemask_epi8(
+              _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                           _mm_cmpeq_epi8(v, backslash)));
+            if (mask)
+              return p + __builtin_ctz(mask);
+          }
+          return string_special_scalar(p, end);
+        }
+
+        char const*
+        structural_sse2(char const* p, char const* end)
+        {
+          auto const quote = _mm_set1_epi8('"');
+          auto const open_square = _mm_set1_epi8('[');
+          auto const close_square = _mm_set1_epi8(']');
+          auto const open_curly = _mm_set1_epi8('{');
+          auto const close_curly = _mm_set1_epi8('}');
+          for (; end - p >= 16; p += 16)
+          {
+            auto const v = _mm_loadu_si128(
+              reinterpret_cast<__m128i const*>(p));
+            auto const mask = _mm_movemask_epi8(
+              _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                             _mm_cmpeq_epi8(v, open_square)),
+                _mm_or_si128(
+                  _mm_or_si128(_mm_cmpeq_epi8(v, close_square),
+                               _mm_cmpeq_epi8(v, open_curly)),
+                  _mm_cmpeq_epi8(v, close_curly))));
+            if (mask)
+              return p + __builtin_ctz(mask);
+          }
+          return structural_scalar(p, end);
+        }
+
+        char const*
+        non_ascii_sse2(char const* p, char const* end)
+        {
+          for (; end - p >= 16; p += 16)
+          {
+            auto const mask = _mm_movemask_epi8(
+              _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)));
+            if (mask)
+              return p + __builtin_ctz(mask);
+          }
+          return non_ascii_scalar(p, end);
+        }
+
+        Scanner const sse2_scanner = {
+          InstructionSet::sse2,
+          &string_special_sse2,
+          &structural_sse2,
+          &non_ascii_sse2,
+        };
+#endif
+
+#ifdef ELLE_JSON_X86
+# define ELLE_JSON_AVX2
+        __attribute__((target("avx2")))
+        char const*
+        string_special_avx2(char const* p, char const* end)
+        {
+          auto const quote = _mm256_set1_epi8('"');
+          auto const backslash = _mm256_set1_epi8('\\');
+          for (; end - p >= 32; p += 32)
+          {
+            auto const v = _mm256_loadu_si256(
+              reinterpret_cast<__m256i const*>(p));
+            auto const mask = static_cast<unsigned>(_mm256_movemask_epi8(
+              _mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                              _mm256_cmpeq_epi8(v, backslash))));
+            if (mask)
+              return p + __builtin_ctz(mask);
+          }
+          return string_special_scalar(p, end);
+        }
+
+        __attribute__((target("avx2")))
+        char const*
+        structural_avx2(char const* p, char const* end)
+        {
+          auto const quote = _mm256_set1_epi8('"');
+          auto const open_square = _mm256_set1_epi8('[');
+          auto const close_square = _mm256_set1_epi8(']');
+          auto const open_curly = _mm256_set1_epi8('{');
+          auto const close_curly = _mm256_set1_epi8('}');
+          for (; end - p >= 32; p += 32)
+          {
+            auto const v = _mm256_loadu_si256(
+              reinterpret_cast<__m256i const*>(p));
+            auto const mask = static_cast<unsigned>(_mm256_movemask_epi8(
+              _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                                _mm256_cmpeq_epi8(v, open_square)),
+                _mm256_or_si256(
+                  _mm256_or_si256(_mm256_cmpeq_epi8(v, close_square),
+                                  _mm256_cmpeq_epi8(v, open_curly)),
+                  _mm256_cmpeq_epi8(v, close_curly)))));
+            if (mask)
+              return p + __builtin_ctz(mask);
+          }
+          return structural_scalar(p, end);
+        }
+
+        __attribute__((target("avx2")))
+        char const*
+        non_ascii_avx2(char const* p, char const* end)
+        {
+          for (; end - p >= 32; p += 32)
+          {
+            auto const mask = static_cast<unsigned>(_mm256_movemask_epi8(
+              _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p))));
+            if (mask)
+              return p + __builtin_ctz(mask);
+          }
+          return non_ascii_scalar(p, end);
+        }
+
+        Scanner const avx2_scanner = {
+          InstructionSet::avx2,
+          &string_special_avx2,
+          &structural_avx2,
+          &non_ascii_avx2,
+        };
+#endif
+
+        Scanner const&
+        scanner_for(InstructionSet set)
+        {
+          switch (set)
+          {
+            case InstructionSet::scalar:
+              break;
+            case InstructionSet::sse2:
+#ifdef ELLE_JSON_SSE2
+              return sse2_scanner;
+#else
+              break;
+#endif
+            case InstructionSet::avx2:
+#ifdef ELLE_JSON_AVX2
+              return avx2_scanner;
+#else
+              break;
+#endif
+          }
+          return scalar_scanner;
+        }
+
+        Scanner const*
+        select()
+        {
+          auto const forced = os::getenv("ELLE_JSON_SIMD", "");
+          for (auto set: {InstructionSet::scalar,
+                          InstructionSet::sse2,
+                          InstructionSet::avx2})
+            if (forced == elle::sprintf("%s", set))
+            {
+              if (supported(set))
+                return &scanner_for(set);
+              ELLE_WARN("ELLE_JSON_SIMD: %s is not supported", set);
+            }
+          for (auto set: {InstructionSet::avx2, InstructionSet::sse2})
+            if (supported(set))
+              return &scanner_for(set);
+          return &scalar_scanner;
+        }
+
+        Scanner const*&
+        scanner()
+        {
+          static Scanner const* res = [] {
+            auto res = select();
+            ELLE_TRACE("scan JSON with %s", res->set);
+            return res;
+          }();
+          return res;
+        }
+      }
+
+      InstructionSet
+      instruction_set()
+      {
+        return scanner()->set;
+      }
+
+      void
+      instruction_set(InstructionSet set)
+      {
+        if (!supported(set))
+          elle::err("unsupported instruction set: %s", set);
+        scanner() = &scanner_for(set);
+      }
+
+      bool
+      supported(InstructionSet set)
+      {
+        switch (set)
+        {
+          case InstructionSet::scalar:
+            return true;
+          case InstructionSet::sse2:
+#ifdef ELLE_JSON_SSE2
+            return true;
+#else
+            return false;
+#endif
+          case InstructionSet::avx2:
+#ifdef ELLE_JSON_AVX2
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+        }
+        return false;
+      }
+
+      std::ostream&
+      operator <<(std::ostream& output, InstructionSet set)
+      {
+        switch (set)
+        {
+          case InstructionSet::scalar:
+            return output << "scalar";
+          case InstructionSet::sse2:
+            return output << "sse2";
+          case InstructionSet::avx2:
+            return output << "avx2";
+        }
+        return output << "unknown instruction set " << static_cast<int>(set);
+      }
+
+      /*---------.
+      | Scanning |
+      `---------*/
+
+      char const*
+      string_special(char const* begin, char const* end)
+      {
+        return scanner()->string_special(begin, end);
+      }
+
+      char const*
+      structural(char const* begin, char const* end)
+      {
+        return scanner()->structural(begin, end);
+      }
+
+      namespace
+      {
+        /// The first invalid UTF-8 sequence in [p, end), or end.
+        char const*
+        invalid_utf8(char const* p, char const* end)
+        {
+          auto const non_ascii = scanner()->non_ascii;
+          while ((p = non_ascii(p, end)) != end)
+          {
+            auto const c = static_cast<unsigned char>(*p);
+            // Continuation bytes and overlong encodings of ASCII.
+            if (c < 0xc2 || c > 0xf4)
+              return p;
+            auto const size = c < 0xe0 ? 2 : c < 0xf0 ? 3 : 4;
+            if (end - p < size)
+              return p;
+            auto const second = static_cast<unsigned char>(p[1]);
+            // Overlong encodings, surrogates and code points past U+10FFFF.
+            auto const low =
+              c == 0xe0 ? 0xa0 : c == 0xf0 ? 0x90 : 0x80;
+            auto const high =
+              c == 0xed ? 0x9f : c == 0xf4 ? 0x8f : 0xbf;
+            if (second < low || second > high)
+              return p;
+            for (int i = 2; i < size; ++i)
+              if ((p[i] & 0xc0) != 0x80)
+                return p;
+            p += size;
+          }
+          return end;
+        }
+
+        int
+        hex(char const* p)
+        {
+          int res = 0;
+          for (int i = 0; i < 4; ++i)
+          {
+            auto const c = p[i];
+            res <<= 4;
+            if (c >= '0' && c <= '9')
+              res |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+              res |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+              res |= c - 'A' + 10;
+            else
+              fail(p + i, "invalid unicode escape");
+          }
+          return res;
+        }
+
+        void
+        utf8(std::string& res, unsigned int c)
+        {
+          if (c < 0x80)
+            res += static_cast<char>(c);
+          else if (c < 0x800)
+          {
+            res += static_cast<char>(0xc0 | (c >> 6));
+            res += static_cast<char>(0x80 | (c & 0x3f));
+          }
+          else if (c < 0x10000)
+          {
+            res += static_cast<char>(0xe0 | (c >> 12));
+            res += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+            res += static_cast<char>(0x80 | (c & 0x3f));
+          }
+          else
+          {
+            res += static_cast<char>(0xf0 | (c >> 18));
+            res += static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+            res += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+            res += static_cast<char>(0x80 | (c & 0x3f));
+          }
+        }
+
+        char const*
+        decode(char const* p, char const* end, std::string& res)
+        {
+          auto const string_special = scanner()->string_special;
+          while (true)
+          {
+            auto const special = string_special(p, end);
+            if (special == end)
+              fail(end, "unterminated string");
+            auto const invalid = invalid_utf8(p, special);
+            if (invalid != special)
+              fail(invalid, "invalid UTF-8");
+            res.append(p, special);
+            p = special + 1;
+            if (*special == '"')
+              return p;
+            if (p == end)
+              fail(end, "unterminated string");
+            switch (*p++)
+            {
+              case '"':  res += '"';  break;
+              case '\\': res += '\\'; break;
+              case '/':  res += '/';  break;
+              case 'b':  res += '\b'; break;
+              case 'f':  res += '\f'; break;
+              case 'n':  res += '\n'; break;
+              case 'r':  res += '\r'; break;
+              case 't':  res += '\t'; break;
+              case 'u':
+              {
+                if (end - p < 4)
+                  fail(end, "unterminated string");
+                unsigned int c = hex(p);
+                p += 4;
+                // Combine surrogate pairs, keep lone ones as is.
+                if (c >= 0xd800 && c < 0xdc00 && end - p >= 6 &&
+                    p[0] == '\\' && p[1] == 'u')
+                {
+                  auto const low = hex(p + 2);
+                  if (low >= 0xdc00 && low < 0xe000)
+                  {
+                    c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+                    p += 6;
+                  }
+                }
+                utf8(res, c);
+                break;
+              }
+              default:
+                fail(p - 1, "invalid escape");
+            }
+          }
+        }
+      }
+
+      bool
+      valid_utf8(char const* begin, char const* end)
+      {
+        return invalid_utf8(begin, end) == end;
+      }
+
+      char const*
+      unescape(char const* begin, char const* end, std::string& res)
+      {
+        try
+        {
+          return decode(begin, end, res);
+        }
+        catch (Failure const& f)
+        {
+          throw ParseError(
+            elle::sprintf("JSON error: %s at offset %s",
+                          f.what, f.where - begin));
+        }
+      }
+
+      /*--------.
+      | Parsing |
+      `--------*/
+
+      namespace
+      {
+        /// How to build containers of values of type T.
+        template <typename T>
+        struct Containers;
+
+        template <>
+        struct Containers<Json>
+        {
+          using Array = json::Array;
+          using Object = json::Object;
+
+          static
+          void
+          add(Object& object, std::string& key, Json&& value)
+          {
+            object[std::move(key)] = std::move(value);
+          }
+
+          /// Wrap positive integers past the int64_t range, like json_spirit.
+          static
+          Json
+          unsigned_integer(uint64_t value)
+          {
+            return static_cast<int64_t>(value);
+          }
+        };
+
+        template <>
+        struct Containers<Value>
+        {
+          using Array = Value::Array;
+          using Object = Value::Object;
+
+          /// Members are sorted when the object is built.
+          static
+          void
+          add(Object& object, std::string& key, Value&& value)
+          {
+            object.emplace_back(std::move(key), std::move(value));
+          }
+
+          static
+          Value
+          unsigned_integer(uint64_t value)
+          {
+            return value;
+          }
+        };
+
+        /// Parse with an explicit stack, so parsing deep nesting cannot
+        /// overflow the (possibly small coroutine) stack. Destroying the
+        /// result is only safe as deep for Value, which does not recurse: Json
+        /// nesting is bounded by the stack of the calling Thread.
+        template <typename T>
+        class Parser
+        {
+        public:
+          using Array = typename Containers<T>::Array;
+          using Object = typename Containers<T>::Object;
+
+        public:
+          Parser(char const* begin, char const* end)
+            : _p(begin)
+            , _end(end)
+            , _stack()
+          {}
+
+          T
+          run()
+          {
+            T value;
+            while (true)
+            {
+              this->_ws();
+              switch (this->_peek())
+              {
+                case '{':
+                  ++this->_p;
+                  this->_ws();
+                  if (this->_peek() == '}')
+                  {
+                    ++this->_p;
+                    value = Object{};
+                    break;
+                  }
+                  this->_stack.emplace_back(true);
+                  this->_key();
+                  continue;
+                case '[':
+                  ++this->_p;
+                  this->_ws();
+                  if (this->_peek() == ']')
+                  {
+                    ++this->_p;
+                    value = Array{};
+                    break;
+                  }
+                  this->_stack.emplace_back(false);
+                  continue;
+                case '"':
+                {
+                  auto s = std::string{};
+                  this->_p = decode(this->_p + 1, this->_end, s);
+                  value = std::move(s);
+                  break;
+                }
+                case 't':
+                  value = true;
+                  this->_literal("true");
+                  break;
+                case 'f':
+                  value = false;
+                  this->_literal("false");
+                  break;
+                case 'n':
+                  value = NullType{};
+                  this->_literal("null");
+                  break;
+                default:
+                  value = this->_number();
+              }
+              // Store the value in its containers, closing them as they end.
+              while (true)
+              {
+                if (this->_stack.empty())
+                  return value;
+                auto& top = this->_stack.back();
+                if (top.object)
+                  Containers<T>::add(top.members, top.key, std::move(value));
+                else
+                  top.elements.emplace_back(std::move(value));
+                this->_ws();
+                auto const close = top.object ? '}' : ']';
+                if (this->_peek() == ',')
+                {
+                  ++this->_p;
+                  this->_ws();
+                  // Tolerate trailing commas, like json_spirit.
+                  if (this->_peek() != close)
+                  {
+                    if (top.object)
+                      this->_key();
+                    break;
+                  }
+                }
+                if (this->_peek() != close)
+                  fail(this->_p, top.object ?
+                       "expected ',' or '}'" : "expected ',' or ']'");
+                ++this->_p;
+                if (top.object)
+                  value = std::move(top.members);
+                else
+                  value = std::move(top.elements);
+                this->_stack.pop_back();
+              }
+            }
+          }
+
+          ELLE_ATTRIBUTE_R(char const*, p);
+
+        private:
+          char
+          _peek() const
+          {
+            return this->_p == this->_end ? '\0' : *this->_p;
+          }
+
+          void
+          _ws()
+          {
+            while (this->_p != this->_end && whitespace(*this->_p))
+              ++this->_p;
+          }
+
+          /// Read a member key and the following colon.
+          void
+          _key()
+          {
+            if (this->_peek() != '"')
+              fail(this->_p, "expected a string key");
+            auto& key = this->_stack.back().key;
+            key.clear();
+            this->_p = decode(this->_p + 1, this->_end, key);
+            this->_ws();
+            if (this->_peek() != ':')
+              fail(this->_p, "expected ':'");
+            ++this->_p;
+          }
+
+          void
+          _literal(char const* literal)
+          {
+            auto const size = std::strlen(literal);
+            if (static_cast<std::size_t>(this->_end - this->_p) < size ||
+                std::memcmp(this->_p, literal, size) != 0)
+              fail(this->_p, "invalid literal");
+            this->_p += size;
+            if (this->_p != this->_end && !delimiter(*this->_p))
+              fail(this->_p, "invalid literal");
+          }
+
+          /// Read a number like json_spirit: integers up to 2^64 are int64,
+          /// wrapping past 2^63 unless T keeps them unsigned, the rest are
+          /// doubles.
+          T
+          _number()
+          {
+            auto const start = this->_p;
+            auto const digit = [this] {
+              return this->_p != this->_end &&
+                *this->_p >= '0' && *this->_p <= '9';
+            };
+            auto const negative = this->_peek() == '-';
+            if (negative)
+              ++this->_p;
+            if (!digit())
+              fail(start, "expected a value");
+            uint64_t value = 0;
+            bool overflow = false;
+            for (; digit(); ++this->_p)
+            {
+              auto const d = static_cast<uint64_t>(*this->_p - '0');
+              if (value > (std::numeric_limits<uint64_t>::max() - d) / 10)
+                overflow = true;
+              value = value * 10 + d;
+            }
+            bool real = false;
+            if (this->_peek() == '.')
+            {
+              real = true;
+              ++this->_p;
+              if (!digit())
+                fail(this->_p, "expected a digit");
+              while (digit())
+                ++this->_p;
+            }
+            if (this->_peek() == 'e' || this->_peek() == 'E')
+            {
+              real = true;
+              ++this->_p;
+              if (this->_peek() == '+' || this->_peek() == '-')
+                ++this->_p;
+              if (!digit())
+                fail(this->_p, "expected a digit");
+              while (digit())
+                ++this->_p;
+            }
+            if (this->_p != this->_end && !delimiter(*this->_p))
+              fail(this->_p, "invalid number");
+            auto const min =
+              static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1;
+            if (!real && !overflow && !negative && value >= min)
+              return Containers<T>::unsigned_integer(value);
+            if (!real && !overflow && (!negative || value <= min))
+              return T(negative ?
+                       static_cast<int64_t>(0 - value) :
+                       static_cast<int64_t>(value));
+            // strtod needs a terminator.
+            auto const text = std::string(start, this->_p);
+            return T(std::strtod(text.c_str(), nullptr));
+          }
+
+          ELLE_ATTRIBUTE(char const*, end);
+          struct Container
+          {
+            Container(bool object)
+              : object(object)
+            {}
+
+            bool object;
+            std::string key;
+            Object members;
+            Array elements;
+          };
+          ELLE_ATTRIBUTE(std::vector<Container>, stack);
+        };
+      }
+
+      template <typename T>
+      T
+      parse(char const* begin, char const* end, char const** stop)
+      {
+        try
+        {
+          auto parser = Parser<T>(begin, end);
+          auto res = parser.run();
+          if (stop)
+            *stop = parser.p();
+          return res;
+        }
+        catch (Failure const& f)
+        {
+          throw ParseError(
+            elle::sprintf("JSON error: %s at offset %s",
+                          f.what, f.where - begin));
+        }
+      }
+
+      template
+      Json
+      parse<Json>(char const* begin, char const* end, char const** stop);
+      template
+      Value
+      parse<Value>(char const* begin, char const* end, char const** stop);
+
+      /*-------.
+      | Framer |
+      `-------*/
+
+      constexpr std::size_t Framer::npos;
+
+      Framer::Framer()
+        : _size(0)
+        , _started(false)
+        , _scalar(false)
+        , _string(false)
+        , _escape(false)
+        , _depth(0)
+      {}
+
+      std::size_t
+      Framer::feed(char const* data, std::size_t size)
+      {
+        auto const scanner = parser::scanner();
+        auto p = data;
+        auto const end = data + size;
+        auto const done = [&] (char const* p) {
+          return this->_size + (p - data);
+        };
+        if (this->_escape && p != end)
+        {
+          this->_escape = false;
+          ++p;
+        }
+        while (p != end)
+        {
+          if (this->_string)
+          {
+            p = scanner->string_special(p, end);
+            if (p == end)
+              break;
+            if (*p == '\\')
+            {
+              if (++p == end)
+                this->_escape = true;
+              else
+                ++p;
+              continue;
+            }
+            ++p;
+            this->_string = false;
+            if (this->_depth == 0)
+              return done(p);
+          }
+          else if (!this->_started)
+          {
+            if (whitespace(*p))
+            {
+              ++p;
+              continue;
+            }
+            this->_started = true;
+            if (*p == '{' || *p == '[')
+              this->_depth = 1;
+            else if (*p == '"')
+              this->_string = true;
+            else
+              this->_scalar = true;
+            ++p;
+          }
+          else if (this->_scalar)
+          {
+            while (p != end && !delimiter(*p))
+              ++p;
+            if (p != end)
+              return done(p);
+          }
+          else
+          {
+            p = scanner->structural(p, end);
+            if (p == end)
+              break;
+            switch (*p++)
+            {
+              case '"':
+                this->_string = true;
+                break;
+              case '[': case '{':
+                ++this->_depth;
+                break;
+              default:
+                if (--this->_depth == 0)
+                  return done(p);
+            }
+          }
+        }
+        this->_size += size;
+        return npos;
+      }
+
+      std::size_t
+      Framer::finish() const
+      {
+        return this->_started ? this->_size : npos;
+      }
+
+      std::string
+      frame(std::istream& stream)
+      {
+        auto const buffer = stream.rdbuf();
+        auto text = std::string{};
+        auto framer = Framer{};
+        auto size = Framer::npos;
+        while (size == Framer::npos)
+        {
+          if (buffer->sgetc() == std::char_traits<char>::eof())
+          {
+            size = framer.finish();
+            if (size == Framer::npos)
+              throw ParseError("JSON error: unexpected end of input");
+            break;
+          }
+          // Only consume what is already buffered, in small chunks: the
+          // excess must be put back, and a file buffer may report its whole
+          // remaining size.
+          auto const available = std::max<std::streamsize>(
+            std::min<std::streamsize>(buffer->in_avail(), 4096), 1);
+          auto const previous = text.size();
+          text.resize(previous + available);
+          auto const read = buffer->sgetn(&text[previous], available);
+          text.resize(previous + read);
+          size = framer.feed(text.data() + previous, read);
+        }
+        for (auto i = text.size(); i > size; --i)
+          if (buffer->sputbackc(text[i - 1]) ==
+              std::char_traits<char>::eof())
+          {
+            ELLE_WARN("unable to put back %s bytes following JSON value",
+                      i - size);
+            break;
+          }
+        text.resize(size);
+        return text;
+      }
+    }
+
+    /*--------.
+    | Reading |
+    `--------*/
+
+    namespace
+    {
+      template <typename T>
+      T
+      read_all(std::string const& json)
+      {
+        auto const end = json.data() + json.size();
+        char const* stop = nullptr;
+        auto res = parser::parse<T>(json.data(), end, &stop);
+        while (stop != end && parser::whitespace(*stop))
+          ++stop;
+        if (stop != end)
+        {
+          auto word = stop;
+          while (word != end && !parser::whitespace(*word))
+            ++word;
+          elle::err("garbage at end of JSON value: %s",
+                    std::string(stop, word));
+        }
+        return res;
+      }
+    }
+
+    Json
+    read(std::istream& stream)
+    {
+      ELLE_TRACE_SCOPE("read json from stream");
+      auto const text = parser::frame(stream);
+      return parser::parse(text.data(), text.data() + text.size());
+    }
+
+    Json
+    read(std::string const& json)
+    {
+      return read_all<Json>(json);
+    }
+
+    Value
+    read_value(std::istream& stream)
+    {
+      ELLE_TRACE_SCOPE("read json value from stream");
+      auto const text = parser::frame(stream);
+      return parser::parse<Value>(text.data(), text.data() + text.size());
+    }
+
+    Value
+    read_value(std::string const& json)
+    {
+      return read_all<Value>(json);
+    }
+  }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#include <elle/compiler.hh>
+#include <elle/json/json.hh>
+
+namespace elle
+{
+  namespace json ELLE_API
+  {
+    class Value;
+
+    /// The JSON parser behind elle::json::read.
+    ///
+    /// Text is scanned with SSE2 or AVX2 to skip over string contents and
+    /// find structural characters, depending on the CPU, with a scalar
+    /// fallback. Strings must be valid UTF-8.
+    namespace parser
+    {
+      /*----------------.
+      | Instruction set |
+      `----------------*/
+
+      enum class InstructionSet
+      {
+        scalar,
+        sse2,
+        avx2,
+      };
+
+      /// The instruction set used to scan JSON: the best one supported by
+      /// the CPU, unless forced through ELLE_JSON_SIMD.
+      InstructionSet
+      instruction_set();
+      /// Force the instruction set used to scan JSON.
+      ///
+      /// @throw elle::Error if the CPU does not support @a set.
+      void
+      instruction_set(InstructionSet set);
+      /// Whether the CPU supports @a set.
+      bool
+      supported(InstructionSet set);
+      std::ostream&
+      operator <<(std::ostream& output, InstructionSet set);
+
+      /*---------.
+      | Scanning |
+      `---------*/
+
+      /// The first double quote or backslash in [begin, end), or end.
+      char const*
+      string_special(char const* begin, char const* end);
+      /// The first double quote or bracket in [begin, end), or end.
+      char const*
+      structural(char const* begin, char const* end);
+      /// Whether [begin, end) is valid UTF-8.
+      bool
+      valid_utf8(char const* begin, char const* end);
+      /// Decode the JSON string whose contents start at @a begin, right
+      /// after the opening quote, at the end of @a res.
+      ///
+      /// @returns The end of the string, past the closing quote.
+      /// @throw ParseError if the string is invalid or unterminated.
+      char const*
+      unescape(char const* begin, char const* end, std::string& res);
+
+      /*--------.
+      | Parsing |
+      `--------*/
+
+      /// Parse the JSON value at the beginning of [begin, end).
+      ///
+      /// @tparam T Json or Value.
+      /// @param stop Set to the end of the value, if not null.
+      /// @throw ParseError if the value is invalid.
+      template <typename T = Json>
+      T
+      parse(char const* begin, char const* end, char const** stop = nullptr);
+
+      /// Find where the first JSON value ends in text received in chunks,
+      /// to read a value from a stream without consuming what follows.
+      class Framer
+      {
+      public:
+        Framer();
+        /// Scan the next @a size bytes of text.
+        ///
+        /// @returns The size of the first value in all the text so far, or
+        ///          npos if it is not complete yet.
+        std::size_t
+        feed(char const* data, std::size_t size);
+        /// The size of the first value at the end of the text, or npos if
+        /// there is none.
+        std::size_t
+        finish() const;
+        static std::size_t constexpr npos = std::string::npos;
+
+      private:
+        /// The amount of text scanned.
+        std::size_t _size;
+        /// Whether the value has started.
+        bool _started;
+        /// Whether the value is a number or a literal.
+        bool _scalar;
+        /// Whether in a string.
+        bool _string;
+        /// Whether the last chunk ended on a backslash.
+        bool _escape;
+        /// The number of open brackets.
+        int _depth;
+      };
+
+      /// Read the text of the next JSON value in @a stream, leaving what
+      /// follows it.
+      ///
+      /// @throw ParseError if the input ends before the value.
+      std::string
+      frame(std::istream& stream);
+    }
+  }
+}
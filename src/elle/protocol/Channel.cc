@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <elle/protocol/Channel.hh>
 
 #include <elle/algorithm.hh>
@@ -16,9 +18,14 @@ namespace elle
 
     Channel::Channel(ChanneledStream& backend, int id)
       : Super(backend.scheduler())
+      , _priority(0)
+      , _statistics()
+      , _unacknowledged(0)
+      , _credited()
       , _backend(backend)
       , _id(id)
     {
+      this->_statistics.send_window = this->_backend.peer_window();
       ELLE_DEBUG_SCOPE("%s: open %s", this->_backend, *this);
       ELLE_ASSERT(!elle::contains(this->_backend._channels, this->_id));
       if (auto e = this->_backend._exception)
@@ -35,6 +42,10 @@ namespace elle
 
     Channel::Channel(Channel&& source)
       : Super(source.scheduler())
+      , _priority(source._priority)
+      , _statistics(source._statistics)
+      , _unacknowledged(source._unacknowledged)
+      , _credited(std::move(source._credited))
       , _backend(source._backend)
       , _id(source._id)
       , _packets(std::move(source._packets))
@@ -63,6 +74,7 @@ namespace elle
                      this->_available.waiters().size());
         ELLE_ASSERT(elle::contains(this->_backend._channels, this->_id));
         this->_backend._channels.erase(this->_id);
+        this->_backend._partial.erase(this->_id);
       }
     }
 
@@ -94,7 +106,43 @@ namespace elle
     elle::Buffer
     Channel::_read()
     {
-      return this->_packets.get();
+      auto packet = this->_packets.get();
+      --this->_statistics.queued_packets;
+      this->_statistics.queued_bytes -= packet.size();
+      if (this->_backend.flow_control())
+      {
+        this->_unacknowledged += packet.size();
+        // Batch credits, but let the peer send again before it runs out.
+        if (this->_unacknowledged >= this->_backend.window() / 2)
+        {
+          auto const credit = this->_unacknowledged;
+          this->_unacknowledged = 0;
+          this->_backend._write_credit(this->_id, credit);
+        }
+      }
+      return packet;
+    }
+
+    void
+    Channel::_received(elle::Buffer packet)
+    {
+      ++this->_statistics.queued_packets;
+      this->_statistics.queued_bytes += packet.size();
+      this->_statistics.queued_bytes_max = std::max(
+        this->_statistics.queued_bytes_max, this->_statistics.queued_bytes);
+      this->_packets.put(std::move(packet));
+    }
+
+    /*-------------.
+    | Flow control |
+    `-------------*/
+
+    void
+    Channel::_credit(std::size_t size)
+    {
+      ELLE_DEBUG("%s: peer granted %s bytes", this, size);
+      this->_statistics.send_window += size;
+      this->_credited.signal();
     }
 
     /*--------.
@@ -104,7 +152,7 @@ namespace elle
     void
     Channel::_write(elle::Buffer const& packet)
     {
-      this->_backend._write(packet, this->_id);
+      this->_backend._write(packet, *this);
     }
   }
 }
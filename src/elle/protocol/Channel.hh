@@ -4,6 +4,7 @@
 
 #include <elle/reactor/Channel.hh>
 #include <elle/reactor/Thread.hh>
+#include <elle/reactor/duration.hh>
 #include <elle/reactor/signal.hh>
 
 #include <elle/protocol/Stream.hh>
@@ -45,6 +46,25 @@ namespace elle
       using Self = Channel;
       using Super = Stream;
       using Id = int;
+      /// Flow control activity of a Channel.
+      struct Statistics
+      {
+        /// Packets received and not read yet.
+        std::size_t queued_packets = 0;
+        /// Bytes received and not read yet.
+        std::size_t queued_bytes = 0;
+        /// Highest number of bytes received and not read yet.
+        std::size_t queued_bytes_max = 0;
+        /// Bytes that may be sent before the peer reads some, from version
+        /// 0.5.0.
+        int64_t send_window = 0;
+        /// Frames sent, from version 0.5.0.
+        std::size_t frames_sent = 0;
+        /// Cumulated time writes waited for the peer to read.
+        reactor::Duration credit_wait;
+        /// Cumulated time writes waited for other frames to be written.
+        reactor::Duration write_wait;
+      };
 
     /*-------------.
     | Construction |
@@ -97,6 +117,26 @@ namespace elle
       void
       _write(elle::Buffer const& packet) override;
 
+    /*-------------.
+    | Flow control |
+    `-------------*/
+    public:
+      /// Channels with a higher priority write their frames first. Frames of
+      /// channels with the same priority are interleaved.
+      ELLE_ATTRIBUTE_RW(int, priority);
+      ELLE_ATTRIBUTE_R(Statistics, statistics);
+    private:
+      /// Queue a packet received from the peer.
+      void
+      _received(elle::Buffer packet);
+      /// Let the peer send @a size more bytes.
+      void
+      _credit(std::size_t size);
+      /// Bytes read and not credited back to the peer yet.
+      ELLE_ATTRIBUTE(std::size_t, unacknowledged);
+      /// Signaled when the peer grants credit or the connection fails.
+      ELLE_ATTRIBUTE(elle::reactor::Signal, credited);
+
     /*--------.
     | Details |
     `--------*/
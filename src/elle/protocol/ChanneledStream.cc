@@ -1,8 +1,12 @@
+#include <chrono>
 #include <iostream>
+#include <limits>
 
+#include <elle/finally.hh>
 #include <elle/find.hh>
 #include <elle/log.hh>
 
+#include <elle/reactor/exception.hh>
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/Thread.hh>
 
@@ -13,6 +17,60 @@
 
 ELLE_LOG_COMPONENT("elle.protocol.Channel");
 
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  elle::reactor::Duration
+  duration(Clock::time_point start)
+  {
+    return boost::posix_time::microseconds(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - start).count());
+  }
+
+  /// The type of a frame, following the channel id, from version 0.5.0.
+  enum Frame: elle::Buffer::Byte
+  {
+    /// A part of a packet, more follow.
+    keep_going = 0,
+    /// The rest of the packet being sent was dropped.
+    interrupt = 1,
+    /// The last part of a packet.
+    last = 2,
+    /// Credit granted by the reader.
+    credit = 3,
+    max = credit,
+  };
+
+  /// Check construction parameters before anything is sent to the peer.
+  elle::protocol::Stream&
+  checked(elle::protocol::Stream& backend,
+          elle::Buffer::Size window,
+          elle::Buffer::Size frame_size)
+  {
+    if (window == 0 || window > std::numeric_limits<uint32_t>::max())
+      elle::err("invalid channel window: %s", window);
+    if (frame_size == 0)
+      elle::err("invalid frame size: %s", frame_size);
+    return backend;
+  }
+
+  /// Join the frames of a packet, copying the payload once.
+  elle::Buffer
+  join(std::vector<elle::Buffer> const& frames)
+  {
+    auto size = elle::Buffer::Size{0};
+    for (auto const& frame: frames)
+      size += frame.size();
+    auto res = elle::Buffer{};
+    res.capacity(size);
+    for (auto const& frame: frames)
+      res.append(frame.contents(), frame.size());
+    return res;
+  }
+}
+
 namespace elle
 {
   namespace protocol
@@ -22,26 +80,45 @@ namespace elle
     `-------------*/
 
     ChanneledStream::ChanneledStream(elle::reactor::Scheduler& scheduler,
-                                     Stream& backend)
+                                     Stream& backend,
+                                     elle::Buffer::Size window,
+                                     elle::Buffer::Size frame_size)
       : Super(scheduler)
-      , _backend(backend)
+      , _backend(checked(backend, window, frame_size))
       , _master(this->_handshake())
       , _id_current(0)
+      , _flow_control(this->version() >= elle::Version(0, 5, 0))
+      , _window(window)
+      , _peer_window(this->_exchange_windows())
+      , _frame_size(frame_size)
+      , _writing(false)
+      , _writers()
+      , _partial()
       , _default(*this)
     {
       this->_thread.reset(
         new reactor::Thread(
           elle::sprintf("%s", this), [this] { this->_read_thread(); }));
+      if (this->_flow_control)
+        this->_credit_writer.reset(
+          new reactor::Thread(
+            elle::sprintf("%s credit writer", this),
+            [this] { this->_write_credits(); }));
     }
 
-    ChanneledStream::ChanneledStream(Stream& backend)
-      : ChanneledStream(*elle::reactor::Scheduler::scheduler(), backend)
+    ChanneledStream::ChanneledStream(Stream& backend,
+                                     elle::Buffer::Size window,
+                                     elle::Buffer::Size frame_size)
+      : ChanneledStream(*elle::reactor::Scheduler::scheduler(),
+                        backend, window, frame_size)
     {}
 
     ChanneledStream::~ChanneledStream()
     {
       try
       {
+        if (this->_credit_writer)
+          this->_credit_writer->terminate_now();
         this->_thread->terminate_now();
       }
       catch (...)
@@ -60,23 +137,51 @@ namespace elle
         while (true)
         {
           auto p = this->_backend.read();
+          // Strip the channel id in place, without moving the payload.
           int channel_id = this->uint32_get(p, this->version());
-          // FIXME: The size of the packet isn't adjusted. This is cosmetic
-          // though.
-          if (auto it = elle::find(this->_channels, channel_id))
+          if (!this->_flow_control)
           {
-            ELLE_DEBUG("received %f on channel %s", p, *it->second);
-            it->second->_packets.put(std::move(p));
+            this->_dispatch(channel_id, std::move(p));
+            continue;
           }
-          else if (this->_master && channel_id > 0
-                   || !this->_master && channel_id < 0)
-            ELLE_TRACE("discard orphaned packet on channel %s", channel_id);
-          else
+          if (p.size() < 1)
+            elle::err("missing frame type on channel %s", channel_id);
+          auto const frame = p[0];
+          p.pop_front(1);
+          switch (frame)
           {
-            auto res = Channel(*this, channel_id);
-            ELLE_DEBUG("received %f on new channel %s", p, channel_id);
-            res._packets.put(std::move(p));
-            this->_channels_new.put(std::move(res));
+            case Frame::keep_going:
+              this->_partial[channel_id].emplace_back(std::move(p));
+              break;
+            case Frame::interrupt:
+              ELLE_DEBUG("packet interrupted on channel %s", channel_id);
+              this->_partial.erase(channel_id);
+              break;
+            case Frame::last:
+            {
+              auto it = this->_partial.find(channel_id);
+              if (it != this->_partial.end())
+              {
+                it->second.emplace_back(std::move(p));
+                p = join(it->second);
+                this->_partial.erase(it);
+              }
+              this->_dispatch(channel_id, std::move(p));
+              break;
+            }
+            case Frame::credit:
+            {
+              auto const size = this->uint32_get(p, this->version());
+              if (auto it = elle::find(this->_channels, channel_id))
+                it->second->_credit(size);
+              else
+                ELLE_DEBUG("discard credit for closed channel %s",
+                           channel_id);
+              break;
+            }
+            default:
+              elle::err("invalid frame type on channel %s: %s",
+                        channel_id, int(frame));
           }
         }
       }
@@ -88,6 +193,28 @@ namespace elle
         for (auto& c: this->_channels)
           c.second->_packets.raise(std::current_exception());
         this->_exception = std::current_exception();
+        // Wake writers waiting for credit, so they fail too.
+        for (auto& c: this->_channels)
+          c.second->_credited.signal();
+      }
+    }
+
+    void
+    ChanneledStream::_dispatch(int id, elle::Buffer packet)
+    {
+      if (auto it = elle::find(this->_channels, id))
+      {
+        ELLE_DEBUG("received %f on channel %s", packet, *it->second);
+        it->second->_received(std::move(packet));
+      }
+      else if ((this->_master && id > 0) || (!this->_master && id < 0))
+        ELLE_TRACE("discard orphaned packet on channel %s", id);
+      else
+      {
+        auto res = Channel(*this, id);
+        ELLE_DEBUG("received %f on new channel %s", packet, id);
+        res._received(std::move(packet));
+        this->_channels_new.put(std::move(res));
       }
     }
 
@@ -174,14 +301,177 @@ namespace elle
     }
 
     void
-    ChanneledStream::_write(elle::Buffer const& packet, int id)
+    ChanneledStream::_write(elle::Buffer const& packet, Channel& channel)
+    {
+      ELLE_TRACE_SCOPE("%s: send %f on %s", *this, packet, channel);
+      if (!this->_flow_control)
+      {
+        // Pass the channel id as a header so the backend can frame the
+        // packet without copying it.
+        auto header = elle::Buffer{};
+        this->uint32_put(header, channel._id, this->version());
+        this->_backend.write(header, packet);
+        return;
+      }
+      auto& statistics = channel._statistics;
+      if (statistics.send_window <= 0)
+      {
+        ELLE_DEBUG("%s: wait for the peer to read", channel);
+        auto const start = Clock::now();
+        while (statistics.send_window <= 0)
+        {
+          if (auto e = this->_exception)
+            std::rethrow_exception(e);
+          reactor::wait(channel._credited);
+        }
+        statistics.credit_wait += duration(start);
+      }
+      // The whole packet is sent once the window is open, so the peer
+      // buffers at most a window plus a packet.
+      statistics.send_window -= packet.size();
+      auto sent = elle::Buffer::Size{0};
+      try
+      {
+        do
+        {
+          auto const size = std::min(this->_frame_size, packet.size() - sent);
+          auto const frame =
+            sent + size == packet.size() ? Frame::last : Frame::keep_going;
+          statistics.write_wait += this->_write_frame(
+            channel._id, frame,
+            elle::ConstWeakBuffer(packet.contents() + sent, size),
+            channel._priority);
+          sent += size;
+          ++statistics.frames_sent;
+        }
+        while (sent < packet.size());
+      }
+      catch (reactor::Terminate const&)
+      {
+        ELLE_TRACE("%s: interrupted after %s bytes", channel, sent);
+        if (sent)
+          elle::With<reactor::Thread::NonInterruptible>() << [&]
+          {
+            this->_write_frame(channel._id, Frame::interrupt, {},
+                               std::numeric_limits<int>::max());
+          };
+        statistics.send_window += packet.size();
+        throw;
+      }
+    }
+
+    reactor::Duration
+    ChanneledStream::_write_frame(int id,
+                                  elle::Buffer::Byte frame,
+                                  elle::ConstWeakBuffer payload,
+                                  int priority)
     {
-      ELLE_TRACE_SCOPE("%s: send %f on channel %s", *this, packet, id);
+      auto const res = this->_write_acquire(priority);
+      elle::SafeFinally release([this] { this->_write_release(); });
+      elle::Buffer::Byte header[uint32_max_size + 1];
+      auto const size = this->uint32_put(header, id, this->version());
+      header[size] = frame;
+      this->_backend.write(elle::ConstWeakBuffer(header, size + 1), payload);
+      return res;
+    }
 
-      auto backend_packet = elle::Buffer{};
-      this->uint32_put(backend_packet, id, this->version());
-      backend_packet.append(packet.contents(), packet.size());
-      this->_backend.write(backend_packet);
+    void
+    ChanneledStream::_write_credit(int id, std::size_t size)
+    {
+      ELLE_DEBUG("%s: grant %s bytes on channel %s", this, size, id);
+      this->_credits[id] += size;
+      this->_credits_pending.open();
+    }
+
+    void
+    ChanneledStream::_write_credits()
+    {
+      try
+      {
+        while (true)
+        {
+          reactor::wait(this->_credits_pending);
+          auto credits = Credits{};
+          std::swap(credits, this->_credits);
+          this->_credits_pending.close();
+          for (auto const& credit: credits)
+          {
+            auto payload = elle::Buffer{};
+            this->uint32_put(payload, credit.second, this->version());
+            this->_write_frame(credit.first, Frame::credit, payload,
+                               std::numeric_limits<int>::max());
+          }
+        }
+      }
+      catch (elle::Error const&)
+      {
+        // The reading thread reports the broken connection to readers.
+        ELLE_TRACE("%s: write credit failed: %s",
+                   this, elle::exception_string());
+      }
+    }
+
+    /*-------------.
+    | Flow control |
+    `-------------*/
+
+    elle::Buffer::Size
+    ChanneledStream::_exchange_windows()
+    {
+      if (!this->_flow_control)
+        return 0;
+      ELLE_TRACE_SCOPE("%s: exchange windows", *this);
+      {
+        auto p = elle::Buffer{};
+        this->uint32_put(p, this->_window, this->version());
+        this->_backend.write(p);
+      }
+      auto p = this->_backend.read();
+      auto const res = this->uint32_get(p, this->version());
+      ELLE_DEBUG("%s: peer window: %s", *this, res);
+      if (!res)
+        elle::err("invalid peer window: %s", res);
+      return res;
+    }
+
+    reactor::Duration
+    ChanneledStream::_write_acquire(int priority)
+    {
+      if (!this->_writing && this->_writers.empty())
+      {
+        this->_writing = true;
+        return {};
+      }
+      auto const start = Clock::now();
+      reactor::Barrier turn;
+      auto const it = this->_writers.emplace(priority, &turn);
+      try
+      {
+        reactor::wait(turn);
+      }
+      catch (...)
+      {
+        // Once opened, the turn was handed to us: pass it on.
+        if (turn.opened())
+          this->_write_release();
+        else
+          this->_writers.erase(it);
+        throw;
+      }
+      return duration(start);
+    }
+
+    void
+    ChanneledStream::_write_release()
+    {
+      if (this->_writers.empty())
+        this->_writing = false;
+      else
+      {
+        auto const next = this->_writers.begin();
+        next->second->open();
+        this->_writers.erase(next);
+      }
     }
 
     /*--------.
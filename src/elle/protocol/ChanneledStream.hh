@@ -1,6 +1,11 @@
 #pragma once
 
+#include <functional>
+#include <map>
 #include <unordered_map>
+#include <vector>
+
+#include <elle/reactor/Barrier.hh>
 
 #include <elle/protocol/Channel.hh>
 #include <elle/protocol/Stream.hh>
@@ -37,6 +42,13 @@ namespace elle
     /// auto channel2 = channel_stream.accept();
     ///
     /// @endcode
+    ///
+    /// From version 0.5.0, channels are flow controlled. Packets are split
+    /// into frames, written by channel priority and interleaved with the
+    /// frames of channels of the same priority, so a large transfer does not
+    /// hold small packets back. A channel may only start sending a packet
+    /// while the peer has not yet received a window worth of unread bytes
+    /// from it, so a slow reader does not buffer without bounds.
     class ChanneledStream
       : public Stream
     {
@@ -52,15 +64,35 @@ namespace elle
     | Construction |
     `-------------*/
     public:
-      ChanneledStream(elle::reactor::Scheduler& scheduler, Stream& backend);
-      ChanneledStream(Stream& backend);
+      /// Construct a ChanneledStream.
+      ///
+      /// @param scheduler The scheduler to run the reading thread in.
+      /// @param backend The Stream to multiplex.
+      /// @param window The number of unread bytes the peer may send on each
+      ///               channel, from version 0.5.0.
+      /// @param frame_size The maximum size of frames packets are split
+      ///                   into, from version 0.5.0.
+      /// @throw elle::Error if @a window or @a frame_size is invalid, before
+      ///                    anything is sent to the peer.
+      ChanneledStream(elle::reactor::Scheduler& scheduler,
+                      Stream& backend,
+                      elle::Buffer::Size window = 1 << 20,
+                      elle::Buffer::Size frame_size = 1 << 14);
+      ChanneledStream(Stream& backend,
+                      elle::Buffer::Size window = 1 << 20,
+                      elle::Buffer::Size frame_size = 1 << 14);
       virtual
       ~ChanneledStream();
     private:
       void
       _read_thread();
+      /// Hand a complete packet received on channel @a id to its channel.
+      void
+      _dispatch(int id, elle::Buffer packet);
       ELLE_ATTRIBUTE(Stream&, backend);
       ELLE_ATTRIBUTE(reactor::Thread::unique_ptr, thread);
+      /// Sends credits, with flow control.
+      ELLE_ATTRIBUTE(reactor::Thread::unique_ptr, credit_writer);
       ELLE_ATTRIBUTE(std::exception_ptr, exception);
 
     /*--------.
@@ -104,7 +136,66 @@ namespace elle
       _write(elle::Buffer const& packet) override;
     private:
       void
-      _write(elle::Buffer const& packet, int id);
+      _write(elle::Buffer const& packet, Channel& channel);
+      /// Write a frame of a packet or a control frame.
+      ///
+      /// @returns The time spent waiting for other frames to be written.
+      reactor::Duration
+      _write_frame(int id,
+                   elle::Buffer::Byte frame,
+                   elle::ConstWeakBuffer payload,
+                   int priority);
+      /// Let the peer send @a size more bytes on channel @a id.
+      ///
+      /// The credit is queued for the credit writer, so readers never block
+      /// or fail on the backend.
+      void
+      _write_credit(int id, std::size_t size);
+      /// Send queued credits until the connection fails.
+      void
+      _write_credits();
+      /// Credits waiting to be sent, by channel.
+      using Credits = std::unordered_map<int, std::size_t>;
+      ELLE_ATTRIBUTE(Credits, credits);
+      /// Open while credits wait to be sent.
+      ELLE_ATTRIBUTE(reactor::Barrier, credits_pending);
+
+    /*-------------.
+    | Flow control |
+    `-------------*/
+    public:
+      /// Whether channels are flow controlled, from version 0.5.0.
+      ELLE_ATTRIBUTE_R(bool, flow_control);
+      /// The number of unread bytes the peer may send on each channel.
+      ELLE_ATTRIBUTE_R(elle::Buffer::Size, window);
+      /// The number of unread bytes we may send on each channel.
+      ELLE_ATTRIBUTE_R(elle::Buffer::Size, peer_window);
+      ELLE_ATTRIBUTE_R(elle::Buffer::Size, frame_size);
+    private:
+      /// Exchange windows with the peer.
+      ///
+      /// @returns The peer window, zero without flow control.
+      elle::Buffer::Size
+      _exchange_windows();
+      /// Wait until no frame with a higher or equal priority waits to be
+      /// written, and take the turn to write.
+      ///
+      /// @returns The time spent waiting.
+      reactor::Duration
+      _write_acquire(int priority);
+      /// Give the turn to write to the next frame.
+      void
+      _write_release();
+      /// Whether a frame is being written.
+      ELLE_ATTRIBUTE(bool, writing);
+      /// Frames waiting to be written, by decreasing priority and in order of
+      /// arrival.
+      using Writers = std::multimap<int, reactor::Barrier*, std::greater<int>>;
+      ELLE_ATTRIBUTE(Writers, writers);
+      /// Frames received of incomplete packets, by channel, joined once the
+      /// last one arrives.
+      using Partial = std::unordered_map<int, std::vector<elle::Buffer>>;
+      ELLE_ATTRIBUTE(Partial, partial);
 
     /*----------.
     | Printable |
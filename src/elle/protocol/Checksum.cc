@@ -0,0 +1,314 @@
+#include <cstring>
+#include <iostream>
+
+#if defined __x86_64__ && defined __GNUC__
+# include <nmmintrin.h>
+# define ELLE_PROTOCOL_CRC32C_SSE42
+#endif
+
+#include <elle/err.hh>
+#include <elle/unreachable.hh>
+
+#include <elle/cryptography/hash.hh>
+
+#include <elle/protocol/Checksum.hh>
+#include <elle/protocol/exceptions.hh>
+
+namespace elle
+{
+  namespace protocol
+  {
+    using Byte = elle::Buffer::Byte;
+
+    /*-------.
+    | CRC32C |
+    `-------*/
+
+    namespace
+    {
+      uint32_t
+      load32(Byte const* p)
+      {
+        return uint32_t(p[0]) | uint32_t(p[1]) << 8 |
+          uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+      }
+
+      uint64_t
+      load64(Byte const* p)
+      {
+        return uint64_t(load32(p)) | uint64_t(load32(p + 4)) << 32;
+      }
+
+      // Tables for the slicing-by-8 software CRC32C (Castagnoli polynomial,
+      // reflected).
+      struct Crc32cTables
+      {
+        Crc32cTables()
+        {
+          for (int i = 0; i < 256; ++i)
+          {
+            auto crc = uint32_t(i);
+            for (int bit = 0; bit < 8; ++bit)
+              crc = (crc >> 1) ^ (crc & 1 ? 0x82f63b78 : 0);
+            this->table[0][i] = crc;
+          }
+          for (int i = 0; i < 256; ++i)
+            for (int t = 1; t < 8; ++t)
+            {
+              auto const previous = this->table[t - 1][i];
+              this->table[t][i] =
+                (previous >> 8) ^ this->table[0][previous & 0xff];
+            }
+        }
+
+        uint32_t table[8][256];
+      };
+
+      uint32_t
+      crc32c_software(uint32_t crc, Byte const* p, std::size_t size)
+      {
+        static auto const tables = Crc32cTables();
+        auto const& t = tables.table;
+        for (; size >= 8; p += 8, size -= 8)
+        {
+          auto const low = crc ^ load32(p);
+          auto const high = load32(p + 4);
+          crc =
+            t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^
+            t[5][(low >> 16) & 0xff] ^ t[4][low >> 24] ^
+            t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff] ^
+            t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+        }
+        for (; size; ++p, --size)
+          crc = t[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+        return crc;
+      }
+
+#ifdef ELLE_PROTOCOL_CRC32C_SSE42
+      __attribute__((target("sse4.2")))
+      uint32_t
+      crc32c_sse42(uint32_t crc, Byte const* p, std::size_t size)
+      {
+        uint64_t res = crc;
+        for (; size >= 8; p += 8, size -= 8)
+        {
+          uint64_t word;
+          std::memcpy(&word, p, 8);
+          res = _mm_crc32_u64(res, word);
+        }
+        for (; size; ++p, --size)
+          res = _mm_crc32_u8(uint32_t(res), *p);
+        return uint32_t(res);
+      }
+#endif
+
+      uint32_t
+      crc32c(uint32_t crc, Byte const* p, std::size_t size)
+      {
+#ifdef ELLE_PROTOCOL_CRC32C_SSE42
+        static bool const sse42 = __builtin_cpu_supports("sse4.2");
+        if (sse42)
+          return crc32c_sse42(crc, p, size);
+#endif
+        return crc32c_software(crc, p, size);
+      }
+    }
+
+    /*---------.
+    | xxHash64 |
+    `---------*/
+
+    namespace
+    {
+      uint64_t constexpr prime1 = 11400714785074694791ULL;
+      uint64_t constexpr prime2 = 14029467366897019727ULL;
+      uint64_t constexpr prime3 = 1609587929392839161ULL;
+      uint64_t constexpr prime4 = 9650029242287828579ULL;
+      uint64_t constexpr prime5 = 2870177450012600261ULL;
+
+      uint64_t
+      rotl(uint64_t v, int bits)
+      {
+        return (v << bits) | (v >> (64 - bits));
+      }
+
+      uint64_t
+      xxhash64_round(uint64_t accumulator, uint64_t input)
+      {
+        return rotl(accumulator + input * prime2, 31) * prime1;
+      }
+
+      uint64_t
+      xxhash64_merge(uint64_t hash, uint64_t accumulator)
+      {
+        return (hash ^ xxhash64_round(0, accumulator)) * prime1 + prime4;
+      }
+    }
+
+    void
+    Checksum::_xxhash64_round(Byte const* stripe)
+    {
+      for (int i = 0; i < 4; ++i)
+        this->_accumulators[i] =
+          xxhash64_round(this->_accumulators[i], load64(stripe + 8 * i));
+    }
+
+    /*------------.
+    | Negotiation |
+    `------------*/
+
+    constexpr Checksum::Algorithms Checksum::all;
+
+    boost::optional<Checksum::Algorithm>
+    Checksum::negotiate(Algorithms local, Algorithms peer)
+    {
+      if (!local || !peer)
+        return boost::none;
+      for (auto algorithm: {Algorithm::crc32c,
+                            Algorithm::xxhash64,
+                            Algorithm::sha1})
+        if (local & peer & static_cast<Algorithms>(algorithm))
+          return algorithm;
+      elle::err<Error>("no common checksum algorithm: 0x%x and 0x%x",
+                       int(local), int(peer));
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    Checksum::Checksum(Algorithm algorithm)
+      : _algorithm(algorithm)
+      , _crc(0xffffffff)
+      , _accumulators{{prime1 + prime2, prime2, 0, -prime1}}
+      , _stripe()
+      , _total_size(0)
+      , _blocks()
+    {}
+
+    /*------------.
+    | Computation |
+    `------------*/
+
+    void
+    Checksum::update(elle::ConstWeakBuffer data)
+    {
+      auto p = data.contents();
+      auto size = data.size();
+      if (!size)
+        return;
+      switch (this->_algorithm)
+      {
+        case Algorithm::sha1:
+          this->_blocks.emplace_back(data);
+          break;
+        case Algorithm::crc32c:
+          this->_crc = crc32c(this->_crc, p, size);
+          break;
+        case Algorithm::xxhash64:
+        {
+          auto const buffered = this->_total_size % 32;
+          this->_total_size += size;
+          if (buffered + size < 32)
+          {
+            std::memcpy(this->_stripe.data() + buffered, p, size);
+            break;
+          }
+          if (buffered)
+          {
+            auto const n = 32 - buffered;
+            std::memcpy(this->_stripe.data() + buffered, p, n);
+            this->_xxhash64_round(this->_stripe.data());
+            p += n;
+            size -= n;
+          }
+          for (; size >= 32; p += 32, size -= 32)
+            this->_xxhash64_round(p);
+          std::memcpy(this->_stripe.data(), p, size);
+          break;
+        }
+      }
+    }
+
+    elle::Buffer
+    Checksum::finish()
+    {
+      switch (this->_algorithm)
+      {
+        case Algorithm::sha1:
+        {
+          auto it = this->_blocks.begin();
+          return elle::cryptography::hash(
+            [&]
+            {
+              return it == this->_blocks.end() ?
+                elle::ConstWeakBuffer() : *it++;
+            },
+            elle::cryptography::Oneway::sha1);
+        }
+        case Algorithm::crc32c:
+        {
+          auto const crc = ~this->_crc;
+          auto res = elle::Buffer(4);
+          for (int i = 0; i < 4; ++i)
+            res[i] = Byte(crc >> (24 - 8 * i));
+          return res;
+        }
+        case Algorithm::xxhash64:
+        {
+          auto const& a = this->_accumulators;
+          auto hash = uint64_t{};
+          if (this->_total_size >= 32)
+          {
+            hash = rotl(a[0], 1) + rotl(a[1], 7) + rotl(a[2], 12) +
+              rotl(a[3], 18);
+            for (auto accumulator: a)
+              hash = xxhash64_merge(hash, accumulator);
+          }
+          else
+            hash = prime5;
+          hash += this->_total_size;
+          auto p = this->_stripe.data();
+          auto size = this->_total_size % 32;
+          for (; size >= 8; p += 8, size -= 8)
+            hash = rotl(hash ^ xxhash64_round(0, load64(p)), 27) * prime1 +
+              prime4;
+          if (size >= 4)
+          {
+            hash = rotl(hash ^ load32(p) * prime1, 23) * prime2 + prime3;
+            p += 4;
+            size -= 4;
+          }
+          for (; size; ++p, --size)
+            hash = rotl(hash ^ *p * prime5, 11) * prime1;
+          hash ^= hash >> 33;
+          hash *= prime2;
+          hash ^= hash >> 29;
+          hash *= prime3;
+          hash ^= hash >> 32;
+          auto res = elle::Buffer(8);
+          for (int i = 0; i < 8; ++i)
+            res[i] = Byte(hash >> (56 - 8 * i));
+          return res;
+        }
+      }
+      elle::unreachable();
+    }
+
+    std::ostream&
+    operator <<(std::ostream& output, Checksum::Algorithm algorithm)
+    {
+      switch (algorithm)
+      {
+        case Checksum::Algorithm::sha1:
+          return output << "SHA-1";
+        case Checksum::Algorithm::crc32c:
+          return output << "CRC32C";
+        case Checksum::Algorithm::xxhash64:
+          return output << "xxHash64";
+      }
+      return output << "unknown checksum algorithm "
+                    << static_cast<int>(algorithm);
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include <elle/Buffer.hh>
+#include <elle/attribute.hh>
+#include <elle/compiler.hh>
+#include <elle/optional.hh>
+
+namespace elle
+{
+  namespace protocol
+  {
+    /// The incremental computation of a packet checksum, to detect corruption.
+    ///
+    /// CRC32C and xxHash64 are updated as data is fed, so a packet can be
+    /// checked chunk by chunk while it is received. SHA-1 is kept for
+    /// compatibility with peers predating checksum negotiation. It is only
+    /// computed when finishing, over the blocks fed, which must still be alive
+    /// by then.
+    ///
+    /// \code{.cc}
+    ///
+    /// auto checksum = elle::protocol::Checksum(
+    ///   elle::protocol::Checksum::Algorithm::crc32c);
+    /// checksum.update(header);
+    /// checksum.update(payload);
+    /// auto digest = checksum.finish();
+    ///
+    /// \endcode
+    class ELLE_API Checksum
+    {
+    /*------.
+    | Types |
+    `------*/
+    public:
+      /// A checksum algorithm, also a bit in negotiated sets.
+      enum class Algorithm: uint8_t
+      {
+        sha1 = 1 << 0,
+        crc32c = 1 << 1,
+        xxhash64 = 1 << 2,
+      };
+      /// A set of algorithms, as a bitmask.
+      using Algorithms = uint8_t;
+      /// All algorithms.
+      static Algorithms constexpr all = 0x07;
+
+    /*------------.
+    | Negotiation |
+    `------------*/
+    public:
+      /// The algorithm accepted by both ends to use: CRC32C, xxHash64 or SHA-1
+      /// in order of preference.
+      ///
+      /// @param local The algorithms accepted locally, none to disable
+      ///              checksums.
+      /// @param peer The algorithms accepted by the peer, none to disable
+      ///             checksums.
+      /// @returns The algorithm to use, or none if either end disables
+      ///          checksums.
+      /// @throw Error if no algorithm is accepted by both ends.
+      static
+      boost::optional<Algorithm>
+      negotiate(Algorithms local, Algorithms peer);
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Start computing a checksum.
+      ///
+      /// @param algorithm The algorithm to use.
+      Checksum(Algorithm algorithm);
+
+    /*------------.
+    | Computation |
+    `------------*/
+    public:
+      /// Feed data.
+      ///
+      /// @param data The next bytes to checksum.
+      void
+      update(elle::ConstWeakBuffer data);
+      /// The checksum of all the data fed, in network byte order.
+      elle::Buffer
+      finish();
+      ELLE_ATTRIBUTE_R(Algorithm, algorithm);
+    private:
+      void
+      _xxhash64_round(elle::Buffer::Byte const* stripe);
+      ELLE_ATTRIBUTE(uint32_t, crc);
+      ELLE_ATTRIBUTE((std::array<uint64_t, 4>), accumulators);
+      /// Bytes fed and not part of a full 32 bytes stripe yet.
+      ELLE_ATTRIBUTE((std::array<elle::Buffer::Byte, 32>), stripe);
+      ELLE_ATTRIBUTE(uint64_t, total_size);
+      ELLE_ATTRIBUTE(std::vector<elle::ConstWeakBuffer>, blocks);
+    };
+
+    std::ostream&
+    operator <<(std::ostream& output, Checksum::Algorithm algorithm);
+  }
+}
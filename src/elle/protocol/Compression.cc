@@ -0,0 +1,291 @@
+#include <chrono>
+#include <iostream>
+
+#include <zlib.h>
+
+#include <elle/err.hh>
+#include <elle/log.hh>
+#include <elle/serialization/binary/SerializerIn.hh>
+#include <elle/serialization/binary/SerializerOut.hh>
+
+#include <elle/protocol/Compression.hh>
+#include <elle/protocol/exceptions.hh>
+
+ELLE_LOG_COMPONENT("elle.protocol.Compression");
+
+namespace elle
+{
+  namespace protocol
+  {
+    using Byte = elle::Buffer::Byte;
+    using BinaryIn = serialization::binary::SerializerIn;
+    using BinaryOut = serialization::binary::SerializerOut;
+
+    namespace
+    {
+      using Clock = std::chrono::steady_clock;
+
+      reactor::Duration
+      duration(Clock::time_point start)
+      {
+        return boost::posix_time::microseconds(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - start).count());
+      }
+
+      /// How a packet is encoded, in its first byte.
+      enum Flag: Byte
+      {
+        /// As is.
+        raw = 0,
+        /// Compressed on its own.
+        packet = 1,
+        /// The continuation of the compressed stream.
+        stream = 2,
+        /// The start of a new compressed stream.
+        stream_reset = 3,
+        max = stream_reset,
+      };
+
+      /// The maximum ratio deflate can reach, a 258 bytes match per 2 bits.
+      auto constexpr max_ratio = elle::Buffer::Size{1032};
+    }
+
+    /*---------------.
+    | Implementation |
+    `---------------*/
+
+    class Compression::Impl
+    {
+    public:
+      Impl(int level)
+        : deflate()
+        , inflate()
+        , reset(false)
+      {
+        // Raw deflate: packets are framed and checked by the Serializer
+        // already.
+        auto status = deflateInit2(&this->deflate, level, Z_DEFLATED,
+                                   -15, 8, Z_DEFAULT_STRATEGY);
+        if (status == Z_MEM_ERROR)
+          throw std::bad_alloc();
+        else if (status != Z_OK)
+          elle::err<Error>("unable to initialize compression: %s", status);
+        status = inflateInit2(&this->inflate, -15);
+        if (status != Z_OK)
+        {
+          deflateEnd(&this->deflate);
+          if (status == Z_MEM_ERROR)
+            throw std::bad_alloc();
+          elle::err<Error>("unable to initialize decompression: %s", status);
+        }
+      }
+
+      ~Impl()
+      {
+        deflateEnd(&this->deflate);
+        inflateEnd(&this->inflate);
+      }
+
+      /// Compress @a data at the end of @a output.
+      void
+      compress(elle::Buffer& output, elle::ConstWeakBuffer data, int flush)
+      {
+        auto& z = this->deflate;
+        z.next_in = const_cast<Byte*>(data.contents());
+        z.avail_in = data.size();
+        while (true)
+        {
+          if (output.size() == output.capacity())
+            output.capacity(output.capacity() * 2);
+          auto const available = output.capacity() - output.size();
+          z.next_out = output.mutable_contents() + output.size();
+          z.avail_out = available;
+          auto const status = ::deflate(&z, flush);
+          if (status == Z_STREAM_ERROR)
+            elle::err<Error>("compression failed");
+          output.size(output.size() + available - z.avail_out);
+          if (flush == Z_FINISH ? status == Z_STREAM_END :
+              !z.avail_in && (flush == Z_NO_FLUSH || z.avail_out))
+            break;
+        }
+      }
+
+      z_stream deflate;
+      z_stream inflate;
+      /// Whether the next packet restarts the stream.
+      bool reset;
+    };
+
+    /*------------.
+    | Negotiation |
+    `------------*/
+
+    constexpr Compression::Algorithms Compression::all;
+
+    boost::optional<Compression::Algorithm>
+    Compression::negotiate(Algorithms local, Algorithms peer)
+    {
+      if (local & peer & static_cast<Algorithms>(Algorithm::deflate))
+        return Algorithm::deflate;
+      return boost::none;
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    Compression::Compression(Algorithm algorithm,
+                             Mode mode,
+                             elle::Buffer::Size threshold,
+                             int level)
+      : _algorithm(algorithm)
+      , _mode(mode)
+      , _threshold(threshold)
+      , _statistics()
+      , _impl(std::make_unique<Impl>(level))
+    {}
+
+    Compression::Compression(Compression&&) = default;
+
+    Compression::~Compression()
+    {}
+
+    double
+    Compression::Statistics::ratio() const
+    {
+      return this->bytes_out ? double(this->bytes_in) / this->bytes_out : 1;
+    }
+
+    /*------------.
+    | Compression |
+    `------------*/
+
+    boost::optional<elle::Buffer>
+    Compression::compress(elle::ConstWeakBuffer header,
+                          elle::ConstWeakBuffer packet)
+    {
+      auto const size = header.size() + packet.size();
+      if (size < this->_threshold)
+      {
+        ++this->_statistics.uncompressed;
+        return boost::none;
+      }
+      auto const start = Clock::now();
+      auto& z = this->_impl->deflate;
+      auto flag = Flag::packet;
+      if (this->_mode == Mode::packet)
+        deflateReset(&z);
+      else if (this->_impl->reset)
+      {
+        ELLE_DEBUG("%s: restart stream", this);
+        deflateReset(&z);
+        this->_impl->reset = false;
+        flag = Flag::stream_reset;
+      }
+      else
+        flag = Flag::stream;
+      auto res = elle::Buffer{};
+      // Room for a sync flush marker on top of the bound.
+      res.capacity(
+        1 + BinaryOut::number_max_size + deflateBound(&z, size) + 8);
+      res.append(&flag, 1);
+      res.size(1 + BinaryOut::number_max_size);
+      res.size(1 + BinaryOut::serialize_number(res.mutable_contents() + 1,
+                                               size));
+      this->_impl->compress(res, header, Z_NO_FLUSH);
+      this->_impl->compress(
+        res, packet, this->_mode == Mode::packet ? Z_FINISH : Z_SYNC_FLUSH);
+      ++this->_statistics.compressed;
+      this->_statistics.bytes_in += size;
+      this->_statistics.bytes_out += res.size();
+      this->_statistics.compression_time += duration(start);
+      ELLE_DUMP("%s: compressed %s bytes into %s", this, size, res.size());
+      return res;
+    }
+
+    elle::Buffer
+    Compression::raw(elle::ConstWeakBuffer header) const
+    {
+      auto res = elle::Buffer{};
+      res.capacity(1 + header.size());
+      auto const flag = Flag::raw;
+      res.append(&flag, 1);
+      res.append(header.contents(), header.size());
+      return res;
+    }
+
+    void
+    Compression::interrupted()
+    {
+      if (this->_mode == Mode::stream)
+        this->_impl->reset = true;
+    }
+
+    elle::Buffer
+    Compression::decompress(elle::Buffer packet)
+    {
+      if (packet.empty())
+        elle::err<Error>("missing compression flag");
+      auto const flag = packet[0];
+      packet.pop_front(1);
+      if (flag == Flag::raw)
+        return packet;
+      else if (flag > Flag::max)
+        elle::err<Error>("invalid compression flag: 0x%x", int(flag));
+      auto const start = Clock::now();
+      auto size = int64_t{};
+      packet.pop_front(BinaryIn::serialize_number(packet, size));
+      // Do not let the peer make us allocate more than the packet can hold.
+      if (size < 0 ||
+          static_cast<elle::Buffer::Size>(size) > packet.size() * max_ratio)
+        elle::err<Error>("invalid decompressed size: %s", size);
+      auto& z = this->_impl->inflate;
+      if (flag != Flag::stream)
+        inflateReset(&z);
+      auto res = elle::Buffer(static_cast<elle::Buffer::Size>(size));
+      z.next_in = packet.mutable_contents();
+      z.avail_in = packet.size();
+      z.next_out = res.mutable_contents();
+      z.avail_out = res.size();
+      auto status = Z_OK;
+      do
+        status = ::inflate(
+          &z, flag == Flag::packet ? Z_FINISH : Z_SYNC_FLUSH);
+      while (status == Z_OK && z.avail_in);
+      auto const complete = flag == Flag::packet ?
+        status == Z_STREAM_END :
+        status == Z_OK || status == Z_BUF_ERROR;
+      if (!complete || z.avail_in || z.avail_out)
+        elle::err<Error>("corrupted compressed packet: %s", status);
+      ++this->_statistics.decompressed;
+      this->_statistics.decompression_time += duration(start);
+      return res;
+    }
+
+    std::ostream&
+    operator <<(std::ostream& output, Compression::Algorithm algorithm)
+    {
+      switch (algorithm)
+      {
+        case Compression::Algorithm::deflate:
+          return output << "deflate";
+      }
+      return output << "unknown compression algorithm "
+                    << static_cast<int>(algorithm);
+    }
+
+    std::ostream&
+    operator <<(std::ostream& output, Compression::Mode mode)
+    {
+      switch (mode)
+      {
+        case Compression::Mode::packet:
+          return output << "packet";
+        case Compression::Mode::stream:
+          return output << "stream";
+      }
+      return output << "unknown compression mode " << static_cast<int>(mode);
+    }
+  }
+}
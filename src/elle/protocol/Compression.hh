@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+
+#include <elle/Buffer.hh>
+#include <elle/attribute.hh>
+#include <elle/compiler.hh>
+#include <elle/optional.hh>
+
+#include <elle/reactor/duration.hh>
+
+namespace elle
+{
+  namespace protocol
+  {
+    /// The compression of packets, to save bandwidth on slow links.
+    ///
+    /// Packets smaller than a threshold are sent as is. Larger ones are
+    /// either compressed independently, or as parts of a single stream so
+    /// each packet benefits from the ones sent before it. In stream mode,
+    /// packets must be decompressed in the order they were compressed:
+    /// whenever a compressed packet may not have been delivered, call
+    /// interrupted() so the next packet restarts the stream.
+    ///
+    /// Every packet is preceded by a flag byte telling how it was encoded,
+    /// so both ends only need to agree on the algorithm.
+    ///
+    /// \code{.cc}
+    ///
+    /// auto compression = elle::protocol::Compression(
+    ///   elle::protocol::Compression::Algorithm::deflate,
+    ///   elle::protocol::Compression::Mode::stream);
+    /// if (auto compressed = compression.compress(header, packet))
+    ///   send(*compressed);
+    /// else
+    ///   send(compression.raw(header), packet);
+    ///
+    /// \endcode
+    class ELLE_API Compression
+    {
+    /*------.
+    | Types |
+    `------*/
+    public:
+      /// A compression algorithm, also a bit in negotiated sets.
+      enum class Algorithm: uint8_t
+      {
+        deflate = 1 << 0,
+      };
+      /// A set of algorithms, as a bitmask.
+      using Algorithms = uint8_t;
+      /// All algorithms.
+      static Algorithms constexpr all = 0x01;
+      /// How packets are compressed.
+      enum class Mode: uint8_t
+      {
+        /// Each packet on its own.
+        packet = 0,
+        /// All packets as a single stream.
+        stream = 1,
+      };
+      /// Compression settings of one end of a connection.
+      struct Settings
+      {
+        /// The algorithms accepted.
+        Algorithms algorithms = all;
+        /// The preferred mode, only used if both ends prefer it.
+        Mode mode = Mode::packet;
+        /// The size under which packets are sent as is.
+        elle::Buffer::Size threshold = 256;
+        /// The compression level, from 1 (fastest) to 9 (smallest), or -1
+        /// for the algorithm default.
+        int level = -1;
+      };
+      /// Compression activity.
+      struct Statistics
+      {
+        /// Packets compressed.
+        std::size_t compressed = 0;
+        /// Packets sent as is, because they are under the threshold.
+        std::size_t uncompressed = 0;
+        /// Bytes compressed.
+        std::size_t bytes_in = 0;
+        /// Bytes resulting from compression.
+        std::size_t bytes_out = 0;
+        /// Cumulated time spent compressing.
+        reactor::Duration compression_time;
+        /// Packets decompressed.
+        std::size_t decompressed = 0;
+        /// Cumulated time spent decompressing.
+        reactor::Duration decompression_time;
+        /// The ratio of bytes compressed over bytes resulting.
+        double
+        ratio() const;
+      };
+
+    /*------------.
+    | Negotiation |
+    `------------*/
+    public:
+      /// The algorithm accepted by both ends to use.
+      ///
+      /// @param local The algorithms accepted locally.
+      /// @param peer The algorithms accepted by the peer.
+      /// @returns The algorithm to use, or none to send packets as is.
+      static
+      boost::optional<Algorithm>
+      negotiate(Algorithms local, Algorithms peer);
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Start compressing and decompressing packets.
+      ///
+      /// @param algorithm The algorithm to use.
+      /// @param mode Whether to compress packets independently.
+      /// @param threshold The size under which packets are sent as is.
+      /// @param level The compression level, -1 for the algorithm default.
+      Compression(Algorithm algorithm,
+                  Mode mode = Mode::packet,
+                  elle::Buffer::Size threshold = 256,
+                  int level = -1);
+      Compression(Compression&&);
+      ~Compression();
+      ELLE_ATTRIBUTE_R(Algorithm, algorithm);
+      ELLE_ATTRIBUTE_R(Mode, mode);
+      ELLE_ATTRIBUTE_R(elle::Buffer::Size, threshold);
+
+    /*------------.
+    | Compression |
+    `------------*/
+    public:
+      /// Compress @a header followed by @a packet.
+      ///
+      /// @returns The encoded packet, or none if it is under the threshold,
+      ///          in which case raw() must be sent before the packet.
+      boost::optional<elle::Buffer>
+      compress(elle::ConstWeakBuffer header, elle::ConstWeakBuffer packet);
+      /// The header of a packet sent as is.
+      ///
+      /// @param header The header of the packet, if any.
+      elle::Buffer
+      raw(elle::ConstWeakBuffer header = {}) const;
+      /// Restart the stream with the next compressed packet, because the
+      /// last one may not have been delivered.
+      void
+      interrupted();
+      /// Decode a packet.
+      ///
+      /// @throw Error if the packet is corrupted, or declares a size it
+      ///              could not have been compressed from.
+      elle::Buffer
+      decompress(elle::Buffer packet);
+      ELLE_ATTRIBUTE_R(Statistics, statistics);
+    private:
+      class Impl;
+      ELLE_ATTRIBUTE(std::unique_ptr<Impl>, impl);
+    };
+
+    std::ostream&
+    operator <<(std::ostream& output, Compression::Algorithm algorithm);
+    std::ostream&
+    operator <<(std::ostream& output, Compression::Mode mode);
+  }
+}
@@ -9,6 +9,7 @@ namespace elle
     BaseRPC::BaseRPC(ChanneledStream& channels)
       : _channels(channels)
       , _id(0)
+      , _statistics()
     {}
   }
 }
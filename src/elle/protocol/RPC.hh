@@ -6,10 +6,13 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <elle/Buffer.hh>
 #include <elle/Printable.hh>
 
 #include <elle/reactor/Thread.hh>
+#include <elle/reactor/duration.hh>
 
+#include <elle/protocol/RPCCodec.hh>
 #include <elle/protocol/fwd.hh>
 
 namespace elle
@@ -26,10 +29,26 @@ namespace elle
 
     using ExceptionHandler = std::function<void(std::exception_ptr)>;
 
+    /// The status leading an RPC reply.
+    ///
+    /// Success and failure are encoded like the boolean older peers expect.
+    enum class RPCStatus: uint8_t
+    {
+      failure = 0,
+      success = 1,
+      /// The call was rejected by an overloaded server, from version 0.7.0.
+      /// Older peers decode a boolean and are sent a failure instead.
+      overloaded = 2,
+    };
+
     template <typename ISerializer, typename OSerializer>
     class BaseProcedure
       : public boost::noncopyable
     {
+    public:
+      using Reader = RPCReader<ISerializer>;
+      using Writer = RPCWriter<OSerializer>;
+
     public:
       BaseProcedure(std::string const& name);
       virtual
@@ -41,7 +60,7 @@ namespace elle
 
       virtual
       void
-      _call(ISerializer& in, OSerializer& out) = 0;
+      _call(Reader& in, Writer& out) = 0;
 
     private:
       ELLE_ATTRIBUTE(std::string, name);
@@ -55,6 +74,7 @@ namespace elle
       : public BaseProcedure<ISerializer, OSerializer>
     {
     public:
+      using Super = BaseProcedure<ISerializer, OSerializer>;
       using Owner = RPC<ISerializer, OSerializer>;
       using Function = std::function<R (Args...)>;
 
@@ -64,7 +84,7 @@ namespace elle
 
     protected:
       void
-      _call(ISerializer& in, OSerializer& out) override;
+      _call(typename Super::Reader& in, typename Super::Writer& out) override;
 
     private:
       template <typename I, typename O>
@@ -81,8 +101,73 @@ namespace elle
       ELLE_ATTRIBUTE(Function, function);
     };
 
+    /// The pending result of an asynchronous remote procedure call.
+    ///
+    /// The request is sent on a Channel of its own when the call starts, so
+    /// any number of calls can be in flight on the same ChanneledStream, their
+    /// responses being matched by channel id whatever their order. Cancelling
+    /// or destroying a pending call discards its response.
+    ///
+    /// \code{.cc}
+    ///
+    /// auto calls = std::vector<elle::protocol::PendingCall<IS, int>>{};
+    /// for (int i = 0; i < 16; ++i)
+    ///   calls.emplace_back(rpc.square.call(i));
+    /// for (auto& call: calls)
+    ///   std::cout << call.get(1_sec);
+    ///
+    /// \endcode
+    template <typename ISerializer, typename R>
+    class PendingCall
+    {
+    public:
+      PendingCall(std::string name, std::unique_ptr<Channel> channel);
+      PendingCall(PendingCall&& source) = default;
+      PendingCall&
+      operator =(PendingCall&& source) = default;
+
+      /// Wait for the response and return the result.
+      ///
+      /// @param timeout The maximum duration to wait for, after which the call
+      ///                is cancelled.
+      /// @pre pending().
+      /// \throw RPCError if the remote procedure failed.
+      /// \throw reactor::Timeout if the timeout expired.
+      R
+      get(reactor::DurationOpt timeout = {});
+      /// Give up on the call, discarding its response.
+      void
+      cancel();
+      /// Whether the result was neither retrieved nor cancelled.
+      bool
+      pending() const;
+
+    private:
+      ELLE_ATTRIBUTE_R(std::string, name);
+      ELLE_ATTRIBUTE(std::unique_ptr<Channel>, channel);
+    };
+
     class BaseRPC
     {
+    public:
+      /// Serving activity of a local procedure.
+      struct Statistics
+      {
+        /// Calls waiting for a worker, in pool_run.
+        int queued = 0;
+        /// Calls being executed.
+        int running = 0;
+        /// Calls answered.
+        std::size_t calls = 0;
+        /// Calls rejected because the pending queue was full, in pool_run.
+        std::size_t rejected = 0;
+        /// Cumulated time calls spent waiting for a worker, in pool_run.
+        reactor::Duration wait_time;
+        /// Cumulated time calls spent executing.
+        reactor::Duration run_time;
+      };
+      using ProcedureStatistics = std::unordered_map<std::string, Statistics>;
+
     public:
       BaseRPC(ChanneledStream& channels);
       /// Run forever until one of the following:
@@ -107,6 +192,8 @@ namespace elle
 
       ELLE_ATTRIBUTE(ChanneledStream&, channels, protected);
       ELLE_ATTRIBUTE(uint32_t, id, protected);
+      /// Serving activity by procedure name.
+      ELLE_ATTRIBUTE_R(ProcedureStatistics, statistics, protected);
     };
 
     template <typename ISerializer, typename OSerializer>
@@ -126,7 +213,12 @@ namespace elle
       public:
         RemoteProcedure(std::string const& name,
                         RPC<ISerializer, OSerializer>& owner);
+        /// Call the remote procedure and wait for the result.
         R operator() (Args ...);
+        /// Send a call to the remote procedure, without waiting for the
+        /// result.
+        PendingCall<ISerializer, R>
+        call(Args ...);
         void operator = (std::function<R (Args...)> const& implem);
         template <typename I, typename O>
         friend class RPC;
@@ -160,6 +252,21 @@ namespace elle
       void
       parallel_run();
 
+      /// Serve calls with a fixed pool of worker Threads.
+      ///
+      /// Unlike parallel_run, the number of Threads and of pending calls is
+      /// bounded: calls wait in a queue until a worker is available, and are
+      /// rejected with RPCOverloaded on the caller side when @a queue_size
+      /// calls are already waiting. Exits like run.
+      ///
+      /// @param workers The number of worker Threads.
+      /// @param queue_size The number of waiting calls beyond which calls are
+      ///                   rejected.
+      /// @param handler See run.
+      virtual
+      void
+      pool_run(int workers, int queue_size, ExceptionHandler handler = {});
+
     protected:
       using LocalProcedure = BaseProcedure<ISerializer, OSerializer>;
       using NamedProcedure = std::pair<std::string,
@@ -169,6 +276,19 @@ namespace elle
       ELLE_ATTRIBUTE(Procedures, procedures, protected);
       ELLE_ATTRIBUTE(std::vector<BaseRPC*>, rpcs, protected);
 
+    private:
+      /// The name of the procedure called by @a question.
+      std::string
+      _procedure_name(elle::Buffer const& question);
+      /// Call the procedure requested by @a question and answer on @a
+      /// channel.
+      ///
+      /// @returns Whether the handler requested to stop serving.
+      bool
+      _serve(Channel& channel,
+             elle::Buffer const& question,
+             ExceptionHandler& handler);
+
     /*----------.
     | Printable |
     `----------*/
@@ -1,12 +1,20 @@
+#include <chrono>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include <elle/Backtrace.hh>
+#include <elle/assert.hh>
+#include <elle/err.hh>
+#include <elle/finally.hh>
 #include <elle/log.hh>
 #include <elle/printf.hh>
 #include <elle/memory.hh>
 
+#include <elle/reactor/Channel.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/Scope.hh>
+#include <elle/reactor/TimeoutGuard.hh>
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/Thread.hh>
 
@@ -70,7 +78,7 @@ namespace elle
     template <typename OS>
     static
     void
-    put_args(OS&)
+    put_args(RPCWriter<OS>&)
     {}
 
     template <typename OS,
@@ -78,7 +86,7 @@ namespace elle
               typename ...Args>
     static
     void
-    put_args(OS& output, T a, Args ... args)
+    put_args(RPCWriter<OS>& output, T const& a, Args const& ... args)
     {
       output << a;
       put_args<OS, Args...>(output, args...);
@@ -88,11 +96,9 @@ namespace elle
               typename R>
     struct GetRes
     {
-      static inline R get_res(IS& input)
+      static inline R get_res(RPCReader<IS>& input)
       {
-        R res;
-        input >> res;
-        return res;
+        return input.template get<R>();
       }
     };
 
@@ -101,7 +107,7 @@ namespace elle
     {
       static
       void
-      get_res(IS& input)
+      get_res(RPCReader<IS>& input)
       {
         char c;
         input >> c;
@@ -146,9 +152,9 @@ namespace elle
       auto proc = this->_owner._procedures.find(this->_id);
       assert(proc != this->_owner._procedures.end());
       assert(proc->second.second == nullptr);
-      proc->second.second =
-        std::make_unique<Procedure<IS, OS, R, Args...>>(
-          this->_name, this->_owner, this->_id, f);
+      proc->second.second.reset(
+        new Procedure<IS, OS, R, Args...>(
+          this->_name, this->_owner, this->_id, f));
     }
 
 
@@ -159,104 +165,154 @@ namespace elle
     R
     RPC<IS, OS>::RemoteProcedure<R, Args...>::
     operator () (Args ... args)
+    {
+      return this->call(args...).get();
+    }
+
+    template <typename IS,
+              typename OS>
+    template <typename R,
+              typename ... Args>
+    PendingCall<IS, R>
+    RPC<IS, OS>::RemoteProcedure<R, Args...>::
+    call(Args ... args)
     {
       ELLE_LOG_COMPONENT("elle.protocol.RPC");
 
       ELLE_TRACE_SCOPE("%s: call remote procedure: %s",
                        this->_owner, this->_name);
 
-      Channel channel(this->_owner._channels);
+      auto channel = std::make_unique<Channel>(this->_owner._channels);
       {
-        elle::Buffer question;
+        RPCWriter<OS> output(RPCWriter<OS>::size_hint(this->_id, args...));
+        output << this->_id;
+        put_args<OS, Args...>(output, args...);
+        channel->write(output.finish());
+      }
+      return {this->_name, std::move(channel)};
+    }
+
+    /*------------.
+    | PendingCall |
+    `------------*/
+
+    template <typename IS,
+              typename R>
+    PendingCall<IS, R>::PendingCall(std::string name,
+                                    std::unique_ptr<Channel> channel)
+      : _name(std::move(name))
+      , _channel(std::move(channel))
+    {}
+
+    template <typename IS,
+              typename R>
+    R
+    PendingCall<IS, R>::get(reactor::DurationOpt timeout)
+    {
+      ELLE_LOG_COMPONENT("elle.protocol.RPC");
+
+      ELLE_ASSERT(this->pending());
+      // Whatever happens, the response is consumed or discarded.
+      auto channel = std::move(this->_channel);
+      auto response = [&]
         {
-          elle::IOStream outs(question.ostreambuf());
-          OS output(outs);
-          output << this->_id;
-          put_args<OS, Args...>(output, args...);
-        }
-        channel.write(question);
+          auto guard = std::unique_ptr<reactor::TimeoutGuard>{};
+          if (timeout)
+            guard = std::make_unique<reactor::TimeoutGuard>(*timeout);
+          return channel->read();
+        }();
+      RPCReader<IS> input(response);
+      auto const status = RPCStatus(input.template get<uint8_t>());
+      if (status == RPCStatus::success)
+        return GetRes<IS, R>::get_res(input);
+      else if (status == RPCStatus::overloaded)
+      {
+        ELLE_TRACE("remote procedure call to %s rejected", this->_name);
+        throw RPCOverloaded(this->_name);
       }
+      else if (status != RPCStatus::failure)
+        elle::err<RPCError>("invalid reply status from '%s': %s",
+                            this->_name, int(status));
+      else
       {
-        elle::Buffer response(channel.read());
-        elle::IOStream ins(response.istreambuf());
-        IS input(ins);
-        bool res;
-        input >> res;
-        if (res)
-          return GetRes<IS, R>::get_res(input);
-        else
+        std::string error;
+        input >> error;
+        ELLE_TRACE_SCOPE("remote procedure call to %s failed: %s",
+                         this->_name, error);
+        uint16_t bt_size;
+        input >> bt_size;
+        std::vector<elle::StackFrame> frames;
+        for (int i = 0; i < bt_size; ++i)
         {
-          std::string error;
-          input >> error;
-          ELLE_TRACE_SCOPE("%s: remote procedure call failed: %s",
-                           this->_owner, error);
-          uint16_t bt_size;
-          input >> bt_size;
-          std::vector<elle::StackFrame> frames;
-          for (int i = 0; i < bt_size; ++i)
-          {
-            elle::StackFrame frame;
-            input >> frame.symbol;
-            input >> frame.symbol_mangled;
-            input >> frame.symbol_demangled;
-            input >> frame.address;
-            input >> frame.offset;
-            frames.push_back(frame);
-          }
-          elle::Backtrace bt(frames);
-          // FIXME: only protocol error should throw this, not remote
-          // exceptions.
-          RPCError e
-            (elle::sprintf("remote procedure '%s' failed with '%s'", this->_name, error));
-          elle::Exception inner_exception(bt, error);
-          e.inner_exception(std::make_exception_ptr(inner_exception));
-          throw e;
+          elle::StackFrame frame;
+          input >> frame.symbol;
+          input >> frame.symbol_mangled;
+          input >> frame.symbol_demangled;
+          input >> frame.address;
+          input >> frame.offset;
+          frames.push_back(frame);
         }
+        elle::Backtrace bt(frames);
+        // FIXME: only protocol error should throw this, not remote
+        // exceptions.
+        RPCError e
+          (elle::sprintf("remote procedure '%s' failed with '%s'", this->_name, error));
+        elle::Exception inner_exception(bt, error);
+        e.inner_exception(std::make_exception_ptr(inner_exception));
+        throw e;
       }
     }
 
+    template <typename IS,
+              typename R>
+    void
+    PendingCall<IS, R>::cancel()
+    {
+      this->_channel.reset();
+    }
+
+    template <typename IS,
+              typename R>
+    bool
+    PendingCall<IS, R>::pending() const
+    {
+      return bool(this->_channel);
+    }
+
     /*------------------.
     | Procedure helpers |
     `------------------*/
 
+    /// Decode the arguments of a call and apply them.
+    ///
+    /// Arguments are decoded from left to right, each one directly into the
+    /// tuple passed to the function.
     template <typename Input,
               typename R,
               typename ... Types>
-    struct Call;
-
-    template <typename Input,
-              typename R>
-    struct Call<Input, R>
+    struct Call
     {
-      template <typename S, typename ... Given>
+      using Arguments = std::tuple<std::decay_t<Types>...>;
+
+      template <typename S>
       static
       R
-      call(Input&,
-           S const& f,
-           Given&... args)
+      call(Input& input,
+           S const& f)
       {
-        return f(args...);
+        // Braced initialization guarantees the evaluation order.
+        auto arguments =
+          Arguments{input.template get<std::decay_t<Types>>()...};
+        return apply(f, arguments, std::index_sequence_for<Types...>());
       }
-    };
 
-    template <typename Input,
-              typename R,
-              typename First,
-              typename ... Types>
-    struct Call<Input, R, First, Types...>
-    {
-      template <typename S,
-                typename ... Given>
+    private:
+      template <typename S, std::size_t ... I>
       static
       R
-      call(Input& input,
-           S const& f,
-           Given&&... args)
+      apply(S const& f, Arguments& arguments, std::index_sequence<I...>)
       {
-        auto a = std::remove_const_t<std::remove_reference_t<First>>{};
-        input >> a;
-        return Call<Input, R, Types...>::call(input, f,
-                                              std::forward<Given>(args)..., a);
+        return f(std::move(std::get<I>(arguments))...);
       }
     };
 
@@ -270,12 +326,12 @@ namespace elle
       {
         static
         void
-        call(IS& in,
-             OS& out,
+        call(RPCReader<IS>& in,
+             RPCWriter<OS>& out,
              std::function<R (Args...)> const& f)
         {
-          R res(Call<IS, R, Args...>::template call<>(in, f));
-          out << true;
+          R res(Call<RPCReader<IS>, R, Args...>::call(in, f));
+          out << uint8_t(RPCStatus::success);
           out << res;
         }
       };
@@ -287,12 +343,12 @@ namespace elle
       {
         static
         void
-        call(IS& in,
-             OS& out,
+        call(RPCReader<IS>& in,
+             RPCWriter<OS>& out,
              std::function<void (Args...)> const& f)
         {
-          Call<IS, void, Args...>::template call<>(in, f);
-          out << true;
+          Call<RPCReader<IS>, void, Args...>::call(in, f);
+          out << uint8_t(RPCStatus::success);
           unsigned char c(42);
           out << c;
         }
@@ -308,11 +364,10 @@ namespace elle
               typename R,
               typename ... Args>
     void
-    Procedure<IS, OS, R, Args...>::_call(IS& in, OS& out)
+    Procedure<IS, OS, R, Args...>::_call(typename Super::Reader& in,
+                                         typename Super::Writer& out)
     {
-      std::string err;
-      VoidSwitch<IS, OS, R, Args ...>::call(
-        in, out, this->_function);
+      VoidSwitch<IS, OS, R, Args ...>::call(in, out, this->_function);
     }
 
     /*----.
@@ -371,7 +426,7 @@ namespace elle
           res = true;
         ELLE_TRACE_SCOPE("RPC procedure failed: %s (stop_request = %s)",
           e.what(), res);
-        output << false;
+        output << uint8_t(RPCStatus::failure);
         output << std::string(e.what());
         output << uint16_t(e.backtrace().frames().size());
         for (auto const& frame: e.backtrace().frames())
@@ -386,29 +441,115 @@ namespace elle
       catch (std::exception& e)
       {
         ELLE_TRACE_SCOPE("RPC procedure failed: %s", e.what());
-        output << false;
+        output << uint8_t(RPCStatus::failure);
         output << std::string(e.what());
         output << uint16_t(0);
       }
       catch (...)
       {
         ELLE_TRACE_SCOPE("RPC procedure failed: unknown error");
-        output << false;
+        output << uint8_t(RPCStatus::failure);
         output << std::string("unknown error");
         output << uint16_t(0);
       }
       return res;
     }
 
+    namespace _details
+    {
+      using Clock = std::chrono::steady_clock;
+
+      inline
+      reactor::Duration
+      elapsed(Clock::time_point since)
+      {
+        return boost::posix_time::microseconds(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - since).count());
+      }
+    }
+
     template <typename IS,
               typename OS>
-    void
-    RPC<IS, OS>::run(ExceptionHandler handler)
+    std::string
+    RPC<IS, OS>::_procedure_name(elle::Buffer const& question)
+    {
+      RPCReader<IS> input(question);
+      uint32_t id;
+      input >> id;
+      auto proc = this->_procedures.find(id);
+      if (proc == this->_procedures.end())
+        return elle::sprintf("%s", id);
+      else
+        return proc->second.first;
+    }
+
+    template <typename IS,
+              typename OS>
+    bool
+    RPC<IS, OS>::_serve(Channel& channel,
+                        elle::Buffer const& question,
+                        ExceptionHandler& handler)
     {
       ELLE_LOG_COMPONENT("elle.protocol.RPC");
 
       using elle::sprintf;
       using elle::Exception;
+      bool stop_request = false;
+      RPCReader<IS> input(question);
+      uint32_t id;
+      input >> id;
+      ELLE_TRACE_SCOPE("%s: Processing request for %s...", *this, id);
+      auto proc = this->_procedures.find(id);
+
+      RPCWriter<OS> output;
+      try
+      {
+        if (proc == this->_procedures.end())
+          throw Exception(sprintf("call to unknown procedure: %s", id));
+        else if (proc->second.second == nullptr)
+        {
+          throw Exception(sprintf("remote call to non-local procedure: %s",
+                                  proc->second.first));
+        }
+        else
+        {
+          auto const &name = proc->second.first;
+          auto& statistics = this->_statistics[name];
+          auto const start = _details::Clock::now();
+          ++statistics.running;
+          elle::SafeFinally account(
+            [&]
+            {
+              --statistics.running;
+              ++statistics.calls;
+              statistics.run_time += _details::elapsed(start);
+            });
+          ELLE_TRACE("%s: remote procedure called: %s", *this, name)
+            proc->second.second->_call(input, output);
+          ELLE_TRACE("%s: procedure %s succeeded", *this, name);
+        }
+      }
+      catch (elle::reactor::Terminate const&)
+      {
+        ELLE_TRACE("%s: terminating as requested", *this);
+        throw;
+      }
+      catch (...)
+      { // Pass exception through handler if present, reply with an error
+        stop_request = handle_exception(handler, output, std::current_exception());
+      }
+      channel.write(output.finish());
+      return stop_request;
+    }
+
+    template <typename IS,
+              typename OS>
+    void
+    RPC<IS, OS>::run(ExceptionHandler handler)
+    {
+      ELLE_LOG_COMPONENT("elle.protocol.RPC");
+
       bool stop_request = false;
       try
       {
@@ -416,46 +557,8 @@ namespace elle
         {
           ELLE_TRACE_SCOPE("%s: Accepting new request...", *this);
           Channel c(this->_channels.accept());
-          elle::Buffer question(c.read());
-          elle::IOStream ins(question.istreambuf());
-          IS input(ins);
-          uint32_t id;
-          input >> id;
-          ELLE_TRACE_SCOPE("%s: Processing request for %s...", *this, id);
-          auto proc = this->_procedures.find(id);
-
-          elle::Buffer answer;
-          elle::IOStream outs(answer.ostreambuf());
-          OS output(outs);
-          try
-          {
-            if (proc == this->_procedures.end())
-              throw Exception(sprintf("call to unknown procedure: %s", id));
-            else if (proc->second.second == nullptr)
-            {
-              throw Exception(sprintf("remote call to non-local procedure: %s",
-                                      proc->second.first));
-            }
-            else
-            {
-              auto const &name = proc->second.first;
-
-              ELLE_TRACE("%s: remote procedure called: %s", *this, name)
-                proc->second.second->_call(input, output);
-              ELLE_TRACE("%s: procedure %s succeeded", *this, name);
-            }
-          }
-          catch (elle::reactor::Terminate const&)
-          {
-            ELLE_TRACE("%s: terminating as requested", *this);
-            throw;
-          }
-          catch (...)
-          { // Pass exception through handler if present, reply with an error
-            stop_request = handle_exception(handler, output, std::current_exception());
-          }
-          outs.flush();
-          c.write(answer);
+          auto const question = c.read();
+          stop_request = this->_serve(c, question, handler);
         }
       }
       catch (elle::reactor::network::ConnectionClosed const& e)
@@ -466,9 +569,6 @@ namespace elle
       ELLE_TRACE("%s: end of RPCs: normal exit", *this);
     }
 
-    // XXX: factor with run().
-    // XXX: unsafe, rpc calls must finish in the order they were started,
-    // there is no mechanism to match a rpc call with associated return
     template <typename IS,
               typename OS>
     void
@@ -476,8 +576,6 @@ namespace elle
     {
       ELLE_LOG_COMPONENT("elle.protocol.RPC");
 
-      using elle::sprintf;
-      using elle::Exception;
       try
       {
         elle::With<elle::reactor::Scope>("RPC // run") << [&] (elle::reactor::Scope& scope)
@@ -487,76 +585,14 @@ namespace elle
           {
             auto chan = std::make_shared<Channel>(this->_channels.accept());
             ++i;
-
-            auto call_procedure = [&, chan] {
-              ELLE_LOG_COMPONENT("elle.protocol.RPC");
-
-              elle::Buffer question(chan->read());
-              elle::IOStream ins(question.istreambuf());
-              IS input(ins);
-              uint32_t id;
-              input >> id;
-              auto proc = this->_procedures.find(id);
-
-              elle::Buffer answer;
-              elle::IOStream outs(answer.ostreambuf());
-              OS output(outs);
-              try
+            scope.run_background(
+              elle::sprintf("RPC %s", i),
+              [this, chan]
               {
-                if (proc == _procedures.end())
-                  throw Exception(sprintf("call to unknown procedure: %s", id));
-                else if (proc->second.second == nullptr)
-                {
-                  throw Exception(sprintf("remote call to non-local procedure: %s",
-                                          proc->second.first));
-                }
-                else
-                {
-                  auto const &name = proc->second.first;
-
-                  ELLE_TRACE("%s: remote procedure called: %s", *this, name)
-                    proc->second.second->_call(input, output);
-                  ELLE_TRACE("%s: procedure %s succeeded", *this, name);
-                }
-              }
-              catch (elle::Error const& e)
-              {
-                ELLE_TRACE("%s: procedure failed: %s", *this, e.what());
-                output << false;
-                output << std::string(e.what());
-                output << uint16_t(e.backtrace().frames().size());
-                for (auto const& frame: e.backtrace().frames())
-                {
-                  output << frame.symbol;
-                  output << frame.symbol_mangled;
-                  output << frame.symbol_demangled;
-                  output << frame.address;
-                  output << frame.offset;
-                }
-              }
-              catch (elle::reactor::Terminate const&)
-              {
-                ELLE_TRACE("%s: terminating as requested", *this);
-                throw;
-              }
-              catch (std::exception& e)
-              {
-                ELLE_TRACE("%s: procedure failed: %s", *this, e.what());
-                output << false;
-                output << std::string(e.what());
-                output << uint16_t(0);
-              }
-              catch (...)
-              {
-                ELLE_TRACE("%s: procedure failed: unknown error", *this);
-                output << false;
-                output << std::string("unknown error");
-                output << uint16_t(0);
-              }
-              outs.flush();
-              chan->write(answer);
-            };
-            scope.run_background(elle::sprintf("RPC %s", i), call_procedure);
+                auto handler = ExceptionHandler{};
+                auto const question = chan->read();
+                this->_serve(*chan, question, handler);
+              });
           }
         };
       }
@@ -582,6 +618,99 @@ namespace elle
       }
     }
 
+    template <typename IS,
+              typename OS>
+    void
+    RPC<IS, OS>::pool_run(int workers,
+                          int queue_size,
+                          ExceptionHandler handler)
+    {
+      ELLE_LOG_COMPONENT("elle.protocol.RPC");
+
+      ELLE_ASSERT_GT(workers, 0);
+      ELLE_TRACE_SCOPE("%s: serve with %s workers and %s waiting calls",
+                       *this, workers, queue_size);
+      struct Request
+      {
+        Channel channel;
+        elle::Buffer question;
+        std::string name;
+        _details::Clock::time_point queued;
+      };
+      auto requests = reactor::Channel<Request>{};
+      // Workers executing a call, so idle workers are not counted as full.
+      int busy = 0;
+      try
+      {
+        elle::With<elle::reactor::Scope>("RPC pool") <<
+          [&] (elle::reactor::Scope& scope)
+          {
+            for (int i = 0; i < workers; ++i)
+              scope.run_background(
+                elle::sprintf("RPC worker %s", i),
+                [&]
+                {
+                  while (true)
+                  {
+                    auto request = requests.get();
+                    auto& statistics = this->_statistics[request.name];
+                    --statistics.queued;
+                    statistics.wait_time += _details::elapsed(request.queued);
+                    ++busy;
+                    elle::SafeFinally idle([&] { --busy; });
+                    if (this->_serve(request.channel, request.question,
+                                     handler))
+                    {
+                      ELLE_TRACE("%s: end of RPCs: stop requested", *this);
+                      scope.terminate_now();
+                      return;
+                    }
+                  }
+                });
+            scope.run_background(
+              "RPC acceptor",
+              [&]
+              {
+                while (true)
+                {
+                  auto channel = this->_channels.accept();
+                  // The first packet created the channel: this does not
+                  // block.
+                  auto question = channel.read();
+                  auto name = this->_procedure_name(question);
+                  auto& statistics = this->_statistics[name];
+                  if (requests.size() + busy >= workers + queue_size)
+                  {
+                    ELLE_TRACE("%s: reject call to %s: %s waiting",
+                               *this, name, requests.size());
+                    ++statistics.rejected;
+                    RPCWriter<OS> output;
+                    if (channel.version() >= elle::Version(0, 7, 0))
+                      output << uint8_t(RPCStatus::overloaded);
+                    else
+                      output << uint8_t(RPCStatus::failure);
+                    output << RPCOverloaded::reason;
+                    output << uint16_t(0);
+                    channel.write(output.finish());
+                    continue;
+                  }
+                  ++statistics.queued;
+                  requests.put(Request{std::move(channel),
+                                       std::move(question),
+                                       std::move(name),
+                                       _details::Clock::now()});
+                }
+              });
+            reactor::wait(scope);
+          };
+      }
+      catch (elle::reactor::network::ConnectionClosed const& e)
+      {
+        ELLE_TRACE("%s: end of RPCs: connection closed", *this);
+        return;
+      }
+    }
+
     template <typename IS,
               typename OS>
     void
@@ -0,0 +1,208 @@
+#include <cstring>
+#include <istream>
+#include <streambuf>
+
+#include <elle/err.hh>
+
+#include <elle/protocol/RPCCodec.hh>
+
+namespace elle
+{
+  namespace protocol
+  {
+    using BinaryIn = serialization::binary::SerializerIn;
+    using BinaryOut = serialization::binary::SerializerOut;
+
+    namespace
+    {
+      /// The magic byte of the binary serialization.
+      char const magic = 0;
+
+      /// An input streambuf over the rest of a message, preceded by the
+      /// binary serialization magic, to deserialize a value in the middle of
+      /// a message.
+      class MagicStreamBuffer
+        : public std::streambuf
+      {
+      public:
+        MagicStreamBuffer(elle::ConstWeakBuffer data)
+          : _data(data)
+        {
+          auto const p = const_cast<char*>(&magic);
+          this->setg(p, p, p + 1);
+        }
+
+        /// The number of bytes of data read.
+        std::size_t
+        consumed() const
+        {
+          if (this->eback() == &magic)
+            return 0;
+          else
+            return this->gptr() - this->eback();
+        }
+
+      protected:
+        int_type
+        underflow() override
+        {
+          if (this->eback() != &magic || !this->_data.size())
+            return traits_type::eof();
+          auto const p = reinterpret_cast<char*>(
+            const_cast<elle::Buffer::Byte*>(this->_data.contents()));
+          this->setg(p, p, p + this->_data.size());
+          return traits_type::to_int_type(*p);
+        }
+
+      private:
+        elle::ConstWeakBuffer _data;
+      };
+    }
+
+    /*-----------------.
+    | Binary RPCWriter |
+    `-----------------*/
+
+    RPCWriter<BinaryOut>::RPCWriter(std::size_t size_hint)
+      : _message()
+    {
+      if (size_hint)
+        this->_message.capacity(size_hint);
+      this->_message.append(&magic, 1);
+    }
+
+    RPCWriter<BinaryOut>&
+    RPCWriter<BinaryOut>::operator <<(double value)
+    {
+      this->_message.append(&value, sizeof(value));
+      return *this;
+    }
+
+    RPCWriter<BinaryOut>&
+    RPCWriter<BinaryOut>::operator <<(std::string const& value)
+    {
+      return *this << elle::ConstWeakBuffer(value);
+    }
+
+    RPCWriter<BinaryOut>&
+    RPCWriter<BinaryOut>::operator <<(elle::ConstWeakBuffer value)
+    {
+      this->_number(value.size());
+      this->_message.append(value.contents(), value.size());
+      return *this;
+    }
+
+    RPCWriter<BinaryOut>&
+    RPCWriter<BinaryOut>::operator <<(elle::Buffer const& value)
+    {
+      return *this << elle::ConstWeakBuffer(value);
+    }
+
+    elle::Buffer
+    RPCWriter<BinaryOut>::finish()
+    {
+      return std::move(this->_message);
+    }
+
+    void
+    RPCWriter<BinaryOut>::_number(int64_t value)
+    {
+      auto const size = this->_message.size();
+      this->_message.size(size + BinaryOut::number_max_size);
+      auto const written = BinaryOut::serialize_number(
+        this->_message.mutable_contents() + size, value);
+      this->_message.size(size + written);
+    }
+
+    void
+    RPCWriter<BinaryOut>::_serialize(std::function<void (BinaryOut&)> const& f)
+    {
+      auto serialized = elle::Buffer{};
+      {
+        elle::IOStream output(serialized.ostreambuf());
+        BinaryOut serializer(output, false);
+        f(serializer);
+      }
+      // Skip the magic, already at the beginning of the message.
+      this->_message.append(serialized.contents() + 1, serialized.size() - 1);
+    }
+
+    /*-----------------.
+    | Binary RPCReader |
+    `-----------------*/
+
+    RPCReader<BinaryIn>::RPCReader(elle::ConstWeakBuffer message)
+      : _message(message)
+      , _offset(0)
+    {
+      auto const first = this->_bytes(1);
+      if (first[0] != magic)
+        elle::err<serialization::Error>(
+          "wrong magic for binary serialization: 0x%2x (expected 0)",
+          int(first[0]));
+    }
+
+    bool
+    RPCReader<BinaryIn>::_get(Type<bool>)
+    {
+      auto const value = this->_number();
+      if (value != 0 && value != 1)
+        elle::err<serialization::Error>("invalid boolean: %s", value);
+      return value;
+    }
+
+    double
+    RPCReader<BinaryIn>::_get(Type<double>)
+    {
+      double res;
+      std::memcpy(&res, this->_bytes(sizeof(res)).contents(), sizeof(res));
+      return res;
+    }
+
+    std::string
+    RPCReader<BinaryIn>::_get(Type<std::string>)
+    {
+      auto const bytes = this->_bytes(this->_get(Type<std::size_t>{}));
+      return std::string(reinterpret_cast<char const*>(bytes.contents()),
+                         bytes.size());
+    }
+
+    elle::Buffer
+    RPCReader<BinaryIn>::_get(Type<elle::Buffer>)
+    {
+      auto const bytes = this->_bytes(this->_get(Type<std::size_t>{}));
+      return elle::Buffer(bytes.contents(), bytes.size());
+    }
+
+    int64_t
+    RPCReader<BinaryIn>::_number()
+    {
+      auto res = int64_t{};
+      this->_offset += BinaryIn::serialize_number(
+        this->_message.range(this->_offset), res);
+      return res;
+    }
+
+    elle::ConstWeakBuffer
+    RPCReader<BinaryIn>::_bytes(std::size_t size)
+    {
+      if (this->_message.size() - this->_offset < size)
+        elle::err<serialization::Error>(
+          "truncated RPC message: expected %s bytes at offset %s, got %s",
+          size, this->_offset, this->_message.size() - this->_offset);
+      auto res = this->_message.range(this->_offset, this->_offset + size);
+      this->_offset += size;
+      return res;
+    }
+
+    void
+    RPCReader<BinaryIn>::_deserialize(std::function<void (BinaryIn&)> const& f)
+    {
+      MagicStreamBuffer buffer(this->_message.range(this->_offset));
+      std::istream input(&buffer);
+      BinaryIn serializer(input, false);
+      f(serializer);
+      this->_offset += buffer.consumed();
+    }
+  }
+}
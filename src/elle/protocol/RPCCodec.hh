@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <elle/Buffer.hh>
+#include <elle/IOStream.hh>
+#include <elle/attribute.hh>
+#include <elle/compiler.hh>
+#include <elle/serialization/binary/SerializerIn.hh>
+#include <elle/serialization/binary/SerializerOut.hh>
+
+namespace elle
+{
+  namespace protocol
+  {
+    /*----------.
+    | RPCWriter |
+    `----------*/
+
+    /// The encoder of RPC calls and replies.
+    ///
+    /// Values are streamed with `<<` through an OSerializer over an IOStream
+    /// on the message. Serializers with a more direct encoding specialize
+    /// this template, providing the same interface.
+    ///
+    /// \code{.cc}
+    ///
+    /// auto writer = elle::protocol::RPCWriter<OS>();
+    /// writer << procedure_id << 42 << std::string("foo");
+    /// channel.write(writer.finish());
+    ///
+    /// \endcode
+    ///
+    /// @tparam OSerializer The serializer, constructible from an std::ostream.
+    template <typename OSerializer>
+    class RPCWriter
+    {
+    public:
+      /// Start a message.
+      ///
+      /// @param size_hint The expected size of the message, zero if unknown.
+      RPCWriter(std::size_t size_hint = 0);
+      /// Encode @a value.
+      template <typename T>
+      RPCWriter&
+      operator <<(T const& value);
+      /// The encoded message, after which the writer must not be used.
+      elle::Buffer
+      finish();
+      /// The expected size of @a values once encoded, zero if unknown.
+      template <typename ... Args>
+      static
+      std::size_t
+      size_hint(Args const& ... values);
+
+    private:
+      ELLE_ATTRIBUTE(elle::Buffer, message);
+      ELLE_ATTRIBUTE(std::unique_ptr<elle::IOStream>, stream);
+      ELLE_ATTRIBUTE(std::unique_ptr<OSerializer>, output);
+    };
+
+    /*----------.
+    | RPCReader |
+    `----------*/
+
+    /// The decoder of RPC calls and replies.
+    ///
+    /// Values are streamed with `>>` through an ISerializer over an IOStream
+    /// on the message. Serializers with a more direct decoding specialize
+    /// this template, providing the same interface.
+    ///
+    /// @tparam ISerializer The serializer, constructible from an std::istream.
+    template <typename ISerializer>
+    class RPCReader
+    {
+    public:
+      /// Start decoding @a message, which must outlive the reader.
+      RPCReader(elle::ConstWeakBuffer message);
+      /// Decode @a value.
+      template <typename T>
+      RPCReader&
+      operator >>(T& value);
+      /// Decode a value of type @a T.
+      ///
+      /// @a T needs not be default constructible if the ISerializer provides
+      /// `deserialize<T>()`.
+      template <typename T>
+      T
+      get();
+
+    private:
+      template <typename T>
+      auto
+      _get(int)
+        -> decltype(std::declval<ISerializer&>().template deserialize<T>());
+      template <typename T>
+      T
+      _get(unsigned);
+      ELLE_ATTRIBUTE(elle::IOStream, stream);
+      ELLE_ATTRIBUTE(ISerializer, input);
+    };
+
+    /*----------------.
+    | Binary encoding |
+    `----------------*/
+
+    /// Encode RPC messages straight into a pre-sized Buffer.
+    ///
+    /// Messages are identical to the ones streamed through a non-versioned
+    /// binary::SerializerOut: numbers, booleans, strings and buffers are
+    /// written directly, other values go through the serialization.
+    template <>
+    class ELLE_API RPCWriter<serialization::binary::SerializerOut>
+    {
+    public:
+      RPCWriter(std::size_t size_hint = 0);
+      template <typename T>
+      std::enable_if_t<std::is_integral<T>::value, RPCWriter&>
+      operator <<(T value);
+      RPCWriter&
+      operator <<(double value);
+      RPCWriter&
+      operator <<(std::string const& value);
+      RPCWriter&
+      operator <<(elle::ConstWeakBuffer value);
+      RPCWriter&
+      operator <<(elle::Buffer const& value);
+      template <typename T>
+      std::enable_if_t<!std::is_arithmetic<T>::value, RPCWriter&>
+      operator <<(T const& value);
+      elle::Buffer
+      finish();
+      template <typename ... Args>
+      static
+      std::size_t
+      size_hint(Args const& ... values);
+
+    private:
+      void
+      _number(int64_t value);
+      void
+      _serialize(
+        std::function<void (serialization::binary::SerializerOut&)> const& f);
+      ELLE_ATTRIBUTE(elle::Buffer, message);
+    };
+
+    /// Decode RPC messages in place, without streams.
+    ///
+    /// @see RPCWriter<serialization::binary::SerializerOut>.
+    template <>
+    class ELLE_API RPCReader<serialization::binary::SerializerIn>
+    {
+    public:
+      /// @throw serialization::Error if @a message is not binary serialized.
+      RPCReader(elle::ConstWeakBuffer message);
+      template <typename T>
+      RPCReader&
+      operator >>(T& value);
+      /// @throw serialization::Error if the message is truncated or the
+      ///        value does not fit in @a T.
+      template <typename T>
+      T
+      get();
+
+    private:
+      template <typename T>
+      struct Type
+      {};
+      template <typename T>
+      std::enable_if_t<std::is_integral<T>::value, T>
+      _get(Type<T>);
+      bool
+      _get(Type<bool>);
+      double
+      _get(Type<double>);
+      std::string
+      _get(Type<std::string>);
+      elle::Buffer
+      _get(Type<elle::Buffer>);
+      template <typename T>
+      std::enable_if_t<!std::is_arithmetic<T>::value, T>
+      _get(Type<T>);
+      int64_t
+      _number();
+      /// The next @a size bytes.
+      elle::ConstWeakBuffer
+      _bytes(std::size_t size);
+      void
+      _deserialize(
+        std::function<void (serialization::binary::SerializerIn&)> const& f);
+      ELLE_ATTRIBUTE(elle::ConstWeakBuffer, message);
+      ELLE_ATTRIBUTE(std::size_t, offset);
+    };
+  }
+}
+
+#include <elle/protocol/RPCCodec.hxx>
@@ -0,0 +1,214 @@
+#include <limits>
+#include <utility>
+
+#include <boost/optional.hpp>
+
+#include <elle/err.hh>
+#include <elle/serialization/Error.hh>
+
+namespace elle
+{
+  namespace protocol
+  {
+    /*----------.
+    | RPCWriter |
+    `----------*/
+
+    template <typename OS>
+    RPCWriter<OS>::RPCWriter(std::size_t)
+      : _message()
+      , _stream(std::make_unique<elle::IOStream>(this->_message.ostreambuf()))
+      , _output(std::make_unique<OS>(*this->_stream))
+    {}
+
+    template <typename OS>
+    template <typename T>
+    RPCWriter<OS>&
+    RPCWriter<OS>::operator <<(T const& value)
+    {
+      *this->_output << value;
+      return *this;
+    }
+
+    template <typename OS>
+    elle::Buffer
+    RPCWriter<OS>::finish()
+    {
+      this->_output.reset();
+      this->_stream.reset();
+      return std::move(this->_message);
+    }
+
+    template <typename OS>
+    template <typename ... Args>
+    std::size_t
+    RPCWriter<OS>::size_hint(Args const& ...)
+    {
+      return 0;
+    }
+
+    /*----------.
+    | RPCReader |
+    `----------*/
+
+    template <typename IS>
+    RPCReader<IS>::RPCReader(elle::ConstWeakBuffer message)
+      : _stream(message.istreambuf())
+      , _input(this->_stream)
+    {}
+
+    template <typename IS>
+    template <typename T>
+    RPCReader<IS>&
+    RPCReader<IS>::operator >>(T& value)
+    {
+      this->_input >> value;
+      return *this;
+    }
+
+    template <typename IS>
+    template <typename T>
+    T
+    RPCReader<IS>::get()
+    {
+      return this->template _get<T>(42);
+    }
+
+    template <typename IS>
+    template <typename T>
+    auto
+    RPCReader<IS>::_get(int)
+      -> decltype(std::declval<IS&>().template deserialize<T>())
+    {
+      return this->_input.template deserialize<T>();
+    }
+
+    template <typename IS>
+    template <typename T>
+    T
+    RPCReader<IS>::_get(unsigned)
+    {
+      auto res = T{};
+      this->_input >> res;
+      return res;
+    }
+
+    /*----------------.
+    | Binary encoding |
+    `----------------*/
+
+    namespace _details
+    {
+      using BinaryOut = serialization::binary::SerializerOut;
+
+      template <typename T>
+      std::enable_if_t<std::is_arithmetic<T>::value, std::size_t>
+      binary_size(T const&)
+      {
+        return BinaryOut::number_max_size;
+      }
+
+      inline
+      std::size_t
+      binary_size(std::string const& value)
+      {
+        return BinaryOut::number_max_size + value.size();
+      }
+
+      inline
+      std::size_t
+      binary_size(elle::ConstWeakBuffer value)
+      {
+        return BinaryOut::number_max_size + value.size();
+      }
+
+      // Unknown until serialized, let the message grow.
+      template <typename T>
+      std::enable_if_t<!std::is_arithmetic<T>::value &&
+                       !std::is_convertible<T, elle::ConstWeakBuffer>::value,
+                       std::size_t>
+      binary_size(T const&)
+      {
+        return 0;
+      }
+    }
+
+    template <typename T>
+    std::enable_if_t<
+      std::is_integral<T>::value,
+      RPCWriter<serialization::binary::SerializerOut>&>
+    RPCWriter<serialization::binary::SerializerOut>::operator <<(T value)
+    {
+      this->_number(value);
+      return *this;
+    }
+
+    template <typename T>
+    std::enable_if_t<
+      !std::is_arithmetic<T>::value,
+      RPCWriter<serialization::binary::SerializerOut>&>
+    RPCWriter<serialization::binary::SerializerOut>::operator <<(T const& value)
+    {
+      this->_serialize(
+        [&] (serialization::binary::SerializerOut& output)
+        {
+          output.serialize_forward(value);
+        });
+      return *this;
+    }
+
+    template <typename ... Args>
+    std::size_t
+    RPCWriter<serialization::binary::SerializerOut>::size_hint(
+      Args const& ... values)
+    {
+      auto res = std::size_t{1};
+      for (auto size: {std::size_t{0}, _details::binary_size(values)...})
+        res += size;
+      return res;
+    }
+
+    template <typename T>
+    RPCReader<serialization::binary::SerializerIn>&
+    RPCReader<serialization::binary::SerializerIn>::operator >>(T& value)
+    {
+      value = this->get<T>();
+      return *this;
+    }
+
+    template <typename T>
+    T
+    RPCReader<serialization::binary::SerializerIn>::get()
+    {
+      return this->_get(Type<T>{});
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value, T>
+    RPCReader<serialization::binary::SerializerIn>::_get(Type<T>)
+    {
+      auto const value = this->_number();
+      using limits = std::numeric_limits<T>;
+      // 64 bits values are read as is, like binary::SerializerIn does.
+      if (sizeof(T) < sizeof(int64_t) &&
+          (value > static_cast<int64_t>(limits::max()) ||
+           value < static_cast<int64_t>(limits::min())))
+        elle::err<serialization::Error>(
+          "value %s does not fit on %s bits", value, sizeof(T) * 8);
+      return static_cast<T>(value);
+    }
+
+    template <typename T>
+    std::enable_if_t<!std::is_arithmetic<T>::value, T>
+    RPCReader<serialization::binary::SerializerIn>::_get(Type<T>)
+    {
+      auto res = boost::optional<T>{};
+      this->_deserialize(
+        [&] (serialization::binary::SerializerIn& input)
+        {
+          res.emplace(input.deserialize<T>());
+        });
+      return std::move(*res);
+    }
+  }
+}
@@ -5,19 +5,20 @@
 #endif
 
 #include <elle/Buffer.hh>
+#include <elle/finally.hh>
 #include <elle/log.hh>
 
-#include <elle/cryptography/hash.hh>
-
 #include <elle/serialization/binary.hh>
 #include <elle/serialization/json.hh>
 
 #include <elle/reactor/scheduler.hh>
 #include <elle/reactor/exception.hh>
 #include <elle/reactor/Barrier.hh>
+#include <elle/reactor/Thread.hh>
 #include <elle/reactor/network/socket.hh>
 #include <elle/reactor/network/utp-socket.hh>
 
+#include <elle/protocol/Checksum.hh>
 #include <elle/protocol/Serializer.hh>
 #include <elle/protocol/exceptions.hh>
 
@@ -59,69 +60,6 @@ namespace elle
       }
     }
 
-    static
-    elle::Buffer
-    read(std::istream& stream,
-         elle::Version const& version,
-         boost::optional<uint32_t> size = boost::none)
-    {
-      ELLE_DEBUG_SCOPE("read %s (size: %s)", stream, size);
-      if (!size)
-        size = Serializer::Super::uint32_get(stream, version);
-      ELLE_DUMP("expected size: %s", *size);
-      elle::Buffer content(*size);
-      read(stream, content, *size);
-      return content;
-    }
-
-    // Return the sha1 of a given buffer.
-    static
-    elle::Buffer
-    compute_checksum(elle::Buffer const& content)
-    {
-      ELLE_DUMP("compute checksum of '%x'", content);
-      auto hash = elle::cryptography::hash(
-        elle::ConstWeakBuffer(content.contents(),
-                              content.size()),
-        elle::cryptography::Oneway::sha1);
-      ELLE_DUMP("checksum: '%x'", hash);
-      return hash;
-    }
-
-    // Make sure the given buffer checksum match the given checksum.
-    static
-    void
-    enforce_checksums_equal(elle::Buffer const& content,
-                            elle::Buffer const& expected_checksum)
-    {
-      ELLE_DUMP_SCOPE("compare '%x' checksum with expected '%x'",
-                       content, expected_checksum);
-      auto checksum = compute_checksum(content);
-      ELLE_DUMP("checksum: '%x'", checksum);
-      if (checksum != expected_checksum)
-      {
-        ELLE_ERR("wrong packet checksum")
-          throw ChecksumError();
-      }
-    }
-
-    static
-    void
-    write(std::ostream& stream,
-          elle::Version const& version,
-          elle::Buffer const& content,
-          bool write_size = true,
-          elle::Buffer::Size offset = 0,
-          boost::optional<elle::Buffer::Size> size = boost::none)
-    {
-      elle::Buffer::Size to_send = size ? size.get() : content.size();
-      if (write_size)
-        Serializer::Super::uint32_put(stream, to_send, version);
-      stream.write(
-        reinterpret_cast<char*>(content.mutable_contents()) + offset,
-        to_send);
-    }
-
     enum Control: unsigned char
     {
       keep_going = 0,
@@ -132,24 +70,20 @@ namespace elle
       max = pong,
     };
 
-    static
-    void
-    ignore_message(std::istream& stream, elle::Version const& version)
-    {
-      // Version 0.2.0 handle but ignores messages.
-      auto res = elle::protocol::read(stream, version);
-      ELLE_WARN("%f was ignored", res);
-    }
+    // The size of the buffer data is read into from Sockets.
+    static constexpr elle::Buffer::Size input_size = 1 << 16;
 
     class Serializer::Impl
     {
     public:
       Impl(std::iostream& stream,
            elle::Buffer::Size chunk_size,
-           bool checksum,
+           boost::optional<Checksum::Algorithm> checksum,
            elle::Version const& version,
            boost::optional<std::chrono::milliseconds> ping_period,
-           boost::optional<std::chrono::milliseconds> ping_timeout)
+           boost::optional<std::chrono::milliseconds> ping_timeout,
+           boost::optional<Serializer::Coalescing> coalescing,
+           std::unique_ptr<Compression> compression)
         : _broken(false)
         , _scheduler(reactor::scheduler())
         , _pings(0)
@@ -172,16 +106,49 @@ namespace elle
             }
           })
         , _stream(stream)
+        , _socket(dynamic_cast<reactor::network::Socket*>(&stream))
+        , _pending()
+        , _framing_size(0)
+        , _input()
         , _chunk_size(chunk_size)
         , _checksum(checksum)
         , _version(version)
         , _lock_write()
         , _lock_read()
+        , _compression(std::move(compression))
+        , _coalescing(this->_socket ? std::move(coalescing) : boost::none)
+        , _batch()
+        , _batch_pending()
+        , _batch_full()
+        , _flushes(0)
+        , _flusher()
       {
         if (bool(this->_ping_period) != bool(this->_ping_delay))
           elle::err("specify either both ping period and timeout or neither");
+        // The handshake went through the stream buffer, which may have read
+        // ahead of it: start from what it holds, so no byte is skipped.
+        if (this->_socket)
+        {
+          auto const buffer = stream.rdbuf();
+          auto const available = buffer->in_avail();
+          if (available > 0)
+          {
+            this->_input.size(available);
+            this->_input.size(
+              buffer->sgetn(
+                reinterpret_cast<char*>(this->_input.mutable_contents()),
+                available));
+            ELLE_DEBUG("%s: %s bytes read ahead during the handshake",
+                       this, this->_input.size());
+          }
+        }
         if (this->_ping_period && this->version() >= elle::Version(0, 3, 0))
           this->_pinger_handler({});
+        if (this->_coalescing)
+          this->_flusher.reset(
+            new reactor::Thread(
+              elle::sprintf("%s flusher", this),
+              [this] { this->_flush_batches(); }));
       }
 
       virtual
@@ -201,7 +168,10 @@ namespace elle
             if (this->_broken)
               elle::err("stream is broken by a previous interrupted read");
             elle::IOStreamClear clearer(this->_stream);
-            return this->_read();
+            auto packet = this->_read();
+            if (this->_compression)
+              return this->_compression->decompress(std::move(packet));
+            return packet;
           }
           catch (InterruptionError const&)
           {}
@@ -222,21 +192,22 @@ namespace elle
         // return elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
         // {
           elle::Buffer hash;
+          auto checksum = boost::optional<Checksum>{};
           if (this->_checksum)
           {
+            checksum.emplace(*this->_checksum);
             ELLE_DEBUG("read checksum")
               if (this->version() >= elle::Version(0, 2, 0))
-                hash = elle::protocol::read(this->_stream, this->version(), {});
+                hash = this->_get_buffer(this->version());
               else
-                hash = elle::protocol::read(this->_stream, {});
+                hash = this->_get_buffer(elle::Version());
           }
           auto packet = [&]
           {
             if (this->version() >= elle::Version(0, 2, 0))
             {
               // Get the total size.
-              uint32_t total_size =
-                Serializer::Super::uint32_get(this->_stream, this->version());
+              uint32_t total_size = this->_get_size(this->version());
               ELLE_DEBUG("packet size: %s", total_size);
               elle::Buffer packet(static_cast<std::size_t>(total_size));
               elle::Buffer::Size offset = 0;
@@ -245,7 +216,11 @@ namespace elle
                 uint32_t size =
                   std::min(total_size - offset, this->_chunk_size);
                 ELLE_DEBUG("read chunk of size %s", size);
-                elle::protocol::read(this->_stream, packet, size, offset);
+                this->_get_range(packet, size, offset);
+                // Check chunks as they arrive, while they are in cache.
+                if (checksum)
+                  checksum->update(
+                    elle::ConstWeakBuffer(packet.contents() + offset, size));
                 offset += size;
                 ELLE_ASSERT_LTE(offset, total_size);
                 if (offset >= total_size)
@@ -256,12 +231,26 @@ namespace elle
               return packet;
             }
             else
-              return elle::protocol::read(this->_stream, {});
+            {
+              auto packet = this->_get_buffer(elle::Version());
+              if (checksum)
+                checksum->update(packet);
+              return packet;
+            }
           }();
           ELLE_DUMP("packet content: %s", packet);
           // Check checksums match.
-          if (this->_checksum)
-            enforce_checksums_equal(packet, hash);
+          if (checksum)
+          {
+            auto const computed = checksum->finish();
+            ELLE_DUMP("%s checksum: '%x', expected '%x'",
+                      checksum->algorithm(), computed, hash);
+            if (computed != hash)
+            {
+              ELLE_ERR("wrong packet checksum")
+                throw ChecksumError();
+            }
+          }
           return packet;
         }
         catch (InterruptionError const&)
@@ -278,11 +267,51 @@ namespace elle
       }
 
       void
-      write(elle::Buffer const& packet)
+      write(elle::ConstWeakBuffer header, elle::ConstWeakBuffer packet)
       {
+        if (this->_coalescing)
+          return this->_encode(
+            header, packet,
+            [this] (elle::ConstWeakBuffer header, elle::ConstWeakBuffer packet)
+            {
+              this->_write_coalesced(header, packet);
+            });
         elle::reactor::Lock lock(this->_lock_write);
         elle::IOStreamClear clearer(this->_stream);
-        this->_write(packet);
+        this->_encode(
+          header, packet,
+          [this] (elle::ConstWeakBuffer header, elle::ConstWeakBuffer packet)
+          {
+            this->_write(header, packet);
+          });
+      }
+
+      /// Compress a packet if needed, and pass it to @a write.
+      template <typename Write>
+      void
+      _encode(elle::ConstWeakBuffer header,
+              elle::ConstWeakBuffer packet,
+              Write const& write)
+      {
+        if (!this->_compression)
+          return write(header, packet);
+        try
+        {
+          if (auto compressed = this->_compression->compress(header, packet))
+            write({}, *compressed);
+          else
+          {
+            auto const raw = this->_compression->raw(header);
+            write(raw, packet);
+          }
+        }
+        catch (elle::reactor::Terminate const&)
+        {
+          // The peer may not decompress this packet, don't let the next ones
+          // depend on it.
+          this->_compression->interrupted();
+          throw;
+        }
       }
 
       void
@@ -291,8 +320,8 @@ namespace elle
         if (control != Control::pong && control != Control::ping)
           this->write_pings_pongs(false);
         ELLE_DEBUG_SCOPE("send control %s", (int) control);
-        char c = static_cast<char>(control);
-        this->_stream.write(&c, 1);
+        auto const c = static_cast<elle::Buffer::Byte>(control);
+        this->_put(elle::ConstWeakBuffer(&c, 1), true);
       }
 
       void
@@ -311,7 +340,7 @@ namespace elle
             this->write_control(Control::ping);
           }
          if (flush)
-           this->_stream.flush();
+           this->_flush();
         }
       }
 
@@ -321,10 +350,7 @@ namespace elle
         while (true)
         {
           ELLE_DUMP_SCOPE("read control");
-          if (this->_stream.peek() == std::iostream::traits_type::eof())
-            throw Serializer::EOF();
-          char control = static_cast<char>(Control::max + 1);
-          this->_stream.read(&control, 1);
+          auto const control = this->_get_control();
           if (control > Control::max)
           {
             ELLE_ERR("%s: invalid control byte: 0x%x",
@@ -341,8 +367,12 @@ namespace elle
             case Control::interrupt:
               return false;
             case Control::message:
-              ignore_message(this->_stream, this->version());
+            {
+              // Version 0.2.0 handle but ignores messages.
+              auto res = this->_get_buffer(this->version());
+              ELLE_WARN("%f was ignored", res);
               break;
+            }
             case Control::ping:
               this->pinged();
               break;
@@ -402,18 +432,27 @@ namespace elle
       ELLE_ATTRIBUTE_RX(boost::signals2::signal<void ()>, ping_timeout);
 
       void
-      _write(elle::Buffer const& packet)
+      _write(elle::ConstWeakBuffer header, elle::ConstWeakBuffer packet)
       {
+        auto const total_size = header.size() + packet.size();
         if (this->version() >= elle::Version(0, 3, 0))
           this->write_control(Control::keep_going);
+        // Referenced until the next flush when gathering.
+        auto hash = elle::Buffer{};
         if (this->_checksum)
         {
           // Compute and send checksum.
-          auto hash = compute_checksum(packet);
+          auto checksum = Checksum(*this->_checksum);
+          checksum.update(header);
+          checksum.update(packet);
+          hash = checksum.finish();
           elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
           {
             ELLE_DEBUG("send checksum: 0x%x", hash)
-              elle::protocol::write(this->_stream, this->version(), hash);
+            {
+              this->_put_size(hash.size());
+              this->_put(hash, false);
+            }
           };
         }
         if (this->version() >= elle::Version(0, 2, 0))
@@ -423,29 +462,26 @@ namespace elle
           {
             auto send = [&]
               {
-                auto to_send = std::min(this->_chunk_size, packet.size() - offset);
+                auto to_send = std::min(this->_chunk_size, total_size - offset);
                 ELLE_DEBUG_SCOPE("send %s bytes of data at offset %s",
                                  to_send, offset);
-                elle::protocol::write(
-                  this->_stream,
-                  this->version(), packet, false, offset, to_send);
+                this->_put_range(header, packet, offset, to_send);
                 offset += to_send;
-                this->_stream.flush();
+                this->_flush();
               };
             {
               elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
               {
                 // Send the size.
                 {
-                  auto size = packet.size();
-                  ELLE_DEBUG("send packet size %s", size)
-                    Serializer::Super::uint32_put(this->_stream, size, this->version());
+                  ELLE_DEBUG("send packet size %s", total_size)
+                    this->_put_size(total_size);
                 }
                 // Send first chunk
                 send();
               };
             }
-            while (offset < packet.size())
+            while (offset < total_size)
             {
               elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
               {
@@ -457,10 +493,10 @@ namespace elle
           }
           catch (elle::reactor::Terminate const&)
           {
-            if (offset < packet.size())
+            if (offset < total_size)
             {
               ELLE_DEBUG("interrupted after sending %s bytes over %s",
-                         offset, packet.size());
+                         offset, total_size);
               this->write_control(Control::interrupt);
               this->write_pings_pongs(true);
             }
@@ -473,17 +509,407 @@ namespace elle
           elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
           {
             ELLE_DEBUG("send actual data")
-              elle::protocol::write(this->_stream, this->version(), packet);
-            this->_stream.flush();
+            {
+              this->_put_size(total_size);
+              this->_put_range(header, packet, 0, total_size);
+            }
+            this->_flush();
           };
       }
+
+    /*-----------.
+    | Coalescing |
+    `-----------*/
+    private:
+      /// Packets queued for a coalesced write.
+      struct Batch
+      {
+        /// The buffers of each packet, owned by their writer.
+        std::list<reactor::network::Socket::Buffers const*> packets;
+        elle::Buffer::Size size = 0;
+        Time deadline;
+        /// Whether the packets are being written and can't be dropped.
+        bool flushing = false;
+        reactor::Barrier flushed;
+        std::exception_ptr error;
+      };
+
+      /// Queue a packet for the next coalesced write and wait until it is
+      /// sent.
+      ///
+      /// The packet is framed exactly as _write does, except it is never
+      /// interrupted half way: it is either dropped before being sent or sent
+      /// entirely.
+      void
+      _write_coalesced(elle::ConstWeakBuffer header,
+                       elle::ConstWeakBuffer packet)
+      {
+        auto const total_size = header.size() + packet.size();
+        auto const chunked = this->version() >= elle::Version(0, 2, 0);
+        auto const chunks = chunked ?
+          std::max<elle::Buffer::Size>(
+            1, (total_size + this->_chunk_size - 1) / this->_chunk_size) :
+          1;
+        // Referenced by the queued buffers, so it must never reallocate.
+        auto framing = elle::Buffer{};
+        framing.capacity(3 * Serializer::Super::uint32_max_size + chunks);
+        auto hash = elle::Buffer{};
+        auto buffers = reactor::network::Socket::Buffers{};
+        auto put_frame = [&] (elle::ConstWeakBuffer data)
+          {
+            ELLE_ASSERT_LTE(framing.size() + data.size(), framing.capacity());
+            auto const p = framing.contents() + framing.size();
+            framing.append(data.contents(), data.size());
+            if (!buffers.empty() &&
+                buffers.back().contents() + buffers.back().size() == p)
+              buffers.back().size(buffers.back().size() + data.size());
+            else
+              buffers.emplace_back(p, data.size());
+          };
+        auto put_control = [&] (Control control)
+          {
+            auto const c = static_cast<elle::Buffer::Byte>(control);
+            put_frame(elle::ConstWeakBuffer(&c, 1));
+          };
+        auto put_size = [&] (uint32_t size)
+          {
+            elle::Buffer::Byte bytes[Serializer::Super::uint32_max_size];
+            put_frame(elle::ConstWeakBuffer(
+                        bytes,
+                        Serializer::Super::uint32_put(
+                          bytes, size, this->version())));
+          };
+        auto put_range =
+          [&] (elle::Buffer::Size offset, elle::Buffer::Size size)
+          {
+            if (offset < header.size())
+            {
+              auto const n = std::min(size, header.size() - offset);
+              buffers.emplace_back(header.range(offset, offset + n));
+              offset += n;
+              size -= n;
+            }
+            if (size)
+              buffers.emplace_back(
+                packet.contents() + offset - header.size(), size);
+          };
+        if (this->version() >= elle::Version(0, 3, 0))
+          put_control(Control::keep_going);
+        if (this->_checksum)
+        {
+          auto checksum = Checksum(*this->_checksum);
+          checksum.update(header);
+          checksum.update(packet);
+          hash = checksum.finish();
+          put_size(hash.size());
+          buffers.emplace_back(hash);
+        }
+        put_size(total_size);
+        if (chunked)
+          for (auto offset = elle::Buffer::Size{0}; true;)
+          {
+            auto const n = std::min(this->_chunk_size, total_size - offset);
+            put_range(offset, n);
+            offset += n;
+            if (offset >= total_size)
+              break;
+            put_control(Control::keep_going);
+          }
+        else
+          put_range(0, total_size);
+        auto const bytes = framing.size() + hash.size() + total_size;
+        if (!this->_batch)
+        {
+          this->_batch = std::make_shared<Batch>();
+          this->_batch->deadline = Clock::now() + this->_coalescing->delay;
+          this->_batch_pending.open();
+        }
+        auto const batch = this->_batch;
+        auto const it = batch->packets.emplace(batch->packets.end(), &buffers);
+        batch->size += bytes;
+        ELLE_DEBUG("queue %s bytes, %s bytes pending", bytes, batch->size);
+        if (batch->size >= this->_coalescing->threshold)
+          this->_batch_full.open();
+        try
+        {
+          reactor::wait(batch->flushed);
+        }
+        catch (elle::reactor::Terminate const&)
+        {
+          if (batch->flushing)
+            // The buffers must outlive the write.
+            elle::With<elle::reactor::Thread::NonInterruptible>() << [&]
+            {
+              reactor::wait(batch->flushed);
+            };
+          else
+          {
+            ELLE_DEBUG("drop packet interrupted before being sent");
+            batch->packets.erase(it);
+            batch->size -= bytes;
+          }
+          throw;
+        }
+        if (batch->error)
+          std::rethrow_exception(batch->error);
+      }
+
+      /// Send batches of queued packets as they fill up or expire.
+      void
+      _flush_batches()
+      {
+        while (true)
+        {
+          reactor::wait(this->_batch_pending);
+          auto const batch = this->_batch;
+          // Writers are released whatever happens, with an error unless their
+          // packets were sent.
+          elle::SafeFinally flushed([&] { batch->flushed.open(); });
+          try
+          {
+            auto const remaining = batch->deadline - Clock::now();
+            if (remaining > Clock::duration::zero())
+              reactor::wait(
+                this->_batch_full,
+                boost::posix_time::microseconds(
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                    remaining).count()));
+            this->_batch.reset();
+            this->_batch_pending.close();
+            this->_batch_full.close();
+            batch->flushing = true;
+            if (batch->packets.empty())
+              continue;
+            ELLE_DEBUG_SCOPE("send %s packets, %s bytes",
+                             batch->packets.size(), batch->size);
+            elle::reactor::Lock lock(this->_lock_write);
+            elle::IOStreamClear clearer(this->_stream);
+            // Controls are only interleaved between packets.
+            this->write_pings_pongs(false);
+            for (auto packet: batch->packets)
+              for (auto const& buffer: *packet)
+                this->_put(buffer, false);
+            this->_flush();
+          }
+          catch (elle::reactor::Terminate const&)
+          {
+            ELLE_TRACE("coalesced write terminated");
+            batch->error = std::make_exception_ptr(
+              elle::Error("serializer destroyed before packets were sent"));
+            throw;
+          }
+          catch (...)
+          {
+            ELLE_TRACE("coalesced write failed: %s", elle::exception_string());
+            batch->error = std::current_exception();
+          }
+        }
+      }
+
+    private:
+      /// Write @a data to the stream or, when it is a Socket, queue it for the
+      /// next gather write.
+      ///
+      /// @param data The bytes to write.
+      /// @param copy Whether @a data must be copied when queued, as opposed to
+      ///             outliving the next flush.
+      void
+      _put(elle::ConstWeakBuffer data, bool copy)
+      {
+        if (!this->_socket)
+          this->_stream.write(
+            reinterpret_cast<char const*>(data.contents()), data.size());
+        else if (copy)
+        {
+          if (this->_framing_size + data.size() > sizeof(this->_framing))
+            this->_flush();
+          auto const p = this->_framing + this->_framing_size;
+          memcpy(p, data.contents(), data.size());
+          this->_framing_size += data.size();
+          // Merge consecutive framing bytes into a single buffer.
+          if (!this->_pending.empty() &&
+              this->_pending.back().contents() +
+              this->_pending.back().size() == p)
+            this->_pending.back().size(
+              this->_pending.back().size() + data.size());
+          else
+            this->_pending.emplace_back(p, data.size());
+        }
+        else if (data.size())
+          this->_pending.emplace_back(data);
+      }
+
+      void
+      _put_size(uint32_t size)
+      {
+        elle::Buffer::Byte bytes[Serializer::Super::uint32_max_size];
+        this->_put(
+          elle::ConstWeakBuffer(
+            bytes,
+            Serializer::Super::uint32_put(bytes, size, this->version())),
+          true);
+      }
+
+      // Write a range of the concatenation of a header and a buffer, without
+      // concatenating them.
+      void
+      _put_range(elle::ConstWeakBuffer header,
+                 elle::ConstWeakBuffer content,
+                 elle::Buffer::Size offset,
+                 elle::Buffer::Size size)
+      {
+        if (offset < header.size())
+        {
+          auto const n = std::min(size, header.size() - offset);
+          this->_put(header.range(offset, offset + n), false);
+          offset += n;
+          size -= n;
+        }
+        if (size)
+        {
+          auto const start = offset - header.size();
+          this->_put(elle::ConstWeakBuffer(content.contents() + start, size),
+                     false);
+        }
+      }
+
+      /// Flush the stream or send queued data with a single gather write.
+      void
+      _flush()
+      {
+        this->_stream.flush();
+        if (this->_socket && !this->_pending.empty())
+        {
+          elle::SafeFinally reset(
+            [&]
+            {
+              this->_pending.clear();
+              this->_framing_size = 0;
+            });
+          ++this->_flushes;
+          this->_socket->write(this->_pending);
+        }
+      }
+
+      /// Read a control byte.
+      char
+      _get_control()
+      {
+        if (!this->_socket)
+        {
+          if (this->_stream.peek() == std::iostream::traits_type::eof())
+            throw Serializer::EOF();
+          char control = static_cast<char>(Control::max + 1);
+          this->_stream.read(&control, 1);
+          return control;
+        }
+        this->_fill(1);
+        auto const control = static_cast<char>(this->_input[0]);
+        this->_input.pop_front(1);
+        return control;
+      }
+
+      /// Read a size, decoding it from the input buffer when reading from a
+      /// Socket.
+      uint32_t
+      _get_size(elle::Version const& version)
+      {
+        if (!this->_socket)
+          return Serializer::Super::uint32_get(this->_stream, version);
+        this->_fill(1);
+        this->_fill(
+          version >= elle::Version(0, 3, 0) ?
+          serialization::binary::SerializerIn::number_size(this->_input[0]) :
+          4);
+        return Serializer::Super::uint32_get(this->_input, version);
+      }
+
+      // Read a chunk. The data struct is:
+      // - the size: n bytes
+      // - the content: $size bytes.
+      elle::Buffer
+      _get_buffer(elle::Version const& version)
+      {
+        auto const size = this->_get_size(version);
+        ELLE_DEBUG_SCOPE("read %s bytes", size);
+        elle::Buffer content(size);
+        this->_get_range(content, size, 0);
+        return content;
+      }
+
+      /// Read @a size bytes into @a content at @a offset.
+      void
+      _get_range(elle::Buffer& content,
+                 elle::Buffer::Size size,
+                 elle::Buffer::Size offset)
+      {
+        if (!this->_socket)
+          return elle::protocol::read(this->_stream, content, size, offset);
+        auto output = content.mutable_contents() + offset;
+        auto const buffered = std::min(size, this->_input.size());
+        memcpy(output, this->_input.contents(), buffered);
+        this->_input.pop_front(buffered);
+        output += buffered;
+        size -= buffered;
+        // Read large payloads in place rather than through the input buffer.
+        if (size >= input_size / 2)
+          this->_socket->read(elle::WeakBuffer(output, size));
+        else if (size)
+        {
+          this->_fill(size);
+          memcpy(output, this->_input.contents(), size);
+          this->_input.pop_front(size);
+        }
+      }
+
+      /// Read from the Socket until at least @a size bytes are buffered.
+      void
+      _fill(elle::Buffer::Size size)
+      {
+        while (this->_input.size() < size)
+        {
+          auto const buffered = this->_input.size();
+          // Reclaim the consumed space once it exceeds half the buffer.
+          if (this->_input.capacity() < std::max(size, input_size / 2))
+            this->_input.capacity(std::max(size, input_size));
+          // Keep the bytes read before an interruption.
+          int read = 0;
+          elle::SafeFinally account(
+            [&] { this->_input.size(buffered + read); });
+          this->_socket->read_some(
+            elle::WeakBuffer(this->_input.mutable_contents() + buffered,
+                             this->_input.capacity() - buffered),
+            {}, &read);
+        }
+      }
+
     private:
       ELLE_ATTRIBUTE_RX(std::iostream&, stream, protected);
+      /// The stream as a Socket, to write packets with gather writes and read
+      /// them without going through the std::istream interface.
+      ELLE_ATTRIBUTE(reactor::network::Socket*, socket);
+      /// Data queued for the next gather write.
+      ELLE_ATTRIBUTE(reactor::network::Socket::Buffers, pending);
+      /// Storage for queued control bytes and sizes.
+      elle::Buffer::Byte _framing[64];
+      ELLE_ATTRIBUTE(elle::Buffer::Size, framing_size);
+      /// Data read from the Socket and not consumed yet.
+      ELLE_ATTRIBUTE(elle::Buffer, input);
       ELLE_ATTRIBUTE(elle::Buffer::Size, chunk_size, protected);
-      ELLE_ATTRIBUTE(bool, checksum, protected);
+      ELLE_ATTRIBUTE(boost::optional<Checksum::Algorithm>, checksum, protected);
       ELLE_ATTRIBUTE_R(elle::Version, version);
       ELLE_ATTRIBUTE(elle::reactor::Mutex, lock_write, protected);
       ELLE_ATTRIBUTE(elle::reactor::Mutex, lock_read, protected);
+      ELLE_ATTRIBUTE_R(std::unique_ptr<Compression>, compression);
+      ELLE_ATTRIBUTE(boost::optional<Serializer::Coalescing>, coalescing);
+      /// The batch packets are being queued into, if any.
+      ELLE_ATTRIBUTE(std::shared_ptr<Batch>, batch);
+      /// Opened while a batch is being filled.
+      ELLE_ATTRIBUTE(reactor::Barrier, batch_pending);
+      /// Opened once the batch being filled reaches the threshold.
+      ELLE_ATTRIBUTE(reactor::Barrier, batch_full);
+      ELLE_ATTRIBUTE_R(std::size_t, flushes);
+      ELLE_ATTRIBUTE(reactor::Thread::unique_ptr, flusher);
     };
 
     /*------.
@@ -504,12 +930,18 @@ namespace elle
       bool checksum,
       boost::optional<std::chrono::milliseconds> ping_period,
       boost::optional<std::chrono::milliseconds> ping_timeout,
-      elle::Buffer::Size chunk_size)
+      elle::Buffer::Size chunk_size,
+      Checksum::Algorithms checksums,
+      boost::optional<Coalescing> coalescing,
+      boost::optional<Compression::Settings> compression)
       : Super(*elle::reactor::Scheduler::scheduler())
       , _stream(stream)
       , _version(version)
       , _chunk_size(chunk_size)
       , _checksum(checksum)
+      , _checksum_algorithm()
+      , _compression_algorithm()
+      , _coalescing(coalescing)
     {
       if (this->version() >= elle::Version(0, 2, 0))
       {
@@ -526,15 +958,88 @@ namespace elle
         }
       }
       ELLE_TRACE("using version: '%s'", this->version());
+      if (this->version() >= elle::Version(0, 4, 0))
+      {
+        auto const local = checksum ? checksums : Checksum::Algorithms(0);
+        ELLE_TRACE("%s: send accepted checksums: 0x%x", *this, int(local))
+          stream.put(static_cast<char>(local));
+        stream.flush();
+        ELLE_TRACE("%s: read peer accepted checksums", *this)
+        {
+          auto const peer = stream.get();
+          if (peer == std::iostream::traits_type::eof())
+            throw Serializer::EOF();
+          ELLE_DEBUG("peer accepted checksums: 0x%x", peer);
+          this->_checksum_algorithm =
+            Checksum::negotiate(local, static_cast<Checksum::Algorithms>(peer));
+        }
+        this->_checksum = bool(this->_checksum_algorithm);
+      }
+      else if (checksum)
+        this->_checksum_algorithm = Checksum::Algorithm::sha1;
+      ELLE_TRACE("using checksum: %s", this->_checksum_algorithm);
+      auto compressor = std::unique_ptr<Compression>{};
+      if (this->version() >= elle::Version(0, 6, 0))
+      {
+        auto const local = compression ?
+          compression->algorithms : Compression::Algorithms(0);
+        // Packets queued for coalescing may be dropped, they can't depend on
+        // each other.
+        auto const mode = compression && !coalescing ?
+          compression->mode : Compression::Mode::packet;
+        ELLE_TRACE("%s: send accepted compressions: 0x%x, %s",
+                   *this, int(local), mode)
+        {
+          stream.put(static_cast<char>(local));
+          stream.put(static_cast<char>(mode));
+        }
+        stream.flush();
+        ELLE_TRACE("%s: read peer accepted compressions", *this)
+        {
+          auto const peer = stream.get();
+          auto const peer_mode = stream.get();
+          if (peer_mode == std::iostream::traits_type::eof())
+            throw Serializer::EOF();
+          ELLE_DEBUG("peer accepted compressions: 0x%x, %s", peer,
+                     static_cast<Compression::Mode>(peer_mode));
+          this->_compression_algorithm = Compression::negotiate(
+            local, static_cast<Compression::Algorithms>(peer));
+          if (this->_compression_algorithm)
+            compressor = std::make_unique<Compression>(
+              *this->_compression_algorithm,
+              mode == Compression::Mode::stream &&
+              peer_mode == static_cast<int>(Compression::Mode::stream) ?
+              Compression::Mode::stream : Compression::Mode::packet,
+              compression->threshold,
+              compression->level);
+        }
+      }
+      ELLE_TRACE("using compression: %s", this->_compression_algorithm);
       this->_impl.reset(
-        new Impl(stream, this->_chunk_size, checksum, version,
-                 std::move(ping_period), std::move(ping_timeout)));
+        new Impl(stream, this->_chunk_size, this->_checksum_algorithm,
+                 this->version(),
+                 std::move(ping_period), std::move(ping_timeout),
+                 std::move(coalescing), std::move(compressor)));
       this->_impl->ping_timeout().connect(this->_ping_timeout);
     }
 
     Serializer::~Serializer()
     {}
 
+    std::size_t
+    Serializer::flushes() const
+    {
+      return this->_impl->flushes();
+    }
+
+    Compression::Statistics
+    Serializer::compression_statistics() const
+    {
+      if (auto const& compression = this->_impl->compression())
+        return compression->statistics();
+      return {};
+    }
+
     /*----------.
     | Receiving |
     `----------*/
@@ -552,7 +1057,14 @@ namespace elle
     void
     Serializer::_write(elle::Buffer const& packet)
     {
-      this->_impl->write(packet);
+      this->_impl->write({}, packet);
+    }
+
+    void
+    Serializer::_write(elle::ConstWeakBuffer header,
+                       elle::ConstWeakBuffer packet)
+    {
+      this->_impl->write(header, packet);
     }
 
     /*----------.
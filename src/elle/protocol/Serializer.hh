@@ -8,6 +8,8 @@
 #include <elle/attribute.hh>
 #include <elle/compiler.hh>
 
+#include <elle/protocol/Checksum.hh>
+#include <elle/protocol/Compression.hh>
 #include <elle/protocol/Stream.hh>
 
 #ifdef EOF
@@ -28,7 +30,14 @@ namespace elle
     ///
     /// When a serializer is constructed on top a std::iostream, it will push
     /// its version and read the peer version in order to agree what version to
-    /// use (actually, the smaller of the versions).
+    /// use (actually, the smaller of the versions). From version 0.4.0, they
+    /// then agree on the checksum algorithm, see Checksum::negotiate. Earlier
+    /// versions use SHA-1. From version 0.6.0, they also agree on whether and
+    /// how to compress packets, see Compression::negotiate.
+    ///
+    /// When writing many small packets concurrently on a Socket, packets can
+    /// be coalesced: writers queue their packets and a single write sends
+    /// them all once enough bytes are queued or a short delay expired.
     ///
     /// \code{.cc}
     ///
@@ -53,6 +62,15 @@ namespace elle
       public:
         EOF();
       };
+      /// When to send packets written concurrently in a single write.
+      struct Coalescing
+      {
+        /// Send queued packets once they amount to that many bytes.
+        elle::Buffer::Size threshold;
+        /// Send queued packets at the latest that long after the first one
+        /// was queued.
+        std::chrono::microseconds delay;
+      };
 
     /*-------------.
     | Construction |
@@ -63,13 +81,25 @@ namespace elle
       /// @param stream The underlying std::iostream.
       /// @param version The version of the protocol.
       /// @param checksum Whether it should read and write the checksum of
-      ///                 packets sent.
+      ///                 packets sent. From version 0.4.0, checksums are
+      ///                 only used if both ends enable them.
+      /// @param checksums The checksum algorithms accepted, from version
+      ///                  0.4.0.
+      /// @param coalescing Whether and when to coalesce packets written
+      ///                   concurrently, if @a stream is a Socket.
+      /// @param compression How to compress packets, from version 0.6.0.
+      ///                    Packets are only compressed if both ends enable
+      ///                    it, and are compressed independently when
+      ///                    coalescing.
       Serializer(std::iostream& stream,
                  elle::Version const& version = elle::Version(0, 1, 0),
                  bool checksum = true,
                  boost::optional<std::chrono::milliseconds> ping_period = {},
                  boost::optional<std::chrono::milliseconds> ping_timeout = {},
-                 elle::Buffer::Size chunk_size = 2 << 16);
+                 elle::Buffer::Size chunk_size = 2 << 16,
+                 Checksum::Algorithms checksums = Checksum::all,
+                 boost::optional<Coalescing> coalescing = {},
+                 boost::optional<Compression::Settings> compression = {});
       ~Serializer();
 
     /*----------.
@@ -88,9 +118,21 @@ namespace elle
     protected:
       /// Write data to the stream.
       ///
+      /// When coalescing, the packet is sent with the other packets queued
+      /// meanwhile. If the writer is terminated before they are sent, the
+      /// packet is dropped altogether.
+      ///
       /// @param packet The packet to write.
       void
       _write(elle::Buffer const& packet) override;
+      /// Write a header and a packet as a single packet, without concatenating
+      /// them.
+      ///
+      /// @param header The header to write first.
+      /// @param packet The packet to write.
+      void
+      _write(elle::ConstWeakBuffer header,
+             elle::ConstWeakBuffer packet) override;
 
     /*----------.
     | Printable |
@@ -106,7 +148,19 @@ namespace elle
       ELLE_ATTRIBUTE_R(elle::Version, version, override);
       ELLE_ATTRIBUTE_R(elle::Buffer::Size, chunk_size);
       ELLE_ATTRIBUTE_R(bool, checksum);
+      /// The checksum algorithm in use, if any.
+      ELLE_ATTRIBUTE_R(boost::optional<Checksum::Algorithm>, checksum_algorithm);
       ELLE_ATTRIBUTE_RX(boost::signals2::signal<void ()>, ping_timeout);
+      /// The compression algorithm in use, if any.
+      ELLE_ATTRIBUTE_R(boost::optional<Compression::Algorithm>,
+                       compression_algorithm);
+      /// The compression activity.
+      Compression::Statistics
+      compression_statistics() const;
+      ELLE_ATTRIBUTE_R(boost::optional<Coalescing>, coalescing);
+      /// The number of writes issued on the Socket.
+      std::size_t
+      flushes() const;
     public:
       class Impl;
     private:
@@ -59,6 +59,24 @@ namespace elle
       this->_write(packet);
     }
 
+    void
+    Stream::write(elle::ConstWeakBuffer header, elle::ConstWeakBuffer packet)
+    {
+      ELLE_TRACE_SCOPE("%s: write packet (%s + %s bytes)",
+                       this, header.size(), packet.size());
+      this->_write(header, packet);
+    }
+
+    void
+    Stream::_write(elle::ConstWeakBuffer header, elle::ConstWeakBuffer packet)
+    {
+      auto p = elle::Buffer{};
+      p.capacity(header.size() + packet.size());
+      p.append(header.contents(), header.size());
+      p.append(packet.contents(), packet.size());
+      this->_write(p);
+    }
+
     /*------------------.
     | Int serialization |
     `------------------*/
@@ -66,15 +84,25 @@ namespace elle
     void
     Stream::uint32_put(elle::Buffer& b, uint32_t i, elle::Version const& v)
     {
+      auto const size = b.size();
+      b.size(size + uint32_max_size);
+      b.size(size + uint32_put(b.mutable_contents() + size, i, v));
+    }
+
+    elle::Buffer::Size
+    Stream::uint32_put(elle::Buffer::Byte* output,
+                       uint32_t i,
+                       elle::Version const& v)
+    {
+      static_assert(uint32_max_size >= SerializerOut::number_max_size,
+                    "uint32_max_size is too small");
       if (v >= elle::Version(0, 3, 0))
-      {
-        elle::IOStream output(b.ostreambuf());
-        SerializerOut::serialize_number(output, i);
-      }
+        return SerializerOut::serialize_number(output, i);
       else
       {
         i = htonl(i);
-        b.append(&i, 4);
+        memcpy(output, &i, 4);
+        return 4;
       }
     }
 
@@ -83,9 +111,10 @@ namespace elle
     {
       if (v >= elle::Version(0, 3, 0))
       {
-        elle::IOStream input(b.istreambuf());
         int64_t res;
-        b.pop_front(SerializerIn::serialize_number(input, res));
+        b.pop_front(SerializerIn::serialize_number(b, res));
+        if (res < 0 || std::numeric_limits<uint32_t>::max() < res)
+          throw Error(elle::sprintf("unexpected uint32_t: %s", res));
         return (uint32_t) res;
       }
       else
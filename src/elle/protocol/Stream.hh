@@ -63,10 +63,25 @@ namespace elle
       /// @param packet The buffer to write.
       void
       write(elle::Buffer const& packet);
+      /// Write a packet made of a header followed by a buffer.
+      ///
+      /// Enables framing a packet, e.g. with a channel id, or a part of a
+      /// buffer without copying it when the implementation supports it.
+      ///
+      /// @param header The header to write first.
+      /// @param packet The bytes to write.
+      void
+      write(elle::ConstWeakBuffer header, elle::ConstWeakBuffer packet);
     protected:
       virtual
       void
       _write(elle::Buffer const& packet) = 0;
+      /// Write a header followed by a buffer.
+      ///
+      /// Writes their concatenation by default.
+      virtual
+      void
+      _write(elle::ConstWeakBuffer header, elle::ConstWeakBuffer packet);
 
     /*------------------.
     | Int serialization |
@@ -104,12 +119,27 @@ namespace elle
       static
       void
       uint32_put(elle::Buffer& buffer, uint32_t i, elle::Version const& v);
-      /// Read an uint32_t from @a given stream.
+      /// Maximum size of a serialized uint32_t.
+      static constexpr elle::Buffer::Size uint32_max_size = 9;
+      /// Write an uint32_t to @a given memory.
+      ///
+      /// @param output Where to write, at least uint32_max_size bytes.
+      /// @param i The int to write.
+      /// @param v The version.
+      /// @returns The number of bytes written.
+      static
+      elle::Buffer::Size
+      uint32_put(elle::Buffer::Byte* output,
+                 uint32_t i,
+                 elle::Version const& v);
+      /// Read an uint32_t from the front of @a given buffer and drop it.
       ///
       /// The version is for compatibility reasons. From version 0.3.0, the way
       /// the protocol serializes `int`s changed.
       ///
-      /// @param s The stream to read from.
+      /// This is constant time: the rest of the buffer is not moved.
+      ///
+      /// @param s The buffer to read from.
       /// @param v The version.
       static
       uint32_t
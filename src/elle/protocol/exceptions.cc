@@ -1,3 +1,5 @@
+#include <elle/printf.hh>
+
 #include <elle/protocol/exceptions.hh>
 
 namespace elle
@@ -19,5 +21,12 @@ namespace elle
     RPCError::RPCError(std::string const& message):
       Super(message)
     {}
+
+    std::string const RPCOverloaded::reason = "server overloaded";
+
+    RPCOverloaded::RPCOverloaded(std::string const& procedure):
+      Super(elle::sprintf("remote procedure '%s' rejected: %s",
+                          procedure, reason))
+    {}
   }
 }
@@ -41,6 +41,18 @@ namespace elle
       using Super = Error;
       RPCError(std::string const& message);
     };
+
+    /// A remote RPC was rejected because the server had too many pending
+    /// calls.
+    class RPCOverloaded:
+      public RPCError
+    {
+    public:
+      using Super = RPCError;
+      RPCOverloaded(std::string const& procedure);
+      /// The error servers reply with when rejecting a call.
+      static std::string const reason;
+    };
   }
 }
 
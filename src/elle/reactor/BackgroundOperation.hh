@@ -49,9 +49,12 @@ namespace elle
       /// Construct a BackgroundOperation from an Action.
       ///
       /// \param action The Action to perform.
-      BackgroundOperation(Action const& action);
+      /// \param c      The class of the Action, selecting the pool running it.
+      BackgroundOperation(Action const& action,
+                          BackgroundClass c = BackgroundClass::blocking);
       ~BackgroundOperation();
       ELLE_ATTRIBUTE(Action, action);
+      ELLE_ATTRIBUTE_R(BackgroundClass, job_class);
       ELLE_ATTRIBUTE(std::shared_ptr<Status>, status);
 
     protected:
@@ -65,7 +68,8 @@ namespace elle
       /// Abort the current BackgroundOperation, ignoring its result.
       ///
       /// Operation::done() is called but BackgroundOperationResult::_result is
-      /// is left empty.
+      /// is left empty. The system thread still runs the Action to completion
+      /// and is only then available for other jobs.
       void
       _abort() override;
     };
@@ -10,9 +10,11 @@ namespace elle
   namespace reactor
   {
     template <typename T>
-    BackgroundOperation<T>::BackgroundOperation(Action const& action)
+    BackgroundOperation<T>::BackgroundOperation(Action const& action,
+                                                BackgroundClass c)
       : Operation(*Scheduler::scheduler())
       , _action(action)
+      , _job_class(c)
       , _status(std::make_shared<Status>())
     {
       this->_status->aborted = false;
@@ -102,7 +104,8 @@ namespace elle
               }
             };
           }
-        });
+        },
+        this->_job_class);
     }
 
     template <typename T>
@@ -114,7 +117,6 @@ namespace elle
       ELLE_TRACE_SCOPE("%s: abort background operation", sched);
       this->_status->aborted = true;
       this->_signal();
-      ++sched._background_pool_free;
     }
   }
 }
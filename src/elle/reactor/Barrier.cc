@@ -8,6 +8,18 @@ namespace elle
       | Construction |
       `-------------*/
 
+    Barrier::Barrier()
+      : Super()
+      , _opened(false)
+      , _inverted(*this)
+    {}
+
+    Barrier::Barrier(LiteralName name)
+      : Super(name)
+      , _opened(false)
+      , _inverted(*this)
+    {}
+
     Barrier::Barrier(const std::string& name)
       : Super(name)
       , _opened(false)
@@ -117,7 +129,7 @@ namespace elle
     Barrier::print(std::ostream& stream) const
     {
       stream << "barrier ";
-      if (!this->name().empty())
+      if (*this->name())
         stream << this->name();
       else
         stream << this;
@@ -31,10 +31,17 @@ namespace elle
       | Construction |
       `-------------*/
     public:
-      /// Create a closed Barrier with the given name.
+      /// Create a closed unnamed Barrier.
+      Barrier();
+      /// Create a closed Barrier named by a string literal, without copying
+      /// it.
       ///
       /// \param name The barrier name, for pretty-printing purpose.
-      Barrier(const std::string& name = std::string());
+      Barrier(LiteralName name);
+      /// Create a closed Barrier with a copy of the given name.
+      ///
+      /// \param name The barrier name, for pretty-printing purpose.
+      Barrier(const std::string& name);
       Barrier(Barrier&&) = default;
       ~Barrier();
 
@@ -1,11 +1,13 @@
 #pragma once
 
-#include <queue>
 #include <limits>
+#include <queue>
+#include <vector>
 
 #include <elle/Printable.hh>
 #include <elle/attribute.hh>
 #include <elle/reactor/Barrier.hh>
+#include <elle/reactor/RingQueue.hh>
 
 namespace elle
 {
@@ -15,6 +17,10 @@ namespace elle
     /// data in a Channel already full will force the Thread to wait. Trying
     /// to get data from an empty Channel will block Thread.
     ///
+    /// A Channel is unbounded unless given a maximum size, in which case
+    /// producers are suspended until consumers catch up. Data is stored in a
+    /// RingQueue by default, which does not allocate per element.
+    ///
     /// @code{.cc}
     ///
     /// Channel<int> c;
@@ -46,7 +52,7 @@ namespace elle
     /// };
     /// // Result:
     /// // put 0.put 1.get 0.get 1.put 2.put 3.get 3.get 4.put 4.get 4.
-    template <class T, class Container = std::queue<T>>
+    template <class T, class Container = RingQueue<T>>
     class Channel
       : public elle::Printable
     {
@@ -60,8 +66,14 @@ namespace elle
       | Construction |
       `-------------*/
     public:
-      /// Create a Channel.
+      /// Create an unbounded Channel.
       Channel();
+      /// Create a bounded Channel.
+      ///
+      /// @param max_size The number of queued elements beyond which put
+      ///                 waits.
+      explicit
+      Channel(int max_size);
       /// Create a Channel from another Channel. Data are acquired by this
       /// Channel.
       Channel(Self&& source);
@@ -86,6 +98,14 @@ namespace elle
       template <typename... Args>
       void
       emplace(Args&&... args);
+      /// Put a batch of data, waking readers once rather than per element.
+      ///
+      /// If the Channel fills up, wait for capacity like put, after making
+      /// the data already put available.
+      ///
+      /// @param data The data to store, in order.
+      void
+      put_many(std::vector<T> data);
 
       /// Get data and pop it from the Channel.
       ///
@@ -98,6 +118,14 @@ namespace elle
       /// @post _read_barrier is closed if _size == 0.
       T
       get();
+      /// Get and pop up to @a max elements, waiting for at least one.
+      ///
+      /// Writers waiting for capacity are woken once for the whole batch.
+      ///
+      /// @param max The maximum number of elements to get.
+      /// @returns At least one and at most @a max elements, in order.
+      std::vector<T>
+      get_many(int max = SizeUnlimited);
       /// Get data from the Channel without altering it.
       ///
       /// If _read_barrier is not opened, wait until it is.
@@ -122,6 +150,18 @@ namespace elle
     private:
       void
       _exhausted();
+      /// Wait until there is room for one more element.
+      void
+      _wait_capacity();
+      /// Wait until data is readable, rethrowing the exception if raised.
+      void
+      _wait_data();
+      /// Wake readers after some data was queued.
+      void
+      _readable();
+      /// Wake writers after some data was popped.
+      void
+      _writable();
 
     /*--------.
     | Control |
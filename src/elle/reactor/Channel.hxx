@@ -12,12 +12,19 @@ namespace elle
 
     template <typename T, typename Container>
     Channel<T, Container>::Channel()
-      : _read_barrier("channel read")
-      , _write_barrier("channel write")
+      : _read_barrier("channel read"_literal)
+      , _write_barrier("channel write"_literal)
       , _opened(true)
       , _max_size(SizeUnlimited)
     {}
 
+    template <typename T, typename Container>
+    Channel<T, Container>::Channel(int max_size)
+      : Channel()
+    {
+      this->_max_size = max_size;
+    }
+
     template <typename T, typename Container>
     Channel<T, Container>::Channel(Self&& source)
       : _read_barrier(std::move(source._read_barrier))
@@ -44,6 +51,44 @@ namespace elle
     {
       ELLE_LOG_COMPONENT("elle.reactor.Channel");
       ELLE_TRACE_SCOPE("%s: put", this);
+      this->_wait_capacity();
+      this->_queue.push(std::move(data));
+      this->_readable();
+      this->_on_put();
+    }
+
+    template <typename T, typename Container>
+    void
+    Channel<T, Container>::put_many(std::vector<T> data)
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.Channel");
+      ELLE_TRACE_SCOPE("%s: put %s elements", this, data.size());
+      auto put = false;
+      for (auto& elt: data)
+      {
+        if (signed(this->_queue.size()) >= this->_max_size && put)
+        {
+          // Let readers drain what we put so far.
+          this->_readable();
+          this->_on_put();
+          put = false;
+        }
+        this->_wait_capacity();
+        this->_queue.push(std::move(elt));
+        put = true;
+      }
+      if (put)
+      {
+        this->_readable();
+        this->_on_put();
+      }
+    }
+
+    template <typename T, typename Container>
+    void
+    Channel<T, Container>::_wait_capacity()
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.Channel");
       if (signed(this->_queue.size()) >= this->_max_size)
       {
         ELLE_DEBUG("at capacity, wait");
@@ -55,13 +100,18 @@ namespace elle
         while (signed(this->_queue.size()) >= this->_max_size);
         ELLE_DEBUG("gained capacity, resume put");
       }
-      this->_queue.push(std::move(data));
+    }
+
+    template <typename T, typename Container>
+    void
+    Channel<T, Container>::_readable()
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.Channel");
       if (this->_opened && !this->_read_barrier.opened())
       {
         ELLE_DEBUG("open");
         this->_read_barrier.open();
       }
-      this->_on_put();
     }
 
     template <typename T, typename Container>
@@ -99,6 +149,42 @@ namespace elle
     {
       ELLE_LOG_COMPONENT("elle.reactor.Channel");
       ELLE_TRACE_SCOPE("%s: get", this);
+      this->_wait_data();
+      T res(std::move(details::queue_front(this->_queue)));
+      this->_queue.pop();
+      ELLE_DEBUG("got data")
+        ELLE_DUMP("value: %s", res);
+      this->_writable();
+      this->_on_get();
+      return res;
+    }
+
+    template <typename T, typename Container>
+    std::vector<T>
+    Channel<T, Container>::get_many(int max)
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.Channel");
+      ELLE_TRACE_SCOPE("%s: get up to %s elements", this, max);
+      ELLE_ASSERT_GT(max, 0);
+      this->_wait_data();
+      auto res = std::vector<T>{};
+      res.reserve(std::min<std::size_t>(max, this->_queue.size()));
+      while (!this->_queue.empty() && signed(res.size()) < max)
+      {
+        res.emplace_back(std::move(details::queue_front(this->_queue)));
+        this->_queue.pop();
+      }
+      ELLE_DEBUG("got %s elements", res.size());
+      this->_writable();
+      this->_on_get();
+      return res;
+    }
+
+    template <typename T, typename Container>
+    void
+    Channel<T, Container>::_wait_data()
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.Channel");
       if (!this->_read_barrier.opened())
       {
         ELLE_TRACE_SCOPE("wait for data");
@@ -109,16 +195,16 @@ namespace elle
       else if (this->_queue.empty() && this->_exception)
         std::rethrow_exception(this->_exception);
       ELLE_ASSERT(!this->_queue.empty());
-      T res(std::move(details::queue_front(this->_queue)));
-      this->_queue.pop();
-      ELLE_DEBUG("got data")
-        ELLE_DUMP("value: %s", res);
+    }
+
+    template <typename T, typename Container>
+    void
+    Channel<T, Container>::_writable()
+    {
       if (this->_queue.empty())
         this->_exhausted();
       if (signed(this->_queue.size()) < this->_max_size)
         this->_write_barrier.open();
-      this->_on_get();
-      return res;
     }
 
     template <typename T, typename Container>
@@ -176,7 +262,7 @@ namespace elle
     Channel<T, Container>::max_size(int ms)
     {
       this->_max_size = ms;
-      if (this->_max_size < signed(this->_queue.size()))
+      if (signed(this->_queue.size()) < this->_max_size)
         this->_write_barrier.open();
       // no need to close, next write will do that
     }
@@ -203,8 +289,8 @@ namespace elle
       ELLE_LOG_COMPONENT("elle.reactor.Channel");
       ELLE_TRACE_SCOPE("%s: clear", *this);
       this->_queue = Container(); // priority_queue has no clear
-      if (this->_max_size < signed(this->_queue.size()))
-        this->_write_barrier.open();
+      // Wake writers waiting for capacity in a bounded Channel.
+      this->_write_barrier.open();
       if (this->_read_barrier.opened())
         this->_exhausted();
     }
@@ -18,7 +18,7 @@ namespace elle
     {
       Buffer::Size read = 0;
       boost::system::error_code error;
-      reactor::Barrier done("read done");
+      reactor::Barrier done("read done"_literal);
       this->_stream.async_read_some(
         boost::asio::buffer(buffer, size),
         [&] (boost::system::error_code const& e, std::size_t s)
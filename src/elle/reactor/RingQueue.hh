@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <elle/assert.hh>
+#include <elle/attribute.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /// A FIFO queue stored in a growable ring buffer.
+    ///
+    /// Provides the subset of the std::queue interface used by Channel, but
+    /// reuses its storage: once grown to the working set, pushing and popping
+    /// never allocate, unlike the std::deque behind std::queue. The capacity
+    /// is a power of two and doubles when full.
+    ///
+    /// @tparam T The type of elements, which must be move constructible.
+    template <typename T>
+    class RingQueue
+    {
+    /*------.
+    | Types |
+    `------*/
+    public:
+      using value_type = T;
+      using size_type = std::size_t;
+      using reference = T&;
+      using const_reference = T const&;
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      RingQueue()
+        : _storage()
+        , _capacity(0)
+        , _head(0)
+        , _size(0)
+      {}
+
+      RingQueue(RingQueue&& source)
+        : _storage(std::move(source._storage))
+        , _capacity(source._capacity)
+        , _head(source._head)
+        , _size(source._size)
+      {
+        source._capacity = source._head = source._size = 0;
+      }
+
+      RingQueue&
+      operator =(RingQueue&& source)
+      {
+        if (this != &source)
+        {
+          this->_clear();
+          this->_storage = std::move(source._storage);
+          this->_capacity = source._capacity;
+          this->_head = source._head;
+          this->_size = source._size;
+          source._capacity = source._head = source._size = 0;
+        }
+        return *this;
+      }
+
+      RingQueue(RingQueue const&) = delete;
+
+      ~RingQueue()
+      {
+        this->_clear();
+      }
+
+    /*--------.
+    | Content |
+    `--------*/
+    public:
+      bool
+      empty() const
+      {
+        return this->_size == 0;
+      }
+
+      size_type
+      size() const
+      {
+        return this->_size;
+      }
+
+      /// Number of elements storable without reallocating.
+      size_type
+      capacity() const
+      {
+        return this->_capacity;
+      }
+
+      reference
+      front()
+      {
+        ELLE_ASSERT(!this->empty());
+        return this->_at(0);
+      }
+
+      const_reference
+      front() const
+      {
+        ELLE_ASSERT(!this->empty());
+        return const_cast<RingQueue&>(*this)._at(0);
+      }
+
+      reference
+      back()
+      {
+        ELLE_ASSERT(!this->empty());
+        return this->_at(this->_size - 1);
+      }
+
+      void
+      push(T const& v)
+      {
+        this->emplace(v);
+      }
+
+      void
+      push(T&& v)
+      {
+        this->emplace(std::move(v));
+      }
+
+      template <typename ... Args>
+      void
+      emplace(Args&& ... args)
+      {
+        if (this->_size == this->_capacity)
+          this->_grow();
+        new (&this->_slot(this->_size)) T(std::forward<Args>(args)...);
+        ++this->_size;
+      }
+
+      void
+      pop()
+      {
+        ELLE_ASSERT(!this->empty());
+        this->_at(0).~T();
+        this->_head = (this->_head + 1) & (this->_capacity - 1);
+        --this->_size;
+      }
+
+    private:
+      using Slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+      /// The @a i-th slot from the head, constructed or not.
+      Slot&
+      _slot(size_type i)
+      {
+        return this->_storage[(this->_head + i) & (this->_capacity - 1)];
+      }
+
+      T&
+      _at(size_type i)
+      {
+        return *reinterpret_cast<T*>(&this->_slot(i));
+      }
+
+      void
+      _grow()
+      {
+        auto const capacity = this->_capacity ? this->_capacity * 2 : 16;
+        auto storage = std::make_unique<Slot[]>(capacity);
+        for (size_type i = 0; i < this->_size; ++i)
+        {
+          new (&storage[i]) T(std::move(this->_at(i)));
+          this->_at(i).~T();
+        }
+        this->_storage = std::move(storage);
+        this->_capacity = capacity;
+        this->_head = 0;
+      }
+
+      void
+      _clear()
+      {
+        while (!this->empty())
+          this->pop();
+      }
+
+      ELLE_ATTRIBUTE(std::unique_ptr<Slot[]>, storage);
+      ELLE_ATTRIBUTE(size_type, capacity);
+      ELLE_ATTRIBUTE(size_type, head);
+      ELLE_ATTRIBUTE(size_type, size);
+    };
+  }
+}
@@ -0,0 +1,325 @@
+#include <deque>
+#include <thread>
+
+#include <elle/assert.hh>
+#include <elle/finally.hh>
+#include <elle/log.hh>
+#include <elle/reactor/SchedulerPool.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/exception.hh>
+#include <elle/reactor/scheduler.hh>
+
+ELLE_LOG_COMPONENT("elle.reactor.SchedulerPool");
+
+namespace elle
+{
+  namespace reactor
+  {
+    /*-------.
+    | Worker |
+    `-------*/
+
+    /// A Scheduler, its system thread and its queue of jobs to start.
+    class SchedulerPool::Worker
+    {
+    public:
+      struct Job
+      {
+        std::string name;
+        Action action;
+      };
+
+      Worker(SchedulerPool& pool, int index)
+        : _scheduler()
+        , _load(0)
+        , _pool(pool)
+        , _index(index)
+        , _mutex()
+        , _jobs()
+        , _stopping(false)
+        , _thread()
+      {
+        this->_thread = std::thread(
+          [this]
+          {
+            // Keep the scheduler alive while there is nothing to run.
+            Thread keeper(this->_scheduler, "keeper", [] { reactor::sleep(); });
+            try
+            {
+              this->_scheduler.run();
+            }
+            catch (...)
+            {
+              ELLE_ERR("%s: scheduler %s failed: %s",
+                       this->_pool, this->_index, elle::exception_string());
+            }
+          });
+      }
+
+      ~Worker()
+      {
+        this->join();
+      }
+
+      void
+      join()
+      {
+        if (this->_thread.joinable())
+          this->_thread.join();
+      }
+
+      /// Queue @a job and wake the scheduler up. Thread-safe.
+      void
+      push(Job job)
+      {
+        auto busy = false;
+        {
+          std::unique_lock<std::mutex> lock(this->_mutex);
+          this->_jobs.emplace_back(std::move(job));
+          busy = ++this->_load > 1;
+        }
+        this->_scheduler.io_service().post([this] { this->_drain(); });
+        // The job may wait behind running ones: let an idle worker steal it
+        // rather than wait for one to finish a job of its own.
+        if (busy)
+          this->_wake_idle();
+      }
+
+      /// Terminate all threads, from any system thread.
+      void
+      stop()
+      {
+        this->_stopping = true;
+        this->_scheduler.io_service().post(
+          [this] { this->_scheduler.terminate(); });
+      }
+
+      /// Take the most recently queued job, for another worker.
+      bool
+      steal(Job& job)
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        if (this->_jobs.empty())
+          return false;
+        job = std::move(this->_jobs.back());
+        this->_jobs.pop_back();
+        --this->_load;
+        return true;
+      }
+
+      ELLE_ATTRIBUTE_X(Scheduler, scheduler);
+      ELLE_ATTRIBUTE_R(std::atomic<int>, load);
+
+    private:
+      bool
+      _pop(Job& job)
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        if (this->_jobs.empty())
+          return false;
+        job = std::move(this->_jobs.front());
+        this->_jobs.pop_front();
+        return true;
+      }
+
+      /// Steal one job from the other workers, if idle.
+      bool
+      _steal(Job& job)
+      {
+        if (this->_load != 0)
+          return false;
+        auto const size = this->_pool.size();
+        for (int i = 1; i < size; ++i)
+        {
+          auto& victim = *this->_pool._workers[(this->_index + i) % size];
+          if (victim.steal(job))
+          {
+            ++this->_load;
+            ++this->_pool._stolen;
+            ELLE_DEBUG("%s: scheduler %s stole %s from scheduler %s",
+                       this->_pool, this->_index, job.name, victim._index);
+            return true;
+          }
+        }
+        return false;
+      }
+
+      /// Have one idle worker, if any, look for jobs to steal. Thread-safe.
+      void
+      _wake_idle()
+      {
+        auto const size = this->_pool.size();
+        for (int i = 1; i < size; ++i)
+        {
+          auto& worker = *this->_pool._workers[(this->_index + i) % size];
+          if (worker._load == 0)
+          {
+            worker._scheduler.io_service().post(
+              [&worker] { worker._drain(); });
+            return;
+          }
+        }
+      }
+
+      /// Start queued jobs, or a stolen one. Run in the scheduler thread.
+      void
+      _drain()
+      {
+        auto job = Job{};
+        while (!this->_stopping && (this->_pop(job) || this->_steal(job)))
+          this->_start(std::move(job));
+      }
+
+      void
+      _start(Job job)
+      {
+        ELLE_DEBUG("%s: scheduler %s starts %s",
+                   this->_pool, this->_index, job.name);
+        new Thread(
+          this->_scheduler, job.name,
+          [this, action = std::move(job.action)]
+          {
+            auto e = std::exception_ptr{};
+            elle::SafeFinally done(
+              [&]
+              {
+                --this->_load;
+                this->_pool._done(e);
+                this->_drain();
+              });
+            try
+            {
+              action();
+            }
+            catch (Terminate const&)
+            {
+              throw;
+            }
+            catch (...)
+            {
+              e = std::current_exception();
+            }
+          },
+          true);
+      }
+
+      ELLE_ATTRIBUTE(SchedulerPool&, pool);
+      ELLE_ATTRIBUTE(int, index);
+      ELLE_ATTRIBUTE(std::mutex, mutex);
+      ELLE_ATTRIBUTE(std::deque<Job>, jobs);
+      ELLE_ATTRIBUTE(std::atomic<bool>, stopping);
+      ELLE_ATTRIBUTE(std::thread, thread);
+    };
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    SchedulerPool::SchedulerPool(int size)
+      : _workers()
+      , _next(0)
+      , _stolen(0)
+      , _pending(0)
+      , _exception()
+    {
+      if (size <= 0)
+        size = std::max(1u, std::thread::hardware_concurrency());
+      ELLE_TRACE_SCOPE("%s: start %s schedulers", this, size);
+      for (int i = 0; i < size; ++i)
+        this->_workers.emplace_back(std::make_unique<Worker>(*this, i));
+    }
+
+    SchedulerPool::~SchedulerPool()
+    {
+      ELLE_TRACE_SCOPE("%s: stop", this);
+      for (auto& worker: this->_workers)
+        worker->stop();
+      // Join every system thread before destroying any scheduler, as jobs may
+      // still reach other workers' queues.
+      for (auto& worker: this->_workers)
+        worker->join();
+    }
+
+    /*-----------.
+    | Schedulers |
+    `-----------*/
+
+    int
+    SchedulerPool::size() const
+    {
+      return this->_workers.size();
+    }
+
+    Scheduler&
+    SchedulerPool::scheduler(int i)
+    {
+      ELLE_ASSERT_LT(i, this->size());
+      return this->_workers[i]->scheduler();
+    }
+
+    /*-----.
+    | Jobs |
+    `-----*/
+
+    void
+    SchedulerPool::spawn(std::string name, Action action)
+    {
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        ++this->_pending;
+      }
+      // Pick the least loaded worker, starting from a rotating index so ties
+      // do not always favor the first ones.
+      auto const size = this->size();
+      auto const first = static_cast<int>(this->_next++ % size);
+      auto* target = this->_workers[first].get();
+      for (int i = 1; i < size && target->load() != 0; ++i)
+      {
+        auto* w = this->_workers[(first + i) % size].get();
+        if (w->load() < target->load())
+          target = w;
+      }
+      target->push(Worker::Job{std::move(name), std::move(action)});
+    }
+
+    void
+    SchedulerPool::wait()
+    {
+      ELLE_TRACE_SCOPE("%s: wait for jobs", this);
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_idle.wait(lock, [this] { return this->_pending == 0; });
+      if (this->_exception)
+      {
+        auto e = std::move(this->_exception);
+        this->_exception = nullptr;
+        std::rethrow_exception(e);
+      }
+    }
+
+    int
+    SchedulerPool::stolen() const
+    {
+      return this->_stolen;
+    }
+
+    void
+    SchedulerPool::_done(std::exception_ptr e)
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      if (e && !this->_exception)
+        this->_exception = e;
+      if (--this->_pending == 0)
+        this->_idle.notify_all();
+    }
+
+    /*----------.
+    | Printable |
+    `----------*/
+
+    void
+    SchedulerPool::print(std::ostream& s) const
+    {
+      s << "SchedulerPool(" << this->size() << ")";
+    }
+  }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <elle/Printable.hh>
+#include <elle/attribute.hh>
+#include <elle/reactor/fwd.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /// A pool of Schedulers, each one running in its own system thread.
+    ///
+    /// A Scheduler runs all its Threads in the system thread that invoked
+    /// Scheduler::run, and thus uses at most one core. A SchedulerPool runs
+    /// one Scheduler per core and spreads jobs among them: a job is queued on
+    /// the least loaded Scheduler, and idle Schedulers steal jobs that did not
+    /// start yet from the queue of busy ones, whenever they finish a job or
+    /// one is queued behind others.
+    ///
+    /// Once started, a job is a regular Thread of the Scheduler that picked it
+    /// and never migrates. Synchronization primitives (Barrier, Mutex,
+    /// Channel, ...) are not thread-safe: they may only be shared by Threads
+    /// of the same Scheduler. Jobs running on different Schedulers communicate
+    /// through Scheduler::mt_run.
+    ///
+    /// @code{.cc}
+    ///
+    /// auto pool = reactor::SchedulerPool{};
+    /// for (auto& peer: peers)
+    ///   pool.spawn("serve", [&peer] { serve(peer); });
+    /// // Block until every job is over.
+    /// pool.wait();
+    ///
+    /// @endcode
+    class SchedulerPool
+      : public elle::Printable
+    {
+    public:
+      using Action = std::function<void ()>;
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Start a pool of Schedulers.
+      ///
+      /// @param size The number of Schedulers, and thus system threads. Zero
+      ///             means one per core.
+      SchedulerPool(int size = 0);
+      /// Terminate all jobs and join all system threads.
+      ~SchedulerPool();
+
+    /*-----------.
+    | Schedulers |
+    `-----------*/
+    public:
+      /// The number of Schedulers.
+      int
+      size() const;
+      /// The @a i-th Scheduler.
+      ///
+      /// @param i The index of the Scheduler, lower than size().
+      /// @returns The Scheduler.
+      Scheduler&
+      scheduler(int i);
+
+    /*-----.
+    | Jobs |
+    `-----*/
+    public:
+      /// Run @a action in a new Thread of the least loaded Scheduler.
+      ///
+      /// Thread-safe: may be called from any system thread, including from
+      /// jobs of this pool.
+      ///
+      /// @param name   A descriptive name of the Thread.
+      /// @param action The function to run.
+      void
+      spawn(std::string name, Action action);
+      /// Block the calling system thread until all jobs are over.
+      ///
+      /// Must not be called from a job of this pool.
+      ///
+      /// @throws The first exception that escaped from a job, if any.
+      void
+      wait();
+      /// Number of jobs started by another Scheduler than the one they were
+      /// queued on.
+      int
+      stolen() const;
+    private:
+      class Worker;
+      friend class Worker;
+      void
+      _done(std::exception_ptr e);
+      ELLE_ATTRIBUTE(std::vector<std::unique_ptr<Worker>>, workers);
+      ELLE_ATTRIBUTE(std::atomic<unsigned>, next);
+      ELLE_ATTRIBUTE(std::atomic<int>, stolen);
+      ELLE_ATTRIBUTE(std::mutex, mutex);
+      ELLE_ATTRIBUTE(std::condition_variable, idle);
+      ELLE_ATTRIBUTE(int, pending);
+      ELLE_ATTRIBUTE(std::exception_ptr, exception);
+
+    /*----------.
+    | Printable |
+    `----------*/
+    public:
+      void
+      print(std::ostream& s) const override;
+    };
+  }
+}
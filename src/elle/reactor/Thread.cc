@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <elle/finally.hh>
 #include <elle/log.hh>
 #include <elle/optional.hh>
@@ -26,17 +28,30 @@ namespace elle
                    std::string const& name,
                    Action action,
                    bool dispose)
-      : _dispose(dispose)
-      , _managed(false)
+      : Thread(scheduler, name, std::move(action), Options{dispose, false, 0})
+    {}
+
+    Thread::Thread(Scheduler& scheduler,
+                   std::string const& name,
+                   Action action,
+                   Options const& options)
+      : _dispose(options.dispose)
+      , _managed(options.managed)
       , _state(State::running)
+      , _statistics()
+      , _runnable_since(std::chrono::steady_clock::now())
+      , _starting_batch(0)
       , _injection()
       , _exception()
       , _waited()
+      , _waiter_nodes()
+      , _waiter_nodes_used(0)
       , _timeout(false)
-      , _timeout_timer(scheduler.io_service())
+      , _timeout_timer()
       , _thread(scheduler._manager->make_thread(
                   name,
-                  [this, a=std::move(action)] { this->_action_wrapper(a); }))
+                  [this, a=std::move(action)] { this->_action_wrapper(a); },
+                  options.stack_size))
       , _scheduler(scheduler)
       , _terminating(false)
       , _interruptible(true)
@@ -298,8 +313,12 @@ namespace elle
     bool
     Thread::wait(Waitable& s, DurationOpt timeout)
     {
-      Waitables waitables(1, &s);
-      return wait(waitables, timeout);
+#ifndef INFINIT_IOS
+      ELLE_TRACE_SCOPE("%s: wait %s%s", *this, s,
+                       timeout ? elle::sprintf(" for %s", timeout) : "");
+#endif
+      auto waitable = &s;
+      return this->_wait_for(&waitable, &waitable + 1, timeout);
     }
 
     bool
@@ -309,20 +328,31 @@ namespace elle
       ELLE_TRACE_SCOPE("%s: wait %s%s", *this, waitables,
                        timeout ? elle::sprintf(" for %s", timeout) : "");
 #endif
+      return this->_wait_for(waitables.data(),
+                             waitables.data() + waitables.size(),
+                             timeout);
+    }
+
+    bool
+    Thread::_wait_for(Waitable* const* begin,
+                      Waitable* const* end,
+                      DurationOpt timeout)
+    {
       ELLE_ASSERT_EQ(_state, State::running);
       ELLE_ASSERT(_waited.empty());
       bool freeze = false;
-      for (Waitable* s: waitables)
-        if (s->_wait(this, Waker()))
+      for (auto it = begin; it != end; ++it)
+        if ((*it)->_wait(this, Waker()))
         {
           freeze = true;
-          _waited.insert(s);
+          _waited.emplace_back(*it);
         }
-        else if (s->_exception)
+        else if ((*it)->_exception)
         {
+          auto s = *it;
           for (Waitable* waitable: this->_waited)
             waitable->_unwait(this);
-          ELLE_ASSERT(this->_waited.empty());
+          this->_waited.clear();
           try
           {
             std::rethrow_exception(s->_exception);
@@ -341,14 +371,12 @@ namespace elle
       {
         if (timeout)
         {
-          this->_timeout_timer.expires_from_now(timeout.get());
           this->_timeout = false;
-          auto repr = elle::sprintf("%s", waitables);
-          this->_timeout_timer.async_wait(
-            [this, repr]
-            (boost::system::error_code const& e)
+          this->_scheduler.timers().arm(
+            this->_timeout_timer, timeout.get(),
+            [this]
             {
-              this->_wait_timeout(e, repr);
+              this->_wait_timeout();
             });
           auto cancel_timeout = [this]
             {
@@ -394,34 +422,9 @@ namespace elle
         return Waitable::_wait(thread, waker);
     }
 
-    static
-    std::ostream&
-    operator <<(std::ostream& output, std::set<Waitable*> waitables)
-    {
-      if (waitables.size() == 1)
-        output << **waitables.begin();
-      else
-      {
-        bool first = true;
-        for (auto const& waitable: waitables)
-        {
-          if (first)
-            first = false;
-          else
-            output << ", ";
-          output << *waitable;
-        }
-        output << "}";
-      }
-      return output;
-    }
-
     void
-    Thread::_wait_timeout(boost::system::error_code const& e,
-                          std::string const& waited)
+    Thread::_wait_timeout()
     {
-      if (e == boost::system::errc::operation_canceled)
-        return;
       // If we're not frozen anymore, the task must have ended in the same asio
       // poll than the timeout: Thread::_wake was just called. Ignore the timeout.
       if (state() != State::frozen)
@@ -432,8 +435,8 @@ namespace elle
       if (this->_waited.size() == 1 &&
           dynamic_cast<elle::reactor::http::Request*>(*this->_waited.begin()))
         ELLE_WARN("DEBUG: timeout on HTTP request: %s", this->_waited);
-      this->_wait_abort(elle::sprintf("wait timeout for %s (waiting %s)",
-                                      waited, this->_waited));
+      this->_wait_abort(elle::sprintf("wait timeout (waiting %s)",
+                                      this->_waited));
     }
 
     void
@@ -468,12 +471,18 @@ namespace elle
           ELLE_TRACE("%s: forward exception", *this);
           this->_exception = waitable->_exception;
         }
-        this->_waited.erase(waitable);
+        auto it =
+          std::find(this->_waited.begin(), this->_waited.end(), waitable);
+        if (it != this->_waited.end())
+          this->_waited.erase(it);
         if (this->_waited.empty())
         {
           ELLE_TRACE("%s: nothing to wait on, waking up", *this);
+          // Only format the reason if anyone listens.
           this->_scheduler._unfreeze(
-            *this, elle::sprintf("wait for %s ended", *waitable));
+            *this,
+            this->_unfrozen.empty() ?
+            std::string() : elle::sprintf("wait for %s ended", *waitable));
           this->_state = State::running;
         }
         else
@@ -482,6 +491,45 @@ namespace elle
       }
     }
 
+    Waitable::Waiter&
+    Thread::_waiter_acquire(Waitable& waitable, Waker const& waker)
+    {
+      if (this->_waiter_nodes_used == this->_waiter_nodes.size())
+        this->_waiter_nodes.emplace_back(
+          std::make_unique<Waitable::Waiter>(this));
+      auto& res = *this->_waiter_nodes[this->_waiter_nodes_used++];
+      res._waitable = &waitable;
+      res._waker = waker;
+      return res;
+    }
+
+    void
+    Thread::_waiter_release(Waitable::Waiter& waiter)
+    {
+      ELLE_ASSERT(!waiter.is_linked());
+      auto const used = this->_waiter_nodes.begin() + this->_waiter_nodes_used;
+      auto it = std::find_if(
+        this->_waiter_nodes.begin(), used,
+        [&] (std::unique_ptr<Waitable::Waiter> const& w)
+        {
+          return w.get() == &waiter;
+        });
+      ELLE_ASSERT(it != used);
+      waiter._waitable = nullptr;
+      waiter._waker = nullptr;
+      std::iter_swap(it, used - 1);
+      --this->_waiter_nodes_used;
+    }
+
+    Waitable::Waiter*
+    Thread::_waiter_find(Waitable const& waitable)
+    {
+      for (std::size_t i = 0; i < this->_waiter_nodes_used; ++i)
+        if (this->_waiter_nodes[i]->_waitable == &waitable)
+          return this->_waiter_nodes[i].get();
+      return nullptr;
+    }
+
     /*--------.
     | Backend |
     `--------*/
@@ -12,6 +12,7 @@
 #include <elle/reactor/duration.hh>
 #include <elle/reactor/fwd.hh>
 #include <elle/reactor/signals.hh>
+#include <elle/reactor/TimerWheel.hh>
 #include <elle/reactor/Waitable.hh>
 
 namespace elle
@@ -22,6 +23,7 @@ namespace elle
 
     ELLE_DAS_SYMBOL(dispose);
     ELLE_DAS_SYMBOL(managed);
+    ELLE_DAS_SYMBOL(stack_size);
 
     /// Thread represent a coroutine in a Scheduler environment.
     ///
@@ -65,8 +67,9 @@ namespace elle
     /// }
     ///
     /// @endcode
-    class Thread:
-      public Waitable
+    class Thread
+      : public Waitable
+      , public ThreadQueueHook
     {
     /*------.
     | Types |
@@ -124,11 +127,26 @@ namespace elle
       /// @param scheduler The Scheduler in charge of the Thread.
       /// @param name A descriptive name of Thread to be spawn.
       /// @param action The action to execute.
-      /// @param args The named arguments `dispose` and `managed`.
+      /// @param args The named arguments `dispose`, `managed` and
+      ///             `stack_size`, the latter in bytes, 0 meaning the
+      ///             backend default.
+      /// @throw elle::Error if `stack_size` exceeds the backend maximum.
       template <typename ... Args>
       Thread(const std::string& name,
              Action action,
              Args&& ... args);
+    private:
+      struct Options
+      {
+        bool dispose;
+        bool managed;
+        std::size_t stack_size;
+      };
+      Thread(Scheduler& scheduler,
+             const std::string& name,
+             Action action,
+             Options const& options);
+    public:
 
       /// Create a Thread.
       ///
@@ -208,6 +226,35 @@ namespace elle
       /// Pretty name.
       ELLE_ATTRIBUTE_rw(std::string, name);
 
+    /*-----------.
+    | Statistics |
+    `-----------*/
+    public:
+      /// Scheduling activity of a Thread, maintained by its Scheduler.
+      struct Statistics
+      {
+        /// Number of times the Thread was stepped.
+        std::size_t steps = 0;
+        /// Steps ending with the Thread still runnable.
+        std::size_t yields = 0;
+        /// Steps ending with the Thread frozen.
+        std::size_t freezes = 0;
+        /// Wall-clock time spent running, including blocking system calls.
+        Duration run_time;
+        /// CPU time spent running, excluding blocking system calls.
+        Duration cpu_time;
+        /// Time spent runnable, waiting for its turn.
+        Duration runnable_time;
+        /// Longest single step.
+        Duration longest_step;
+      };
+      ELLE_ATTRIBUTE_R(Statistics, statistics);
+    private:
+      /// When the Thread last became runnable.
+      ELLE_ATTRIBUTE(std::chrono::steady_clock::time_point, runnable_since);
+      /// The Scheduler starting batch the Thread was queued in.
+      ELLE_ATTRIBUTE(std::size_t, starting_batch);
+
     /*----------.
     | Printable |
     `----------*/
@@ -300,18 +347,34 @@ namespace elle
       friend class Scope;
       friend class TimeoutGuard;
       friend class Waitable;
+      bool
+      _wait_for(Waitable* const* begin,
+                Waitable* const* end,
+                DurationOpt timeout);
       void
-      _wait_timeout(const boost::system::error_code& e,
-                    std::string const& waited);
+      _wait_timeout();
       void
       _wait_abort(std::string const& reason);
       void
       _freeze();
       void
       _wake(Waitable* waitable);
-      ELLE_ATTRIBUTE_R(std::set<Waitable*>, waited);
+      /// A free Waiter for this thread to wait for @a waitable.
+      Waitable::Waiter&
+      _waiter_acquire(Waitable& waitable, Waker const& waker);
+      /// Give back a Waiter, unlinked from its Waitable.
+      void
+      _waiter_release(Waitable::Waiter& waiter);
+      /// The Waiter of this thread for @a waitable, if waiting for it.
+      Waitable::Waiter*
+      _waiter_find(Waitable const& waitable);
+      ELLE_ATTRIBUTE_R(Waitables, waited);
+      /// Waiters owned by this thread, the ones in use first.
+      ELLE_ATTRIBUTE(std::vector<std::unique_ptr<Waitable::Waiter>>,
+                     waiter_nodes);
+      ELLE_ATTRIBUTE(std::size_t, waiter_nodes_used);
       ELLE_ATTRIBUTE(bool, timeout);
-      ELLE_ATTRIBUTE(boost::asio::deadline_timer, timeout_timer);
+      ELLE_ATTRIBUTE(TimerWheel::Entry, timeout_timer);
 
     /*------.
     | Hooks |
@@ -432,6 +495,10 @@ namespace elle
           const std::string& name,
           const std::function<void ()>& op,
           bool dispose = false);
+
+    /// The current scheduler.
+    reactor::Scheduler&
+    scheduler();
   }
 }
 
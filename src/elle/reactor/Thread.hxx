@@ -12,16 +12,15 @@ namespace elle
     Thread::Thread(std::string const& name,
                    Action action,
                    Args&& ... args)
-      : Thread(name, std::move(action))
-    {
-      elle::das::named::prototype(reactor::dispose = false,
-                                  reactor::managed = false)
-        .call([&] (bool dispose, bool managed)
-              {
-                this->_dispose = dispose;
-                this->_managed = managed;
-              }, std::forward<Args>(args)...);
-    }
+      : Thread(reactor::scheduler(), name, std::move(action),
+               elle::das::named::prototype(reactor::dispose = false,
+                                           reactor::managed = false,
+                                           reactor::stack_size = 0)
+               .call([] (bool dispose, bool managed, std::size_t stack_size)
+                     {
+                       return Options{dispose, managed, stack_size};
+                     }, std::forward<Args>(args)...))
+    {}
 
     template <typename R>
     static
@@ -10,19 +10,15 @@ namespace elle
 
     TimeoutGuard::TimeoutGuard(reactor::Duration delay)
       : _delay(delay)
-      , _timer(reactor::scheduler().io_service(), delay)
+      , _timer()
     {
       ELLE_TRACE_SCOPE("%s: start", *this);
       auto current = reactor::scheduler().current();
       auto timeout_msg = elle::sprintf("%s: timeout %s", *this, *current);
-      this->_timer.async_wait(
+      reactor::scheduler().timers().arm(
+        this->_timer, delay,
         [delay, current, timeout_msg]
-        (boost::system::error_code const& e)
         {
-          if (e == boost::system::errc::operation_canceled)
-            return;
-          if (e)
-            ELLE_ABORT("unexpected timer error: %s", e);
           ELLE_TRACE_SCOPE("%s", timeout_msg);
           current->raise<reactor::Timeout>(delay);
           if (current->state() == Thread::State::frozen)
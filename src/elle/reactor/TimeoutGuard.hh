@@ -1,9 +1,8 @@
 #pragma once
 
-#include <boost/asio/deadline_timer.hpp>
-
 #include <elle/Printable.hh>
 #include <elle/attribute.hh>
+#include <elle/reactor/TimerWheel.hh>
 #include <elle/reactor/duration.hh>
 
 namespace elle
@@ -41,7 +40,7 @@ namespace elle
       print(std::ostream& output) const override;
 
     private:
-      ELLE_ATTRIBUTE(boost::asio::deadline_timer, timer);
+      ELLE_ATTRIBUTE(TimerWheel::Entry, timer);
     };
   }
 }
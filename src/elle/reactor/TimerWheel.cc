@@ -0,0 +1,283 @@
+#include <algorithm>
+
+#include <elle/assert.hh>
+#include <elle/log.hh>
+#include <elle/printf.hh>
+#include <elle/reactor/TimerWheel.hh>
+
+ELLE_LOG_COMPONENT("elle.reactor.TimerWheel");
+
+namespace elle
+{
+  namespace reactor
+  {
+    /*------.
+    | Entry |
+    `------*/
+
+    TimerWheel::Entry::Entry()
+      : _wheel(nullptr)
+      , _tick(0)
+      , _expiring(false)
+      , _callback()
+    {}
+
+    TimerWheel::Entry::~Entry()
+    {
+      this->cancel();
+    }
+
+    bool
+    TimerWheel::Entry::armed() const
+    {
+      return this->is_linked();
+    }
+
+    void
+    TimerWheel::Entry::cancel()
+    {
+      if (this->is_linked())
+        this->_wheel->_cancel(*this);
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    TimerWheel::TimerWheel(boost::asio::io_service& service,
+                           Duration resolution,
+                           int slots)
+      : _resolution(resolution)
+      , _size(0)
+      , _tick_duration(
+        std::max<Clock::duration>(
+          std::chrono::microseconds(resolution.total_microseconds()),
+          std::chrono::microseconds(1)))
+      , _origin(Clock::now())
+      , _current(0)
+      , _slots(std::max(slots, 1))
+      , _occupied((this->_slots.size() + 63) / 64)
+      , _due()
+      , _service(service)
+      , _timer(service)
+      , _scheduled(0)
+      , _generation(0)
+      , _firing(false)
+    {}
+
+    TimerWheel::~TimerWheel()
+    {
+      for (auto& slot: this->_slots)
+        slot.clear();
+      this->_due.clear();
+    }
+
+    /*--------.
+    | Entries |
+    `--------*/
+
+    void
+    TimerWheel::arm(Entry& entry, Duration delay, Callback callback)
+    {
+      entry.cancel();
+      if (delay.is_pos_infinity())
+        return;
+      if (delay.total_microseconds() <= 0)
+      {
+        // Don't wait for the next tick, so a null sleep remains a yield.
+        entry._wheel = this;
+        entry._expiring = true;
+        entry._callback = std::move(callback);
+        this->_due.push_back(entry);
+        ++this->_size;
+        if (!this->_firing)
+        {
+          this->_firing = true;
+          this->_service.post(
+            [this]
+            {
+              this->_firing = false;
+              this->_fire();
+            });
+        }
+        return;
+      }
+      auto const now = Clock::now();
+      // Nothing may be due on an idle wheel: skip the ticks it slept through
+      // so the next expiration does not catch up on empty slots.
+      if (this->_size == 0)
+        this->_current = std::max(this->_current, this->_tick(now));
+      auto const deadline =
+        now + std::chrono::microseconds(delay.total_microseconds());
+      // Round up, and never in a slot that was already expired.
+      auto const tick = std::max(this->_tick(deadline - Clock::duration(1)) + 1,
+                                 this->_current + 1);
+      entry._wheel = this;
+      entry._tick = tick;
+      entry._expiring = false;
+      entry._callback = std::move(callback);
+      auto const index = tick % this->_slots.size();
+      this->_slots[index].push_back(entry);
+      this->_occupy(index, true);
+      ++this->_size;
+      if (this->_scheduled == 0 || tick < this->_scheduled)
+        this->_schedule();
+    }
+
+    void
+    TimerWheel::_cancel(Entry& entry)
+    {
+      if (entry._expiring)
+        this->_due.erase(this->_due.iterator_to(entry));
+      else
+      {
+        auto const index = entry._tick % this->_slots.size();
+        auto& slot = this->_slots[index];
+        slot.erase(slot.iterator_to(entry));
+        if (slot.empty())
+          this->_occupy(index, false);
+      }
+      entry._callback = nullptr;
+      // Leave no pending asio wait behind, which would hold the io_service.
+      if (--this->_size == 0)
+        this->_schedule();
+    }
+
+    std::uint64_t
+    TimerWheel::_tick(Clock::time_point time) const
+    {
+      if (time <= this->_origin)
+        return 0;
+      return (time - this->_origin) / this->_tick_duration;
+    }
+
+    void
+    TimerWheel::_schedule()
+    {
+      // The first non-empty slot's entries may belong to a later revolution:
+      // the wheel then wakes up for nothing, once per revolution.
+      auto const next = this->_size == 0 ? 0 : this->_next();
+      if (next == 0)
+      {
+        if (this->_scheduled != 0)
+        {
+          this->_scheduled = 0;
+          ++this->_generation;
+          this->_timer.cancel();
+        }
+        return;
+      }
+      if (next == this->_scheduled)
+        return;
+      this->_scheduled = next;
+      auto const generation = ++this->_generation;
+      this->_timer.expires_at(this->_origin + next * this->_tick_duration);
+      this->_timer.async_wait(
+        [this, generation] (boost::system::error_code const& e)
+        {
+          if (e == boost::asio::error::operation_aborted)
+            return;
+          if (generation != this->_generation)
+            return;
+          if (e)
+            ELLE_ABORT("unexpected timer error: %s", e.message());
+          this->_scheduled = 0;
+          this->_expire();
+          this->_schedule();
+        });
+    }
+
+    std::uint64_t
+    TimerWheel::_next() const
+    {
+      // Scan the bitmap a word at a time, from the slot following the current
+      // tick around the ring, back to the start word for the slots before it.
+      auto const count = this->_slots.size();
+      auto const words = this->_occupied.size();
+      auto const start = (this->_current + 1) % count;
+      auto word = start / 64;
+      auto bits = this->_occupied[word] & (~std::uint64_t(0) << (start % 64));
+      for (auto i = std::size_t{0}; i <= words; ++i)
+      {
+        if (bits)
+        {
+          auto const index = word * 64 + __builtin_ctzll(bits);
+          return this->_current + 1 + (index + count - start) % count;
+        }
+        word = (word + 1) % words;
+        bits = this->_occupied[word];
+      }
+      return 0;
+    }
+
+    void
+    TimerWheel::_occupy(std::size_t index, bool occupied)
+    {
+      auto const bit = std::uint64_t(1) << (index % 64);
+      if (occupied)
+        this->_occupied[index / 64] |= bit;
+      else
+        this->_occupied[index / 64] &= ~bit;
+    }
+
+    void
+    TimerWheel::_expire()
+    {
+      auto const now = this->_tick(Clock::now());
+      if (now <= this->_current)
+        return;
+      auto const count = this->_slots.size();
+      auto const last = std::min(now, this->_current + count);
+      for (auto tick = this->_current + 1; tick <= last; ++tick)
+      {
+        auto const index = tick % count;
+        auto& slot = this->_slots[index];
+        for (auto it = slot.begin(); it != slot.end();)
+        {
+          auto& entry = *it;
+          if (entry._tick <= now)
+          {
+            it = slot.erase(it);
+            entry._expiring = true;
+            this->_due.push_back(entry);
+          }
+          else
+            ++it;
+        }
+        if (slot.empty())
+          this->_occupy(index, false);
+      }
+      this->_current = now;
+      ELLE_DUMP("%s: expire %s entries at tick %s",
+                *this, this->_due.size(), now);
+      this->_fire();
+    }
+
+    void
+    TimerWheel::_fire()
+    {
+      // Callbacks may arm or cancel any entry, including due ones.
+      while (!this->_due.empty())
+      {
+        auto& entry = this->_due.front();
+        this->_due.pop_front();
+        entry._expiring = false;
+        --this->_size;
+        auto callback = std::move(entry._callback);
+        entry._callback = nullptr;
+        callback();
+      }
+    }
+
+    /*----------.
+    | Printable |
+    `----------*/
+
+    void
+    TimerWheel::print(std::ostream& stream) const
+    {
+      elle::fprintf(stream, "TimerWheel(%s, %s entries)",
+                    this->_resolution, this->_size);
+    }
+  }
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <boost/intrusive/list.hpp>
+
+#include <elle/Printable.hh>
+#include <elle/attribute.hh>
+#include <elle/reactor/asio.hh>
+#include <elle/reactor/duration.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    /// A hashed timing wheel, driving many timeouts with a single asio timer.
+    ///
+    /// Time is cut into ticks of a fixed resolution, and timeouts are hashed
+    /// by expiration tick into a ring of slots. Arming and canceling a timeout
+    /// are O(1) and never touch the io_service: only the earliest non-empty
+    /// slot, found through an occupancy bitmap, is waited for, with one asio
+    /// timer. Timeouts expire on a tick
+    /// boundary, thus up to one resolution late, never early. Null timeouts
+    /// are the exception: they expire right away, from the io_service.
+    ///
+    /// The wheel is owned by the Scheduler, which routes Sleep, wait timeouts,
+    /// TimeoutGuard and Timer through it. It is not thread-safe: entries must
+    /// be armed and canceled from the scheduler's system thread.
+    ///
+    /// @code{.cc}
+    ///
+    /// auto entry = reactor::TimerWheel::Entry{};
+    /// reactor::scheduler().timers().arm(entry, 30_sec, [&] { ping(); });
+    /// // Canceled on destruction, or explicitly:
+    /// entry.cancel();
+    ///
+    /// @endcode
+    class TimerWheel
+      : public elle::Printable
+    {
+    public:
+      using Callback = std::function<void ()>;
+      using Clock = std::chrono::steady_clock;
+    private:
+      using Hook = boost::intrusive::list_base_hook<>;
+    public:
+      /// A timeout that may be armed in a TimerWheel.
+      ///
+      /// The callback is invoked from the io_service, outside of any Thread,
+      /// like an asio completion handler.
+      class Entry
+        : public Hook
+      {
+      public:
+        Entry();
+        Entry(Entry const&) = delete;
+        /// Cancel the entry if armed.
+        ~Entry();
+        /// Whether the entry is waiting to expire.
+        bool
+        armed() const;
+        /// Disarm the entry, without invoking its callback. No-op if not
+        /// armed.
+        void
+        cancel();
+      private:
+        friend class TimerWheel;
+        ELLE_ATTRIBUTE(TimerWheel*, wheel);
+        ELLE_ATTRIBUTE(std::uint64_t, tick);
+        /// Whether the entry moved from its slot to the due list.
+        ELLE_ATTRIBUTE(bool, expiring);
+        ELLE_ATTRIBUTE(Callback, callback);
+      };
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Construct a TimerWheel.
+      ///
+      /// @param service    The io_service to run callbacks in. It must not run
+      ///                   once the wheel is destroyed.
+      /// @param resolution The duration of a tick.
+      /// @param slots      The number of slots of the ring.
+      TimerWheel(boost::asio::io_service& service,
+                 Duration resolution = boost::posix_time::milliseconds(1),
+                 int slots = 4096);
+      ~TimerWheel();
+      ELLE_ATTRIBUTE_R(Duration, resolution);
+
+    /*--------.
+    | Entries |
+    `--------*/
+    public:
+      /// Invoke @a callback after @a delay, rounded up to the resolution.
+      ///
+      /// Null or negative delays expire as soon as the io_service runs, without
+      /// waiting for the next tick. Rearms @a entry if already armed, dropping
+      /// its previous callback.
+      ///
+      /// @param entry    The entry to link, which must outlive its expiration
+      ///                 or be canceled.
+      /// @param delay    The delay. Infinite delays never expire.
+      /// @param callback The function to invoke on expiration.
+      void
+      arm(Entry& entry, Duration delay, Callback callback);
+      /// Number of armed entries.
+      ELLE_ATTRIBUTE_R(std::size_t, size);
+    private:
+      using Slot = boost::intrusive::list<
+        Entry,
+        boost::intrusive::base_hook<Hook>,
+        boost::intrusive::constant_time_size<false>>;
+      void
+      _cancel(Entry& entry);
+      /// The tick containing @a time.
+      std::uint64_t
+      _tick(Clock::time_point time) const;
+      /// Wait for the earliest non-empty slot, if any.
+      void
+      _schedule();
+      /// The tick of the earliest non-empty slot, zero if all are empty.
+      std::uint64_t
+      _next() const;
+      /// Mark slot @a index as holding entries or not.
+      void
+      _occupy(std::size_t index, bool occupied);
+      /// Expire all entries due at the current time.
+      void
+      _expire();
+      /// Invoke the callbacks of due entries.
+      void
+      _fire();
+      ELLE_ATTRIBUTE(Clock::duration, tick_duration);
+      ELLE_ATTRIBUTE(Clock::time_point, origin);
+      /// Last expired tick.
+      ELLE_ATTRIBUTE(std::uint64_t, current);
+      ELLE_ATTRIBUTE(std::vector<Slot>, slots);
+      /// One bit per slot, set if it holds entries, to find the earliest
+      /// without visiting every slot.
+      ELLE_ATTRIBUTE(std::vector<std::uint64_t>, occupied);
+      /// Entries being expired, whose callbacks are yet to be invoked.
+      ELLE_ATTRIBUTE(Slot, due);
+      ELLE_ATTRIBUTE(boost::asio::io_service&, service);
+      ELLE_ATTRIBUTE(boost::asio::steady_timer, timer);
+      /// Tick the asio timer waits for, zero if idle.
+      ELLE_ATTRIBUTE(std::uint64_t, scheduled);
+      /// Discards completion of superseded asio waits.
+      ELLE_ATTRIBUTE(std::uint64_t, generation);
+      /// Whether firing due entries is posted to the io_service.
+      ELLE_ATTRIBUTE(bool, firing);
+
+    /*----------.
+    | Printable |
+    `----------*/
+    public:
+      void
+      print(std::ostream& stream) const override;
+    };
+  }
+}
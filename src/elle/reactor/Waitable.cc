@@ -16,21 +16,56 @@ namespace elle
 {
   namespace reactor
   {
+    /*-------.
+    | Waiter |
+    `-------*/
+
+    Waitable::Waiter::Waiter(Thread* thread)
+      : _thread(thread)
+      , _waitable(nullptr)
+      , _waker()
+    {}
+
     /*-------------.
     | Construction |
     `-------------*/
 
-    Waitable::Waitable(std::string name)
-      : _name(std::move(name))
-      , _waiters()
+    Waitable::Waitable()
+      : _waiters()
+      , _name("")
+      , _name_storage()
+      , _exception()
+    {}
+
+    Waitable::Waitable(LiteralName name)
+      : _waiters()
+      , _name(name.str())
+      , _name_storage()
       , _exception()
     {}
 
+    Waitable::Waitable(std::string name)
+      : Waitable()
+    {
+      if (!name.empty())
+      {
+        this->_name_storage =
+          std::make_unique<std::string const>(std::move(name));
+        this->_name = this->_name_storage->c_str();
+      }
+    }
+
     Waitable::Waitable(Waitable&& source)
-      : _name(source._name)
-      , _waiters(std::move(source._waiters))
+      : _waiters(std::move(source._waiters))
+      , _name(source._name)
+      , _name_storage(std::move(source._name_storage))
       , _exception(source._exception)
-    {}
+    {
+      // The source may no longer own the name storage.
+      source._name = "";
+      for (auto& waiter: this->_waiters)
+        waiter._waitable = this;
+    }
 
     Waitable::~Waitable()
     {
@@ -44,7 +79,7 @@ namespace elle
       {
         auto threads =
           make_vector(this->_waiters,
-                      [](auto& t){ return elle::sprintf("%s", *t.first); });
+                      [](auto& w){ return elle::sprintf("%s", *w.thread()); });
         ELLE_ABORT("%s destroyed while waited by %s at %s",
                    *this,
                    boost::algorithm::join(threads, ", "),
@@ -52,6 +87,16 @@ namespace elle
       }
     }
 
+    /*-------.
+    | Status |
+    `-------*/
+
+    char const*
+    Waitable::name() const
+    {
+      return this->_name;
+    }
+
     /*--------.
     | Waiting |
     `--------*/
@@ -69,19 +114,21 @@ namespace elle
     int
     Waitable::_signal()
     {
-      if (_waiters.empty())
+      // Wake the current waiters only: woken threads may not wait again
+      // before we're done, but wakers may register other ones.
+      auto res = static_cast<int>(this->_waiters.size());
+      for (int i = 0; i < res && !this->_waiters.empty(); ++i)
       {
-        _exception = std::exception_ptr{}; // An empty one.
-        this->on_signaled()();
-        return false;
-      }
-      for (auto& thread: this->_waiters)
-        if (thread.second)
-          thread.second(thread.first);
+        auto& waiter = this->_waiters.front();
+        this->_waiters.pop_front();
+        auto thread = waiter.thread();
+        auto waker = std::move(waiter._waker);
+        thread->_waiter_release(waiter);
+        if (waker)
+          waker(thread);
         else
-          thread.first->_wake(this);
-      int res = _waiters.size();
-      _waiters.clear();
+          thread->_wake(this);
+      }
       _exception = std::exception_ptr{}; // An empty one.
       this->on_signaled()();
       return res;
@@ -96,27 +143,30 @@ namespace elle
         this->on_signaled()();
         return nullptr;
       }
-      auto thread = *this->_waiters.begin();
-      this->_signal_one(thread);
-      return thread.first;
+      auto& waiter = this->_waiters.front();
+      auto thread = waiter.thread();
+      this->_signal_one(waiter);
+      return thread;
     }
 
     void
     Waitable::_signal_one(Thread* t)
     {
-      auto thread = this->_waiters.get<1>().find(t);
-      if (thread != this->_waiters.get<1>().end())
-        return _signal_one(*thread);
+      if (auto waiter = t->_waiter_find(*this))
+        return _signal_one(*waiter);
     }
 
     void
-    Waitable::_signal_one(Handler const& thread)
+    Waitable::_signal_one(Waiter& waiter)
     {
-      if (thread.second)
-        thread.second(thread.first);
+      this->_waiters.erase(this->_waiters.iterator_to(waiter));
+      auto thread = waiter.thread();
+      auto waker = std::move(waiter._waker);
+      thread->_waiter_release(waiter);
+      if (waker)
+        waker(thread);
       else
-        thread.first->_wake(this);
-      this->_waiters.get<1>().erase(thread.first);
+        thread->_wake(this);
       this->_exception = std::exception_ptr{}; // An empty one.
       if (this->_waiters.empty())
         this->on_signaled()();
@@ -126,9 +176,8 @@ namespace elle
     Waitable::_wait(Thread* t, Waker const& waker)
     {
       ELLE_TRACE("%s: wait %s", t, this);
-      ELLE_ASSERT_EQ(this->_waiters.get<1>().find(t),
-                     this->_waiters.get<1>().end());
-      this->_waiters.emplace_back(t, waker);
+      ELLE_ASSERT(!t->_waiter_find(*this));
+      this->_waiters.push_back(t->_waiter_acquire(*this, waker));
       return true;
     }
 
@@ -136,9 +185,10 @@ namespace elle
     Waitable::_unwait(Thread* t)
     {
       ELLE_TRACE("%s: unwait %s", t, this);
-      ELLE_ASSERT_NEQ(this->_waiters.get<1>().find(t),
-                      this->_waiters.get<1>().end());
-      this->_waiters.get<1>().erase(t);
+      auto waiter = t->_waiter_find(*this);
+      ELLE_ASSERT(waiter);
+      this->_waiters.erase(this->_waiters.iterator_to(*waiter));
+      t->_waiter_release(*waiter);
     }
 
     void
@@ -155,7 +205,7 @@ namespace elle
     Waitable::print(std::ostream& stream) const
     {
       stream << elle::type_info(*this) << "(";
-      if (this->_name.empty())
+      if (!*this->_name)
         stream << this;
       else
         stream << this->_name;
@@ -1,12 +1,10 @@
 #pragma once
 
-#include <set>
+#include <functional>
+#include <memory>
+#include <string>
 
-#include <boost/function.hpp>
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/hashed_index.hpp>
+#include <boost/intrusive/list.hpp>
 #include <boost/noncopyable.hpp>
 
 #include <elle/Exception.hh>
@@ -19,6 +17,41 @@ namespace elle
 {
   namespace reactor
   {
+    /// The name of a Waitable, which is not copied.
+    ///
+    /// Only build it from string literals, which outlive any Waitable, through
+    /// the `_literal` suffix: `Barrier("ready"_literal)`.
+    class LiteralName
+    {
+    public:
+      constexpr
+      explicit
+      LiteralName(char const* str)
+        : _str(str)
+      {}
+
+      constexpr
+      char const*
+      str() const
+      {
+        return this->_str;
+      }
+
+    private:
+      char const* _str;
+    };
+
+    inline namespace literals
+    {
+      /// A Waitable name, kept without copy.
+      constexpr
+      LiteralName
+      operator "" _literal(char const* str, std::size_t)
+      {
+        return LiteralName(str);
+      }
+    }
+
     /// Waitable is a class Threads can wait for.
     ///
     /// In the Scheduler asynchroneous non-preemptive environment, Waitables
@@ -66,25 +99,43 @@ namespace elle
       using Self = Waitable;
       /// Wake callback.
       using Waker = std::function<void (Thread*)>;
-      /// Waited thread and its wake callback.
-      using Handler = std::pair<Thread*, Waker>;
-      /// Collection of threads waiting this
-      using Waiters = boost::multi_index_container<
-        Handler,
-        boost::multi_index::indexed_by<
-          boost::multi_index::sequenced<>,
-          boost::multi_index::hashed_unique<
-            boost::multi_index::member<Handler, Thread*, &Handler::first>>>
-        >;
+      /// A Thread waiting for a Waitable, and its wake callback.
+      ///
+      /// Waiters belong to the waiting Thread, which recycles them from one
+      /// wait to the next, and are linked in the Waitable intrusively: waiting
+      /// allocates nothing.
+      class Waiter
+        : public boost::intrusive::list_base_hook<>
+      {
+      public:
+        Waiter(Thread* thread);
+        Waiter(Waiter const&) = delete;
+        /// The waiting Thread.
+        ELLE_ATTRIBUTE_R(Thread*, thread);
+      private:
+        friend class Thread;
+        friend class Waitable;
+        /// The waited Waitable, null if this Waiter is free.
+        ELLE_ATTRIBUTE(Waitable*, waitable);
+        ELLE_ATTRIBUTE(Waker, waker);
+      };
+      /// Collection of threads waiting this, in waiting order.
+      using Waiters = boost::intrusive::list<Waiter>;
 
     /*-------------.
     | Construction |
     `-------------*/
     public:
-      /// Construct a Waitable.
+      /// Construct an unnamed Waitable.
+      Waitable();
+      /// Construct a Waitable named by a string literal, without copying it.
       ///
       /// \param name A descriptive name of the Waitable, for debugging purpose.
-      Waitable(std::string name = std::string());
+      Waitable(LiteralName name);
+      /// Construct a Waitable with a copy of @a name.
+      ///
+      /// \param name A descriptive name of the Waitable, for debugging purpose.
+      Waitable(std::string name);
       /// Move a Waitable.
       Waitable(Waitable&& source);
     protected:
@@ -98,8 +149,14 @@ namespace elle
     | Status |
     `-------*/
     public:
-      ELLE_ATTRIBUTE_R(std::string, name);
+      /// The descriptive name of the Waitable, empty if none.
+      char const*
+      name() const;
       ELLE_ATTRIBUTE_R(Waiters, waiters);
+    private:
+      ELLE_ATTRIBUTE(char const*, name);
+      /// Storage for computed names, unused for literals.
+      ELLE_ATTRIBUTE(std::unique_ptr<std::string const>, name_storage);
 
     /*--------.
     | Waiting |
@@ -168,14 +225,14 @@ namespace elle
       /// \param thread The Thread to wake up.
       void
       _signal_one(Thread* thread);
-      /// Signal a specific Handler.
+      /// Signal a specific Waiter.
       ///
-      /// Same as _signal_one(Thread). If the Handler has a Waker function, use
+      /// Same as _signal_one(Thread). If the Waiter has a Waker function, use
       /// it.
       ///
-      /// \param thread The Handler to signal.
+      /// \param waiter The Waiter to signal.
       void
-      _signal_one(Handler const& thread);
+      _signal_one(Waiter& waiter);
       ///  Register an exception waiting thread should throw when woken.
       ///
       /// \tparam Exception The type of the exception to raise.
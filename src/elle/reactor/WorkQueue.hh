@@ -0,0 +1,164 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <elle/Printable.hh>
+#include <elle/attribute.hh>
+#include <elle/optional.hh>
+#include <elle/reactor/Barrier.hh>
+#include <elle/reactor/Channel.hh>
+#include <elle/reactor/Scope.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    namespace _details
+    {
+      /// Results of a WorkQueue, in completion or submission order.
+      template <typename R>
+      class WorkQueueResults
+      {
+      public:
+        using Type = std::vector<R>;
+        WorkQueueResults(bool ordered);
+        template <typename F, typename T>
+        void
+        run(std::size_t index, F const& f, T&& item);
+        Type
+        take();
+      private:
+        ELLE_ATTRIBUTE(bool, ordered);
+        ELLE_ATTRIBUTE(std::vector<boost::optional<R>>, slots);
+        ELLE_ATTRIBUTE(Type, results);
+      };
+
+      template <>
+      class WorkQueueResults<void>
+      {
+      public:
+        using Type = void;
+        WorkQueueResults(bool);
+        template <typename F, typename T>
+        void
+        run(std::size_t index, F const& f, T&& item);
+        void
+        take();
+      };
+    }
+
+    /// A fixed set of worker Threads processing items from a bounded queue.
+    ///
+    /// Pushing waits while the queue is full, which bounds both the memory
+    /// held by pending items and the number of Threads, whatever the number of
+    /// items. Results of the handler are collected in completion order, or in
+    /// submission order if requested.
+    ///
+    /// Workers run in the given Scope. An exception escaping the handler
+    /// terminates the Scope and is rethrown to its owner, and terminating the
+    /// Scope cancels the queue. The WorkQueue must not outlive the Scope, and
+    /// terminates its remaining workers upon destruction.
+    ///
+    /// @code{.cc}
+    ///
+    /// elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+    /// {
+    ///   elle::reactor::WorkQueue<std::string, int> q(
+    ///     s, "fetch", 8,
+    ///     [] (std::string url) { return fetch(url).size(); });
+    ///   for (auto const& url: urls)
+    ///     q.push(url);
+    ///   for (auto size: q.finish())
+    ///     std::cout << size;
+    /// };
+    ///
+    /// @endcode
+    ///
+    /// @tparam T The type of items.
+    /// @tparam R The type returned by the handler.
+    template <typename T, typename R = void>
+    class WorkQueue
+      : public elle::Printable
+    {
+    /*------.
+    | Types |
+    `------*/
+    public:
+      using Self = WorkQueue<T, R>;
+      using Handler = std::function<R (T)>;
+      using Results = typename _details::WorkQueueResults<R>::Type;
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+    public:
+      /// Create a WorkQueue and start its workers.
+      ///
+      /// @param scope    The Scope to run workers in.
+      /// @param name     A descriptive name, for debugging.
+      /// @param workers  The number of worker Threads.
+      /// @param handler  The function processing items.
+      /// @param capacity The number of pending items beyond which push waits,
+      ///                 the number of workers if zero.
+      /// @param ordered  Whether results are in submission order rather than
+      ///                 completion order.
+      WorkQueue(Scope& scope,
+                std::string name,
+                int workers,
+                Handler handler,
+                int capacity = 0,
+                bool ordered = false);
+      WorkQueue(Self const&) = delete;
+      /// Terminate remaining workers.
+      ///
+      /// \throw Terminate if interrupted while killing workers.
+      ~WorkQueue() noexcept(false);
+
+    /*------.
+    | Items |
+    `------*/
+    public:
+      /// Queue @a item, waiting while the queue is full.
+      ///
+      /// @pre finish was not called.
+      void
+      push(T item);
+      /// Stop accepting items, wait until all pushed ones are processed and
+      /// return the results.
+      Results
+      finish();
+      /// Terminate workers now, dropping pending items.
+      void
+      terminate();
+      /// Number of items pushed.
+      ELLE_ATTRIBUTE_R(std::size_t, pushed);
+      /// Number of items processed.
+      ELLE_ATTRIBUTE_R(std::size_t, processed);
+    private:
+      using Item = boost::optional<std::pair<std::size_t, T>>;
+      void
+      _work(int index);
+      ELLE_ATTRIBUTE_R(std::string, name);
+      ELLE_ATTRIBUTE(Handler, handler);
+      /// Pending items, with one empty item per worker to end the queue.
+      ELLE_ATTRIBUTE(Channel<Item>, items);
+      ELLE_ATTRIBUTE(_details::WorkQueueResults<R>, results);
+      /// Live workers, reset as they exit.
+      ELLE_ATTRIBUTE(std::vector<Thread*>, workers);
+      ELLE_ATTRIBUTE(int, running);
+      ELLE_ATTRIBUTE(bool, finishing);
+      /// Opened when all workers exited.
+      ELLE_ATTRIBUTE(Barrier, done);
+
+    /*----------.
+    | Printable |
+    `----------*/
+    public:
+      void
+      print(std::ostream& stream) const override;
+    };
+  }
+}
+
+#include <elle/reactor/WorkQueue.hxx>
@@ -0,0 +1,207 @@
+#include <elle/assert.hh>
+#include <elle/finally.hh>
+#include <elle/log.hh>
+#include <elle/printf.hh>
+#include <elle/reactor/Thread.hh>
+#include <elle/reactor/scheduler.hh>
+
+namespace elle
+{
+  namespace reactor
+  {
+    namespace _details
+    {
+      /*--------.
+      | Results |
+      `--------*/
+
+      template <typename R>
+      WorkQueueResults<R>::WorkQueueResults(bool ordered)
+        : _ordered(ordered)
+        , _slots()
+        , _results()
+      {}
+
+      template <typename R>
+      template <typename F, typename T>
+      void
+      WorkQueueResults<R>::run(std::size_t index, F const& f, T&& item)
+      {
+        auto res = f(std::forward<T>(item));
+        if (this->_ordered)
+        {
+          if (this->_slots.size() <= index)
+            this->_slots.resize(index + 1);
+          this->_slots[index].emplace(std::move(res));
+        }
+        else
+          this->_results.emplace_back(std::move(res));
+      }
+
+      template <typename R>
+      auto
+      WorkQueueResults<R>::take()
+        -> Type
+      {
+        if (this->_ordered)
+        {
+          this->_results.reserve(this->_slots.size());
+          for (auto& slot: this->_slots)
+            if (slot)
+              this->_results.emplace_back(std::move(*slot));
+          this->_slots.clear();
+        }
+        return std::move(this->_results);
+      }
+
+      inline
+      WorkQueueResults<void>::WorkQueueResults(bool)
+      {}
+
+      template <typename F, typename T>
+      void
+      WorkQueueResults<void>::run(std::size_t, F const& f, T&& item)
+      {
+        f(std::forward<T>(item));
+      }
+
+      inline
+      void
+      WorkQueueResults<void>::take()
+      {}
+    }
+
+    /*-------------.
+    | Construction |
+    `-------------*/
+
+    template <typename T, typename R>
+    WorkQueue<T, R>::WorkQueue(Scope& scope,
+                               std::string name,
+                               int workers,
+                               Handler handler,
+                               int capacity,
+                               bool ordered)
+      : _pushed(0)
+      , _processed(0)
+      , _name(std::move(name))
+      , _handler(std::move(handler))
+      , _items()
+      , _results(ordered)
+      , _workers()
+      , _running(0)
+      , _finishing(false)
+      , _done(elle::sprintf("%s done", this->_name))
+    {
+      ELLE_ASSERT_GT(workers, 0);
+      this->_items.max_size(capacity > 0 ? capacity : workers);
+      for (int i = 0; i < workers; ++i)
+      {
+        ++this->_running;
+        this->_workers.push_back(
+          &scope.run_background(
+            elle::sprintf("%s: worker %s", this->_name, i),
+            [this, i] { this->_work(i); }));
+      }
+    }
+
+    template <typename T, typename R>
+    WorkQueue<T, R>::~WorkQueue() noexcept(false)
+    {
+      this->terminate();
+    }
+
+    /*------.
+    | Items |
+    `------*/
+
+    template <typename T, typename R>
+    void
+    WorkQueue<T, R>::push(T item)
+    {
+      ELLE_ASSERT(!this->_finishing);
+      this->_items.put(Item(std::make_pair(this->_pushed++, std::move(item))));
+    }
+
+    template <typename T, typename R>
+    auto
+    WorkQueue<T, R>::finish()
+      -> Results
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.WorkQueue");
+      ELLE_TRACE_SCOPE("%s: finish after %s items", this, this->_pushed);
+      if (!this->_finishing)
+      {
+        this->_finishing = true;
+        for (auto w: this->_workers)
+          if (w)
+            this->_items.put(Item());
+      }
+      reactor::wait(this->_done);
+      return this->_results.take();
+    }
+
+    template <typename T, typename R>
+    void
+    WorkQueue<T, R>::terminate()
+    {
+      auto workers = Waitables{};
+      for (auto w: this->_workers)
+        if (w && w != reactor::scheduler().current())
+        {
+          w->terminate();
+          workers.push_back(w);
+        }
+      // Workers reference us: join them even if interrupted.
+      std::exception_ptr e;
+      while (!workers.empty())
+        try
+        {
+          reactor::wait(workers);
+          break;
+        }
+        catch (...)
+        {
+          e = std::current_exception();
+        }
+      if (e)
+        std::rethrow_exception(e);
+    }
+
+    template <typename T, typename R>
+    void
+    WorkQueue<T, R>::_work(int index)
+    {
+      ELLE_LOG_COMPONENT("elle.reactor.WorkQueue");
+      elle::SafeFinally exit(
+        [this, index]
+        {
+          this->_workers[index] = nullptr;
+          if (!--this->_running)
+            this->_done.open();
+        });
+      while (true)
+      {
+        auto item = this->_items.get();
+        if (!item)
+          break;
+        ELLE_DEBUG("%s: process item %s", this, item->first);
+        this->_results.run(item->first, this->_handler,
+                           std::move(item->second));
+        ++this->_processed;
+      }
+    }
+
+    /*----------.
+    | Printable |
+    `----------*/
+
+    template <typename T, typename R>
+    void
+    WorkQueue<T, R>::print(std::ostream& stream) const
+    {
+      elle::fprintf(stream, "WorkQueue(%s, %s/%s)",
+                    this->_name, this->_processed, this->_pushed);
+    }
+  }
+}
@@ -23,6 +23,20 @@ namespace elle
       Backend::~Backend()
       = default;
 
+      std::unique_ptr<backend::Thread>
+      Backend::make_thread(const std::string& name,
+                           Action action,
+                           std::size_t)
+      {
+        return this->make_thread(name, std::move(action));
+      }
+
+      StackStatistics
+      Backend::stack_statistics() const
+      {
+        return {};
+      }
+
       /*-------------.
       | Construction |
       `-------------*/
@@ -15,6 +15,17 @@ namespace elle
     {
       class Thread;
 
+      /// Coroutine stacks usage of a Backend.
+      struct StackStatistics
+      {
+        /// Number of stacks owned by live threads.
+        std::size_t in_use = 0;
+        /// Number of stacks kept around for reuse.
+        std::size_t pooled = 0;
+        /// Highest number of stacks simultaneously in use.
+        std::size_t high_water = 0;
+      };
+
       /// Pool of thread that can switch execution.
       ///
       /// All thread are affiliated with a Manager, and can only switch
@@ -39,10 +50,32 @@ namespace elle
         std::unique_ptr<backend::Thread>
         make_thread(const std::string& name,
                     Action action) = 0;
+        /// Create a new thread with a given stack size.
+        ///
+        /// Backends that do not manage stacks themselves ignore the size. Others
+        /// round it up to whole pages, and to their minimum size.
+        ///
+        /// @param stack_size The stack size in bytes, 0 for the default one.
+        /// @throw elle::Error if @a stack_size exceeds the maximum size of the
+        ///                    backend, 8 MiB for Boost.Context.
+        virtual
+        std::unique_ptr<backend::Thread>
+        make_thread(const std::string& name,
+                    Action action,
+                    std::size_t stack_size);
         /// The currently running thread.
         virtual
         Thread*
         current() const = 0;
+
+      /*-------.
+      | Stacks |
+      `-------*/
+      public:
+        /// Current coroutine stacks usage.
+        virtual
+        StackStatistics
+        stack_statistics() const;
       };
 
       class Thread
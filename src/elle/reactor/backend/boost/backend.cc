@@ -1,3 +1,10 @@
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include <boost/context/fcontext.hpp>
 
 #ifdef VALGRIND
@@ -18,7 +25,9 @@
 
 #include <elle/Backtrace.hh>
 #include <elle/assert.hh>
+#include <elle/err.hh>
 #include <elle/log.hh>
+#include <elle/os/environ.hh>
 #include <elle/reactor/backend/boost/backend.hh>
 #include <elle/reactor/exception.hh>
 
@@ -60,16 +69,46 @@ namespace elle
             return Min;
           }
 
+          static
+          std::size_t
+          page_size()
+          {
+            static auto const res = std::size_t(::sysconf(_SC_PAGESIZE));
+            return res;
+          }
+
+          /// Map a stack of @a size bytes, plus a guard page below it.
+          ///
+          /// @param size The usable size, rounded up to a page boundary.
+          /// @param lazy Whether to skip reserving swap space, pages being
+          ///             committed on first touch only.
+          /// @returns The top of the stack.
           void*
-          allocate(std::size_t size) const
+          allocate(std::size_t size, bool lazy) const
           {
             ELLE_ASSERT(minimum_stack_size() <= size);
             ELLE_ASSERT(maximum_stack_size() >= size);
-
-            if (auto limit = std::malloc(size))
-              return static_cast<char*>(limit) + size;
-            else
+            ELLE_ASSERT_EQ(size % page_size(), 0u);
+            auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_STACK
+            flags |= MAP_STACK;
+#endif
+#ifdef MAP_NORESERVE
+            if (lazy)
+              flags |= MAP_NORESERVE;
+#endif
+            auto const total = size + page_size();
+            auto limit =
+              ::mmap(nullptr, total, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (limit == MAP_FAILED)
+              throw std::bad_alloc();
+            // Overflowing the stack faults instead of corrupting the heap.
+            if (::mprotect(limit, page_size(), PROT_NONE))
+            {
+              ::munmap(limit, total);
               throw std::bad_alloc();
+            }
+            return static_cast<char*>(limit) + total;
           }
 
           void
@@ -78,27 +117,134 @@ namespace elle
             ELLE_ASSERT(vp);
             ELLE_ASSERT(minimum_stack_size() <= size);
             ELLE_ASSERT(maximum_stack_size() >= size);
+            auto const total = size + page_size();
+            ::munmap(static_cast<char*>(vp) - total, total);
+          }
 
-            void* limit = static_cast<char*>(vp) - size;
-            std::free(limit);
+          /// Give the physical pages of a stack back to the system, keeping
+          /// the mapping.
+          void
+          release(void* vp, std::size_t size) const
+          {
+#ifdef MADV_DONTNEED
+            ::madvise(static_cast<char*>(vp) - size, size, MADV_DONTNEED);
+#endif
           }
         };
 
-        /*-------.
-        | Thread |
-        `-------*/
         /// Default allocator type.
         using StackAllocator = TemplatedStackAllocator<
           8 * 1024 * 1024,  // Max: 8 MiB
           4 * 128 * 1024,   // Default: 128 kiB
           8 * 1024          // Min: 8 kiB
           >;
+
+        /*-----------.
+        | Stack pool |
+        `-----------*/
+
+        /// Free lists of stacks, per size, owned by a Backend.
+        ///
+        /// Threads are short lived and stacks large: recycle them instead of
+        /// mapping and unmapping them every time. In lazy mode, stacks only
+        /// commit the pages they touch, which are given back to the system
+        /// when they return to the pool, and default-sized ones reserve the
+        /// maximum size: threads get all the stack they need without paying
+        /// for it upfront.
+        class Backend::StackPool
+        {
+        public:
+          StackPool()
+            : _capacity(elle::os::getenv("REACTOR_STACK_POOL", 64))
+            , _lazy(elle::os::getenv("REACTOR_STACK_LAZY", false))
+          {}
+
+          ~StackPool()
+          {
+            for (auto& stacks: this->_free)
+              for (auto sp: stacks.second)
+                this->_allocator.deallocate(sp, stacks.first);
+          }
+
+          /// Round @a size up to the actual size of the stack it gets.
+          ///
+          /// @throw elle::Error if @a size exceeds the maximum stack size.
+          std::size_t
+          size(std::size_t size) const
+          {
+            if (size == 0)
+              return this->_lazy ?
+                StackAllocator::maximum_stack_size() :
+                StackAllocator::default_stack_size();
+            if (size > StackAllocator::maximum_stack_size())
+              elle::err("stack size %s exceeds the maximum of %s bytes",
+                        size, StackAllocator::maximum_stack_size());
+            auto const page = StackAllocator::page_size();
+            size = (size + page - 1) / page * page;
+            return std::max(StackAllocator::minimum_stack_size(), size);
+          }
+
+          /// A stack of @a size bytes, as returned by size().
+          void*
+          allocate(std::size_t size)
+          {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            void* res = nullptr;
+            auto it = this->_free.find(size);
+            if (it != this->_free.end() && !it->second.empty())
+            {
+              res = it->second.back();
+              it->second.pop_back();
+              --this->_statistics.pooled;
+            }
+            else
+              res = this->_allocator.allocate(size, this->_lazy);
+            if (++this->_statistics.in_use > this->_statistics.high_water)
+              this->_statistics.high_water = this->_statistics.in_use;
+            return res;
+          }
+
+          void
+          deallocate(void* sp, std::size_t size)
+          {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            --this->_statistics.in_use;
+            if (this->_statistics.pooled < this->_capacity)
+            {
+              if (this->_lazy)
+                this->_allocator.release(sp, size);
+              this->_free[size].push_back(sp);
+              ++this->_statistics.pooled;
+            }
+            else
+              this->_allocator.deallocate(sp, size);
+          }
+
+          StackStatistics
+          statistics() const
+          {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            return this->_statistics;
+          }
+
+        private:
+          /// Stacks may be allocated by Threads created from another system
+          /// thread, see Scheduler::mt_run.
+          ELLE_ATTRIBUTE(std::mutex, mutex, mutable);
+          ELLE_ATTRIBUTE(StackAllocator, allocator);
+          ELLE_ATTRIBUTE(std::size_t, capacity);
+          ELLE_ATTRIBUTE(bool, lazy);
+          ELLE_ATTRIBUTE(
+            (std::unordered_map<std::size_t, std::vector<void*>>), free);
+          ELLE_ATTRIBUTE(StackStatistics, statistics);
+        };
+
+        /*-------.
+        | Thread |
+        `-------*/
         /// Type of context pointer used.
         using Context = ::boost::context::fcontext_t;
 
-        /// Allocator.
-        static StackAllocator stack_allocator;
-
         /// Invoke thread_ptr->_run().
         static
         void
@@ -122,10 +268,12 @@ namespace elle
         public:
           Thread(Backend& backend,
                  const std::string& name,
-                 Action action)
+                 Action action,
+                 std::size_t stack_size = 0)
             : Super(name, std::move(action))
             , _backend(backend)
-            , _stack_pointer(stack_allocator.allocate(this->_stack_size))
+            , _stack_size(backend._stacks->size(stack_size))
+            , _stack_pointer(backend._stacks->allocate(this->_stack_size))
             , _context(make_fcontext(this->_stack_pointer,
                                      this->_stack_size, wrapped_run))
             , _root(false)
@@ -150,8 +298,8 @@ namespace elle
             if (this->_context)
             {
               this->_context = nullptr;
-              stack_allocator.deallocate(this->_stack_pointer,
-                                         this->_stack_size);
+              this->_backend._stacks->deallocate(this->_stack_pointer,
+                                                 this->_stack_size);
             }
 #ifdef VALGRIND
             VALGRIND_STACK_DEREGISTER(this->_valgrind_stack);
@@ -159,8 +307,11 @@ namespace elle
           }
 
         private:
+          /// The root thread runs on the system stack, and only needs one
+          /// for the sake of symmetry.
           Thread(Backend& backend)
-            : Thread(backend, "<root>", Action())
+            : Thread(backend, "<root>", Action(),
+                     StackAllocator::minimum_stack_size())
           {
             this->_root = true;
             this->status(Status::running);
@@ -313,7 +464,7 @@ namespace elle
           /// Owning backend.
           Backend& _backend;
           /// Context stack size.
-          std::size_t const _stack_size = StackAllocator::default_stack_size();
+          std::size_t const _stack_size;
           /// Context stack pointer.
           void* _stack_pointer;
           /// Underlying IO context.
@@ -342,7 +493,8 @@ namespace elle
         `--------*/
 
         Backend::Backend()
-          : _self(new Thread(*this))
+          : _stacks(std::make_unique<StackPool>())
+          , _self(new Thread(*this))
           , _current(this->_self.get())
         {}
 
@@ -356,11 +508,26 @@ namespace elle
             new Thread(*this, name, std::move(action)));
         }
 
+        std::unique_ptr<backend::Thread>
+        Backend::make_thread(const std::string& name,
+                             Action action,
+                             std::size_t stack_size)
+        {
+          return std::unique_ptr<backend::Thread>(
+            new Thread(*this, name, std::move(action), stack_size));
+        }
+
         Thread*
         Backend::current() const
         {
           return this->_current;
         }
+
+        StackStatistics
+        Backend::stack_statistics() const
+        {
+          return this->_stacks->statistics();
+        }
       }
     }
   }
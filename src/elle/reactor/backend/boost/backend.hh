@@ -37,15 +37,29 @@ namespace elle
           std::unique_ptr<backend::Thread>
           make_thread(const std::string& name,
                       Action action) override;
+          std::unique_ptr<backend::Thread>
+          make_thread(const std::string& name,
+                      Action action,
+                      std::size_t stack_size) override;
           backend::Thread*
           current() const override;
 
+        /*-------.
+        | Stacks |
+        `-------*/
+        public:
+          StackStatistics
+          stack_statistics() const override;
+
         /*--------.
         | Details |
         `--------*/
         private:
           /// Let threads manipulate the current thread and the root thread.
           friend class Thread;
+          class StackPool;
+          /// Recycled coroutine stacks, destroyed after the root thread.
+          std::unique_ptr<StackPool> _stacks;
           /// Root thread, which instantiated the Backend.
           std::unique_ptr<Thread> _self;
           /// Current thread.
@@ -35,6 +35,7 @@ namespace elle
         | Threads |
         `--------*/
         public:
+          using Super::make_thread;
           std::unique_ptr<backend::Thread>
           make_thread(const std::string& name, Action action) override;
           backend::Thread*
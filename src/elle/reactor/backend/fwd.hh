@@ -11,6 +11,7 @@ namespace elle
       /// An action run by a thread.
       using Action = std::function<void ()>;
       class Backend;
+      struct StackStatistics;
       class Thread;
     }
   }
@@ -32,6 +32,22 @@ namespace elle
     void
     for_each_parallel(C&& c, F const& f, std::string const& name = {});
 
+    /// Apply a given function to every item of a given container, by at most
+    /// @a concurrency items at once.
+    ///
+    /// Only @a concurrency Threads are spawned, each applying @a f to the next
+    /// unprocessed item until the container is exhausted. Iterating over a
+    /// large container thus holds a bounded number of stacks.
+    ///
+    /// @param c           The container.
+    /// @param f           The function to apply to every item.
+    /// @param concurrency The maximum number of items processed at once.
+    /// @param name        A descriptive name, for debugging.
+    template <typename C, typename F>
+    void
+    for_each_parallel(C&& c, F const& f, int concurrency,
+                      std::string const& name = {});
+
     /// Break exception used to break for_each_parallel execution.
     class Break
       : public elle::Exception
@@ -1,4 +1,5 @@
 #include <elle/With.hh>
+#include <elle/assert.hh>
 #include <elle/reactor/Scope.hh>
 #include <elle/reactor/scheduler.hh>
 
@@ -56,6 +57,42 @@ namespace elle
       };
     }
 
+    template <typename C, typename F>
+    void
+    for_each_parallel(C&& c, F const& f, int concurrency,
+                      std::string const& name)
+    {
+      ELLE_ASSERT_GT(concurrency, 0);
+      using std::begin;
+      using std::end;
+      auto it = begin(c);
+      auto const last = end(c);
+      elle::With<reactor::Scope>(name) << [&] (reactor::Scope& scope)
+      {
+        for (int i = 0; i < concurrency && it != last; ++i)
+          scope.run_background(
+            elle::print("{}: {}: worker {}",
+                        reactor::scheduler().current()->name(),
+                        name.empty() ? "for-each" : name,
+                        i),
+            [&]
+            {
+              try
+              {
+                // Threads are cooperative: claiming the next item needs no
+                // synchronization.
+                while (it != last)
+                  f(*it++);
+              }
+              catch (Break const&)
+              {
+                scope.terminate_now();
+              }
+            });
+        reactor::wait(scope);
+      };
+    }
+
     inline
     void
     break_parallel()
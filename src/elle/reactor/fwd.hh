@@ -2,6 +2,8 @@
 
 #include <vector>
 
+#include <boost/intrusive/list_hook.hpp>
+
 #ifdef BUILDING_REACTOR_DLL
 # define REACTOR_API __declspec(dllexport)
 #else
@@ -25,8 +27,23 @@ namespace elle
     class VThread;
     class Waitable;
 
+    /// Classes of background jobs, run by distinct pools of system threads so
+    /// that jobs of one class cannot starve the other.
+    enum class BackgroundClass
+    {
+      /// Jobs keeping a core busy, such as hashing or compression. Their pool
+      /// is bounded by the number of cores, extra jobs are queued.
+      cpu,
+      /// Jobs waiting on the system, such as file I/O or name resolution.
+      /// Their pool grows with demand, up to a configurable maximum.
+      blocking,
+    };
+
     using Signals = std::vector<Signal*>;
     using Waitables = std::vector<Waitable*>;
+    /// Links a Thread in the Scheduler queue matching its state.
+    using ThreadQueueHook = boost::intrusive::list_base_hook<
+      boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
 
     namespace filesystem
     {
@@ -110,7 +110,7 @@ namespace elle
         , _input_done(false)
         , _input()
         , _input_current()
-        , _input_available("input available")
+        , _input_available("input available"_literal)
         , _output_done(false)
         , _output(0)
         , _output_available(false)
@@ -151,6 +151,17 @@ namespace elle
         static_cast<StreamBuffer*>(this->rdbuf())->pacified(true);
       }
 
+      /*------.
+      | Write |
+      `------*/
+
+      void
+      Socket::write(Buffers const& buffers)
+      {
+        for (auto const& buffer: buffers)
+          this->write(buffer);
+      }
+
       /*-----.
       | Read |
       `-----*/
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include <elle/Buffer.hh>
 #include <elle/IOStream.hh>
 #include <elle/attribute.hh>
@@ -34,6 +36,8 @@ namespace elle
       public:
         /// Self type.
         using Self = Socket;
+        /// Buffers to write in order.
+        using Buffers = std::vector<elle::ConstWeakBuffer>;
 
       /*----------.
       | Constants |
@@ -86,6 +90,16 @@ namespace elle
         virtual
         void
         write(elle::ConstWeakBuffer buffer) = 0;
+        /// Write the given buffers to the Socket, in order.
+        ///
+        /// Stream sockets send them with a single gather write, without
+        /// copying them into an intermediate buffer. Data buffered by the
+        /// std::iostream interface is not flushed beforehand.
+        ///
+        /// @param buffers The payloads to write.
+        virtual
+        void
+        write(Buffers const& buffers);
 
       /*-----.
       | Read |
@@ -342,10 +356,16 @@ namespace elle
         /// @Socket::write.
         void
         write(elle::ConstWeakBuffer buffer) override;
+        /// @Socket::write.
+        void
+        write(Socket::Buffers const& buffers) override;
       protected:
         void
         _final_flush();
       private:
+        template <typename AsioBuffers>
+        void
+        _write(AsioBuffers const& buffers, Size size);
         void
         _async_write();
         ELLE_ATTRIBUTE(Mutex, write_mutex);
@@ -502,7 +502,7 @@ namespace elle
       | Write |
       `------*/
 
-      template <typename PlainSocket, typename AsioSocket>
+      template <typename PlainSocket, typename AsioSocket, typename AsioBuffers>
       class Write:
         public DataOperation<typename SocketSpecialization<AsioSocket>::Socket>
       {
@@ -512,10 +512,10 @@ namespace elle
         using Spe = SocketSpecialization<AsioSocket>;
         Write(PlainSocket& plain,
               AsioSocket& socket,
-              elle::ConstWeakBuffer buffer)
+              AsioBuffers const& buffers)
           : Super(Spe::socket(socket))
           , _socket(plain)
-          , _buffer(std::move(buffer))
+          , _buffers(buffers)
           , _written(0)
         {}
 
@@ -525,7 +525,7 @@ namespace elle
         {
           boost::asio::async_write(
             *this->_socket.socket(),
-            boost::asio::buffer(this->_buffer.contents(), this->_buffer.size()),
+            this->_buffers,
             [this](const boost::system::error_code& error,
                    std::size_t written)
             {
@@ -548,7 +548,7 @@ namespace elle
         }
 
         ELLE_ATTRIBUTE(PlainSocket const&, socket);
-        ELLE_ATTRIBUTE(elle::ConstWeakBuffer, buffer);
+        ELLE_ATTRIBUTE(AsioBuffers const&, buffers);
         ELLE_ATTRIBUTE_R(Size, written);
       };
 
@@ -558,22 +558,59 @@ namespace elle
       {
         ELLE_LOG_COMPONENT("elle.reactor.network.Socket");
         if (reactor::scheduler().current())
+          this->_write(boost::asio::buffer(buffer.contents(), buffer.size()),
+                       buffer.size());
+        else
         {
-          {
-            Lock lock(this->_write_mutex);
-            ELLE_TRACE_SCOPE("%s: write %s bytes", this, buffer.size());
-            Write<Self, AsioSocket> write(*this, *this->socket(), buffer);
-            write.run();
-          }
+          this->_async_writes.emplace_back(buffer.contents(), buffer.size());
           this->_async_write();
         }
+      }
+
+      template <typename AsioSocket, typename EndPoint>
+      void
+      StreamSocket<AsioSocket, EndPoint>::write(
+        Socket::Buffers const& buffers)
+      {
+        auto size = Size(0);
+        for (auto const& b: buffers)
+          size += b.size();
+        if (reactor::scheduler().current())
+        {
+          auto asio_buffers = std::vector<boost::asio::const_buffer>{};
+          asio_buffers.reserve(buffers.size());
+          for (auto const& b: buffers)
+            asio_buffers.emplace_back(b.contents(), b.size());
+          this->_write(asio_buffers, size);
+        }
         else
         {
-          this->_async_writes.emplace_back(buffer.contents(), buffer.size());
+          auto buffer = elle::Buffer{};
+          buffer.capacity(size);
+          for (auto const& b: buffers)
+            buffer.append(b.contents(), b.size());
+          this->_async_writes.emplace_back(std::move(buffer));
           this->_async_write();
         }
       }
 
+      template <typename AsioSocket, typename EndPoint>
+      template <typename AsioBuffers>
+      void
+      StreamSocket<AsioSocket, EndPoint>::_write(AsioBuffers const& buffers,
+                                                 Size size)
+      {
+        ELLE_LOG_COMPONENT("elle.reactor.network.Socket");
+        {
+          Lock lock(this->_write_mutex);
+          ELLE_TRACE_SCOPE("%s: write %s bytes", this, size);
+          Write<Self, AsioSocket, AsioBuffers> write(
+            *this, *this->socket(), buffers);
+          write.run();
+        }
+        this->_async_write();
+      }
+
       template <typename AsioSocket, typename EndPoint>
       void
       StreamSocket<AsioSocket, EndPoint>::_async_write()
@@ -286,7 +286,7 @@ namespace elle
       UTPServer::Impl::Impl()
         : _ctx(utp_init(2))
         , _xorify(0)
-        , _accept_barrier("UTPServer accept")
+        , _accept_barrier("UTPServer accept"_literal)
         , _sending(false)
         , _icmp_fd(-1)
       {
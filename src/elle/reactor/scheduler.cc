@@ -1,11 +1,15 @@
+#include <algorithm>
+#include <utility>
+
+#include <time.h>
+
 #include <elle/Measure.hh>
 #include <elle/Plugin.hh>
 #include <elle/assert.hh>
 #include <elle/attribute.hh>
 #include <elle/finally.hh>
-#include <elle/find.hh>
+#include <elle/json/json.hh>
 #include <elle/log.hh>
-#include <elle/make-vector.hh>
 #include <elle/memory.hh>
 #include <elle/os/environ.hh>
 #include <elle/reactor/BackgroundOperation.hh>
@@ -25,6 +29,29 @@ ELLE_LOG_COMPONENT("elle.reactor.Scheduler");
 namespace
 {
   auto const DBG = elle::os::getenv("REACTOR_SCHEDULER_DEBUG", false);
+
+  using Clock = std::chrono::steady_clock;
+
+  elle::reactor::Duration
+  duration(Clock::duration d)
+  {
+    return boost::posix_time::microseconds(
+      std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+  }
+
+  /// CPU time consumed so far by the calling system thread, which runs every
+  /// coroutine of its scheduler. Zero where the platform cannot tell.
+  Clock::duration
+  thread_cpu_time()
+  {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    auto ts = timespec{};
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+      return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+#endif
+    return Clock::duration::zero();
+  }
 }
 
 namespace elle
@@ -37,20 +64,159 @@ namespace elle
       extern elle::Plugin<elle::log::Tag> logger_tags;
     }
 
+    /*-----------------.
+    | Background pools |
+    `-----------------*/
+
+    /// A pool of system threads running background jobs of one class.
+    ///
+    /// Threads are spawned on demand, up to the maximum, and never exit before
+    /// the scheduler stops. The pool is driven from the scheduler thread, but
+    /// its statistics are updated by the system threads.
+    class Scheduler::BackgroundPool
+    {
+    public:
+      BackgroundPool(int max)
+        : _max(std::max(max, 1))
+        , _service()
+        , _work(std::make_unique<boost::asio::io_service::work>(
+                  this->_service))
+        , _threads()
+        , _mutex()
+        , _queued(0)
+        , _running(0)
+        , _jobs(0)
+        , _wait_time(0)
+        , _run_time(0)
+      {}
+
+      ~BackgroundPool()
+      {
+        this->stop();
+      }
+
+      /// Let threads finish queued jobs, and join them.
+      void
+      stop()
+      {
+        this->_work = nullptr;
+        for (auto& thread: this->_threads)
+          if (thread.joinable())
+            thread.join();
+      }
+
+      void
+      post(std::function<std::function<void ()> ()> action,
+           boost::asio::io_service& epilogues)
+      {
+        int busy = 0;
+        {
+          std::unique_lock<std::mutex> lock(this->_mutex);
+          busy = ++this->_queued + this->_running;
+        }
+        if (busy > signed(this->_threads.size()) &&
+            signed(this->_threads.size()) < this->_max)
+        {
+          ELLE_DEBUG("spawn background thread %s",
+                     this->_threads.size() + 1);
+          this->_threads.emplace_back([this] { this->_service.run(); });
+        }
+        auto const posted = Clock::now();
+        this->_service.post(
+          [this, action, posted, &epilogues]
+          {
+            auto const start = Clock::now();
+            {
+              std::unique_lock<std::mutex> lock(this->_mutex);
+              --this->_queued;
+              ++this->_running;
+              this->_wait_time += start - posted;
+            }
+            try
+            {
+              auto epilogue = elle::utility::move_on_copy(action());
+              {
+                std::unique_lock<std::mutex> lock(this->_mutex);
+                --this->_running;
+                ++this->_jobs;
+                this->_run_time += Clock::now() - start;
+              }
+              epilogues.post([epilogue] { (*epilogue)(); });
+            }
+            catch (...)
+            {
+              ELLE_ABORT("background job threw: %s",
+                         elle::exception_string());
+            }
+          });
+      }
+
+      BackgroundStatistics
+      statistics() const
+      {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        auto res = BackgroundStatistics{};
+        res.threads = this->_threads.size();
+        res.queued = this->_queued;
+        res.running = this->_running;
+        res.jobs = this->_jobs;
+        res.wait_time = duration(this->_wait_time);
+        res.run_time = duration(this->_run_time);
+        return res;
+      }
+
+      ELLE_ATTRIBUTE_RW(int, max);
+      ELLE_ATTRIBUTE(boost::asio::io_service, service);
+      ELLE_ATTRIBUTE(std::unique_ptr<boost::asio::io_service::work>, work);
+      ELLE_ATTRIBUTE_R(std::vector<std::thread>, threads);
+      /// Protects the statistics below.
+      ELLE_ATTRIBUTE(std::mutex, mutex, mutable);
+      ELLE_ATTRIBUTE(int, queued);
+      ELLE_ATTRIBUTE(int, running);
+      ELLE_ATTRIBUTE(std::size_t, jobs);
+      ELLE_ATTRIBUTE(Clock::duration, wait_time);
+      ELLE_ATTRIBUTE(Clock::duration, run_time);
+    };
+
+    /*------------.
+    | Submissions |
+    `------------*/
+
+    struct Scheduler::Submission
+    {
+      Submission* next = nullptr;
+      /// A Thread constructed by another system thread, to start.
+      Thread* thread = nullptr;
+      /// Otherwise, an action to run in a new Thread.
+      std::string name;
+      std::function<void ()> action;
+    };
+
     /*-------------.
     | Construction |
     `-------------*/
 
     Scheduler::Scheduler()
-      : _done(false)
+      : _statistics()
+      , _long_step_threshold(
+        boost::posix_time::milliseconds(
+          elle::os::getenv("REACTOR_LONG_STEP_THRESHOLD", 1000)))
+      , _done(false)
       , _shallstop(false)
       , _current(nullptr)
-      , _background_service_work(
-           std::make_unique<boost::asio::io_service::work>(this->_background_service))
-      , _background_pool()
-      , _background_pool_free(0)
+      , _starting_batch(0)
+      , _submissions(nullptr)
+      , _background_cpu(
+        std::make_unique<BackgroundPool>(
+          std::max<int>(std::thread::hardware_concurrency(), 1)))
+      , _background_blocking(
+        std::make_unique<BackgroundPool>(
+          elle::os::getenv("REACTOR_BACKGROUND_BLOCKING_MAX", 16)))
       , _io_service_work(
            std::make_unique<boost::asio::io_service::work>(this->_io_service))
+      , _timers(this->_io_service,
+                boost::posix_time::milliseconds(
+                  elle::os::getenv("REACTOR_TIMER_RESOLUTION", 1)))
 #if defined(REACTOR_CORO_BACKEND_IO)
       , _manager(new backend::coro_io::Backend())
 #elif defined(REACTOR_CORO_BACKEND_BOOST_CONTEXT)
@@ -58,6 +224,7 @@ namespace elle
 #else
 # error "REACTOR_CORO_BACKEND not defined"
 #endif
+      , _running_thread(std::thread::id())
     {
       this->_eptr = nullptr;
       plugins::logger_indentation.load();
@@ -74,7 +241,14 @@ namespace elle
 #endif
     }
 
-    Scheduler::~Scheduler() = default;
+    Scheduler::~Scheduler()
+    {
+      // Drop what was submitted too late to run, breaking the promises of
+      // mt_run_async callers.
+      auto head = this->_submissions.exchange(nullptr);
+      while (head)
+        delete std::exchange(head, head->next);
+    }
 
     /*------------------.
     | Current Scheduler |
@@ -157,8 +331,8 @@ namespace elle
           for (auto t: thread.waited())
             std::cerr << "      " << *t << std::endl;
           std::cerr << "    waiters:" << std::endl;
-          for (auto t: thread.waiters())
-            std::cerr << "      " << *(t.first) << std::endl;
+          for (auto const& w: thread.waiters())
+            std::cerr << "      " << *w.thread() << std::endl;
           std::cerr << "    backtrace:" << std::endl;
           // FIXME: Indent the backtrace
           std::cerr << thread.backtrace() << std::endl;
@@ -166,21 +340,85 @@ namespace elle
       if (!this->_frozen.empty())
       {
         std::cerr << "== FROZEN THREADS ==" << std::endl;
-        for (auto thread: this->_frozen)
-          print_thread(*thread);
+        for (auto const& thread: this->_frozen)
+          print_thread(thread);
       }
-      if (!this->_running.empty())
+      if (!this->_running.empty() || !this->_woken.empty())
       {
         std::cerr << "== RUNNING THREADS ==" << std::endl;
-        for (auto thread: this->_running)
-          print_thread(*thread);
+        for (auto const& thread: this->_running)
+          print_thread(thread);
+        for (auto const& thread: this->_woken)
+          print_thread(thread);
       }
       if (!this->_starting.empty())
       {
         std::cerr << "== STARTING THREADS ==" << std::endl;
-        for (auto thread: this->_starting)
-          print_thread(*thread);
+        for (auto const& thread: this->_starting)
+          print_thread(thread);
       }
+      std::cerr << "== STATISTICS ==" << std::endl;
+      elle::json::write(std::cerr, this->statistics_json(), true, true);
+    }
+
+    elle::json::Object
+    Scheduler::statistics_json() const
+    {
+      auto us = [] (Duration d) -> std::int64_t
+        {
+          return d.total_microseconds();
+        };
+      auto threads = elle::json::Array{};
+      auto add = [&] (Queue const& queue)
+        {
+          for (auto const& t: queue)
+          {
+            auto const& stats = t.statistics();
+            threads.emplace_back(
+              elle::json::Object{
+                {"name", t.name()},
+                {"state", elle::sprintf("%s", t.state())},
+                {"steps", stats.steps},
+                {"yields", stats.yields},
+                {"freezes", stats.freezes},
+                {"run_time", us(stats.run_time)},
+                {"cpu_time", us(stats.cpu_time)},
+                {"runnable_time", us(stats.runnable_time)},
+                {"longest_step", us(stats.longest_step)},
+              });
+          }
+        };
+      add(this->_running);
+      add(this->_woken);
+      add(this->_frozen);
+      add(this->_starting);
+      auto background = [&] (BackgroundClass c)
+        {
+          auto const stats = this->background_statistics(c);
+          return elle::json::Object{
+            {"threads", stats.threads},
+            {"queued", stats.queued},
+            {"running", stats.running},
+            {"jobs", stats.jobs},
+            {"wait_time", us(stats.wait_time)},
+            {"run_time", us(stats.run_time)},
+          };
+        };
+      auto const& stats = this->_statistics;
+      return elle::json::Object{
+        {"rounds", stats.rounds},
+        {"steps", stats.steps},
+        {"callbacks", stats.callbacks},
+        {"round_callbacks", stats.round_callbacks},
+        {"max_round_callbacks", stats.max_round_callbacks},
+        {"long_steps", stats.long_steps},
+        {"long_step_threshold", us(this->_long_step_threshold)},
+        {"threads", std::move(threads)},
+        {"background", elle::json::Object{
+            {"cpu", background(BackgroundClass::cpu)},
+            {"blocking", background(BackgroundClass::blocking)},
+          }},
+      };
     }
 
     /*----.
@@ -211,13 +449,18 @@ namespace elle
         PushScheduler p(this);
         ELLE_TRACE_SCOPE("%s: run", *this);
       }
-      this->_running_thread = std::this_thread::get_id();
+      {
+        std::unique_lock<std::mutex> lock(this->_starting_mtx);
+        this->_running_thread = std::this_thread::get_id();
+      }
       while (this->step())
         continue;
-      this->_running_thread = std::thread::id();
-      this->_background_service_work = nullptr;
-      for (auto& thread: this->_background_pool)
-        thread.join();
+      {
+        std::unique_lock<std::mutex> lock(this->_starting_mtx);
+        this->_running_thread = std::thread::id();
+      }
+      this->_background_cpu->stop();
+      this->_background_blocking->stop();
       this->_io_service_work = nullptr;
       // Cancel all pending signal handlers.
       this->_signal_handlers.clear();
@@ -242,29 +485,24 @@ namespace elle
     Scheduler::step()
     {
       PushScheduler p(this);
-      // Could avoid locking if no jobs are pending with a boolean.
-      {
-        std::unique_lock<std::mutex> lock(this->_starting_mtx);
-        auto& ordered = this->_starting.get<1>();
-        this->_running.insert(ordered.begin(), ordered.end());
-        this->_starting.clear();
-      }
-      auto& ordered = this->_running.get<1>();
-      auto running = make_vector(ordered);
-      ELLE_TRACE_SCOPE("Scheduler: new round with %s jobs", running.size());
-
-      ELLE_DUMP("%s: starting: %s", this, this->_starting);
-      ELLE_DUMP("%s: running: %s", this, this->_running);
-      ELLE_DUMP("%s: frozen: %s", this, this->_frozen);
+      this->_running.splice(this->_running.end(), this->_woken);
+      this->_drain_submissions();
+      this->_running.splice(this->_running.end(), this->_starting);
+      ++this->_starting_batch;
+      ELLE_TRACE_SCOPE("Scheduler: new round with %s jobs",
+                       this->_running.size());
+      ++this->_statistics.rounds;
       ELLE_MEASURE("Scheduler round")
-        for (Thread* t: running)
-          // If the thread was stopped during this round, skip. Can be caused by
-          // terminate_now, for instance.
-          if (elle::find(this->_running, t))
-          {
-            ELLE_TRACE("Scheduler: schedule %s", *t);
-            this->_step(t);
-          }
+        // Threads unfrozen during the round land in _woken, which bounds the
+        // round. Only the stepped thread may leave _running, by freezing or
+        // finishing, so the next iterator remains valid.
+        for (auto it = this->_running.begin(); it != this->_running.end();)
+        {
+          auto& t = *it++;
+          ELLE_TRACE("Scheduler: schedule %s", t);
+          this->_step(&t);
+          ELLE_ASSERT(it == this->_running.end() || it->is_linked());
+        }
       ELLE_TRACE("%s: run asynchronous jobs", *this)
       {
         ELLE_MEASURE_SCOPE("Asio callbacks");
@@ -273,6 +511,11 @@ namespace elle
           this->_io_service.reset();
           auto n = this->_io_service.poll();
           ELLE_DEBUG("%s: %s callback called", *this, n);
+          auto& stats = this->_statistics;
+          stats.callbacks += n;
+          stats.round_callbacks = n;
+          stats.max_round_callbacks =
+            std::max(stats.max_round_callbacks, stats.round_callbacks);
         }
         catch (std::exception const& e)
         {
@@ -288,7 +531,8 @@ namespace elle
           this->terminate();
         }
       }
-      if (this->_running.empty() && this->_starting.empty())
+      if (this->_running.empty() && this->_woken.empty() &&
+          this->_starting.empty())
       {
         if (this->_frozen.empty())
         {
@@ -296,7 +540,8 @@ namespace elle
           return false;
         }
         else
-          while (this->_running.empty() && this->_starting.empty())
+          while (this->_running.empty() && this->_woken.empty() &&
+                 this->_starting.empty())
           {
             ELLE_TRACE_SCOPE("%s: nothing to do, "
                        "polling asio in a blocking fashion", *this);
@@ -304,6 +549,11 @@ namespace elle
             boost::system::error_code err;
             std::size_t run = this->_io_service.run_one(err);
             ELLE_DEBUG("%s: %s callback called", *this, run);
+            auto& stats = this->_statistics;
+            stats.callbacks += run;
+            stats.round_callbacks += run;
+            stats.max_round_callbacks =
+              std::max(stats.max_round_callbacks, stats.round_callbacks);
             if (err)
             {
               std::cerr << "fatal ASIO error: " << err << std::endl;
@@ -331,6 +581,10 @@ namespace elle
       ELLE_ASSERT_EQ(thread->state(), Thread::State::running);
       Thread* previous = this->_current;
       this->_current = thread;
+      auto const start = Clock::now();
+      auto const cpu_start = thread_cpu_time();
+      auto& stats = thread->_statistics;
+      stats.runnable_time += duration(start - thread->_runnable_since);
       try
       {
         thread->_step();
@@ -347,10 +601,35 @@ namespace elle
         this->_eptr = std::current_exception();
         this->terminate();
       }
+      auto const end = Clock::now();
+      auto const elapsed = duration(end - start);
+      ++this->_statistics.steps;
+      ++stats.steps;
+      stats.run_time += elapsed;
+      stats.cpu_time += duration(thread_cpu_time() - cpu_start);
+      stats.longest_step = std::max(stats.longest_step, elapsed);
+      if (elapsed > this->_long_step_threshold)
+      {
+        ++this->_statistics.long_steps;
+        ELLE_WARN("%s: %s held the event loop for %s",
+                  *this, *thread, elapsed);
+      }
+      switch (thread->state())
+      {
+        case Thread::State::running:
+          ++stats.yields;
+          thread->_runnable_since = end;
+          break;
+        case Thread::State::frozen:
+          ++stats.freezes;
+          break;
+        case Thread::State::done:
+          break;
+      }
       if (thread->state() == Thread::State::done)
       {
         ELLE_TRACE("%s: %s finished", *this, *thread);
-        this->_running.erase(thread);
+        thread->unlink();
         thread->_scheduler_release();
       }
     }
@@ -369,21 +648,30 @@ namespace elle
     Scheduler::_freeze(Thread& thread)
     {
       ELLE_ASSERT_EQ(thread.state(), Thread::State::running);
-      ELLE_ASSERT_NEQ(this->_running.find(&thread), this->_running.end());
-      this->_running.erase(&thread);
-      this->_frozen.insert(&thread);
+      ELLE_ASSERT(thread.is_linked());
+      thread.unlink();
+      this->_frozen.push_back(thread);
       thread.frozen()();
     }
 
     void
     Scheduler::_thread_register(Thread& thread)
     {
-      // FIXME: be thread safe only if needed
+      if (this->_running_thread.load() == std::this_thread::get_id())
       {
-        std::unique_lock<std::mutex> lock(this->_starting_mtx);
-        this->_starting.insert(&thread);
-        // Wake the scheduler.
-        this->_io_service.post([]{});
+        this->_queue_starting(thread);
+        return;
+      }
+      // Decide under the lock run() takes to claim the scheduler, so it
+      // doesn't start running in between.
+      std::unique_lock<std::mutex> lock(this->_starting_mtx);
+      if (this->_running_thread.load() == std::thread::id())
+        this->_queue_starting(thread);
+      else
+      {
+        auto submission = std::make_unique<Submission>();
+        submission->thread = &thread;
+        this->_submit(std::move(submission));
       }
     }
 
@@ -391,10 +679,12 @@ namespace elle
     Scheduler::_unfreeze(Thread& thread, std::string const& reason)
     {
       ELLE_ASSERT_EQ(thread.state(), Thread::State::frozen);
-      this->_frozen.erase(&thread);
-      this->_running.insert(&thread);
+      thread.unlink();
+      auto const idle = this->_running.empty() && this->_woken.empty();
+      this->_woken.push_back(thread);
+      thread._runnable_since = Clock::now();
       thread.unfrozen()(reason);
-      if (this->_running.size() == 1)
+      if (idle)
         this->_io_service.post([]{});
     }
 
@@ -409,26 +699,27 @@ namespace elle
     Scheduler::terminate()
     {
       ELLE_TRACE_SCOPE("%s: terminate", *this);
-      Threads terminated;
-      for (Thread* t: this->_starting)
+      while (!this->_starting.empty())
       {
+        auto& t = this->_starting.front();
+        this->_starting.pop_front();
         // Threads expect to be done when deleted. For this very
         // particuliar case, hack the state before deletion.
-        t->_state = Thread::State::done;
-        t->_scheduler_release();
+        t._state = Thread::State::done;
+        t._scheduler_release();
       }
-      this->_starting.clear();
-      for (Thread* t: Threads(this->_running))
-        if (t != this->_current)
-        {
-          t->terminate();
-          terminated.insert(t);
-        }
-      for (Thread* t: Threads(this->_frozen))
-      {
+      // Terminating threads moves them between queues: list them first.
+      Threads terminated;
+      for (auto& t: this->_running)
+        if (&t != this->_current)
+          terminated.emplace_back(&t);
+      for (auto& t: this->_woken)
+        if (&t != this->_current)
+          terminated.emplace_back(&t);
+      for (auto& t: this->_frozen)
+        terminated.emplace_back(&t);
+      for (auto t: terminated)
         t->terminate();
-        terminated.insert(t);
-      }
       return terminated;
     }
 
@@ -451,7 +742,7 @@ namespace elle
         throw Terminate(thread->name());
       }
       // If the underlying coroutine was never run, nothing to do.
-      else if (this->_starting.erase(thread))
+      else if (this->_discard_starting(*thread))
       {
         ELLE_DEBUG("thread was starting, discard it");
         thread->_state = Thread::State::done;
@@ -477,6 +768,23 @@ namespace elle
       return thread->state() == Thread::State::done;
     }
 
+    void
+    Scheduler::_queue_starting(Thread& thread)
+    {
+      thread._starting_batch = this->_starting_batch;
+      this->_starting.push_back(thread);
+    }
+
+    bool
+    Scheduler::_discard_starting(Thread& thread)
+    {
+      // Starting threads only leave the queue all at once, bumping the batch.
+      if (!thread.is_linked() || thread._starting_batch != this->_starting_batch)
+        return false;
+      thread.unlink();
+      return true;
+    }
+
     void
     Scheduler::_terminate_now(Thread* thread,
                               bool suicide)
@@ -530,7 +838,11 @@ namespace elle
     Scheduler::run_later(const std::string& name,
                          const std::function<void ()>&f)
     {
-      new Thread(*this, name, f, true);
+      if (this->_foreign())
+        this->_submit(name, f);
+      else
+        // Registering the Thread settles races with run() starting.
+        new Thread(*this, name, f, true);
     }
 
     void
@@ -550,54 +862,56 @@ namespace elle
     | Background jobs |
     `----------------*/
 
+    Scheduler::BackgroundPool&
+    Scheduler::_background_pool(BackgroundClass c) const
+    {
+      switch (c)
+      {
+        case BackgroundClass::cpu:
+          return *this->_background_cpu;
+        case BackgroundClass::blocking:
+          return *this->_background_blocking;
+      }
+      elle::unreachable();
+    }
+
     int
     Scheduler::background_pool_size() const
     {
-      return this->_background_pool.size();
+      return this->background_pool_size(BackgroundClass::cpu) +
+        this->background_pool_size(BackgroundClass::blocking);
+    }
+
+    int
+    Scheduler::background_pool_size(BackgroundClass c) const
+    {
+      return this->_background_pool(c).threads().size();
+    }
+
+    int
+    Scheduler::background_pool_max(BackgroundClass c) const
+    {
+      return this->_background_pool(c).max();
     }
 
     void
-    Scheduler::_run_background(std::function<std::function<void ()> ()> action)
+    Scheduler::background_pool_max(BackgroundClass c, int max)
     {
-      // FIXME: don't hardcode 16, sort out CPU-bound versus "blocking" use case
-      if (this->_background_pool_free == 0 && this->_background_pool.size() < 16)
-      {
-        ELLE_DEBUG("%s: spawn new background thread", *this);
-        this->_background_pool.emplace_back(
-          [this]
-          {
-            this->_background_service.run();
-          });
-      }
-      else
-        --this->_background_pool_free;
-      this->_background_service.post(
-        [this, action]
-        {
-          try
-          {
-            auto epilogue = elle::utility::move_on_copy(action());
-            this->_io_service.post(
-              [this, epilogue]
-              {
-                try
-                {
-                  (*epilogue)();
-                  ++this->_background_pool_free;
-                }
-                catch (...)
-                {
-                  ++this->_background_pool_free;
-                  throw;
-                }
-              });
-          }
-          catch (...)
-          {
-            ELLE_ABORT("background job threw: %s", elle::exception_string());
-          }
-        });
-      }
+      this->_background_pool(c).max(std::max(max, 1));
+    }
+
+    Scheduler::BackgroundStatistics
+    Scheduler::background_statistics(BackgroundClass c) const
+    {
+      return this->_background_pool(c).statistics();
+    }
+
+    void
+    Scheduler::_run_background(std::function<std::function<void ()> ()> action,
+                               BackgroundClass c)
+    {
+      this->_background_pool(c).post(std::move(action), this->_io_service);
+    }
 
     /*--------.
     | Signals |
@@ -651,14 +965,65 @@ namespace elle
     | Multithread API |
     `----------------*/
 
-    template <>
+    bool
+    Scheduler::_foreign() const
+    {
+      auto const running = this->_running_thread.load();
+      return running != std::thread::id() &&
+        running != std::this_thread::get_id();
+    }
+
     void
-    Scheduler::mt_run<void>(const std::string& name,
-                            const std::function<void ()>& action)
+    Scheduler::_submit(std::string const& name, std::function<void ()> action)
     {
-      ELLE_ASSERT_NEQ(this->_running_thread, std::this_thread::get_id());
-      // Bounce on the non-void case with a dummy int value.
-      this->mt_run<int>(name, [&] () { action(); return 42; });
+      auto submission = std::make_unique<Submission>();
+      submission->name = name;
+      submission->action = std::move(action);
+      this->_submit(std::move(submission));
+    }
+
+    void
+    Scheduler::_submit(std::unique_ptr<Submission> submission)
+    {
+      auto node = submission.release();
+      auto head = this->_submissions.load(std::memory_order_relaxed);
+      do
+        node->next = head;
+      while (!this->_submissions.compare_exchange_weak(
+               head, node,
+               std::memory_order_release, std::memory_order_relaxed));
+      // Only the first submission since the last drain wakes the scheduler,
+      // the drain picks up the whole batch.
+      if (!head)
+        this->_io_service.post([this] { this->_drain_submissions(); });
+    }
+
+    void
+    Scheduler::_drain_submissions()
+    {
+      auto head = this->_submissions.exchange(nullptr,
+                                              std::memory_order_acquire);
+      if (!head)
+        return;
+      // Reverse the stack, to start in submission order.
+      Submission* ordered = nullptr;
+      while (head)
+      {
+        auto next = head->next;
+        head->next = ordered;
+        ordered = head;
+        head = next;
+      }
+      while (ordered)
+      {
+        auto submission = std::unique_ptr<Submission>(ordered);
+        ordered = ordered->next;
+        if (submission->thread)
+          this->_queue_starting(*submission->thread);
+        else
+          new Thread(*this, submission->name,
+                     std::move(submission->action), true);
+      }
     }
 
     backend::Backend&
@@ -667,6 +1032,12 @@ namespace elle
       return *this->_manager;
     }
 
+    backend::StackStatistics
+    Scheduler::stack_statistics() const
+    {
+      return this->_manager->stack_statistics();
+    }
+
     /*---------------.
     | Free functions |
     `---------------*/
@@ -681,9 +1052,9 @@ namespace elle
     }
 
     void
-    background(std::function<void()> const& action)
+    background(std::function<void()> const& action, BackgroundClass c)
     {
-      BackgroundOperation<void> o(action);
+      BackgroundOperation<void> o(action, c);
       o.run();
     }
 
@@ -812,6 +1183,13 @@ namespace
     static CXAThreadMap _cxa_thread_map;
     return _cxa_thread_map;
   }
+
+  std::mutex&
+  cxa_thread_map_mutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
 }
 
 namespace __cxxabiv1
@@ -829,6 +1207,9 @@ namespace __cxxabiv1
         t = sched->manager().current();
       if (sched == nullptr)
       {
+        // Several system threads, e.g. the schedulers of a SchedulerPool or
+        // background jobs, may get here concurrently.
+        std::unique_lock<std::mutex> lock(cxa_thread_map_mutex());
         auto &res = map[std::this_thread::get_id()];
         if (!res)
           res.reset(new __cxa_eh_globals());
@@ -836,8 +1217,8 @@ namespace __cxxabiv1
       }
       if (t == nullptr)
       {
-        static auto* nullthread_ceg = new __cxa_eh_globals();
-        return nullthread_ceg;
+        static thread_local auto nullthread_ceg = __cxa_eh_globals();
+        return &nullthread_ceg;
       }
       auto* ceg = (__cxa_eh_globals*)t->exception_storage();
       return ceg;
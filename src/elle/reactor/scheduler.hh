@@ -1,13 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <thread>
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/identity.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/intrusive/list.hpp>
 #ifdef INFINIT_WINDOWS
 # include <winsock2.h>
 #endif
@@ -16,6 +15,8 @@
 
 #include <elle/Printable.hh>
 #include <elle/attribute.hh>
+#include <elle/json/fwd.hh>
+#include <elle/reactor/TimerWheel.hh>
 #include <elle/reactor/asio.hh>
 #include <elle/reactor/duration.hh>
 #include <elle/reactor/fwd.hh>
@@ -103,6 +104,34 @@ namespace elle
       /// state (see Thread::State).
       void
       dump_state();
+      /// Scheduling activity of the Scheduler.
+      struct Statistics
+      {
+        /// Number of rounds.
+        std::size_t rounds = 0;
+        /// Number of Thread steps.
+        std::size_t steps = 0;
+        /// Number of asio callbacks run.
+        std::size_t callbacks = 0;
+        /// Number of asio callbacks run by the last round.
+        std::size_t round_callbacks = 0;
+        /// Highest number of asio callbacks run by a round.
+        std::size_t max_round_callbacks = 0;
+        /// Number of steps exceeding the long step threshold.
+        std::size_t long_steps = 0;
+      };
+      ELLE_ATTRIBUTE_R(Statistics, statistics);
+      /// Steps lasting longer are counted and logged as warnings, since they
+      /// hold the whole event loop.
+      ///
+      /// Defaults to one second, or REACTOR_LONG_STEP_THRESHOLD in
+      /// milliseconds.
+      ELLE_ATTRIBUTE_RW(Duration, long_step_threshold);
+      /// Statistics of the Scheduler, its Threads and its background pools.
+      ///
+      /// Durations are in microseconds.
+      elle::json::Object
+      statistics_json() const;
 
     /*----.
     | Run |
@@ -126,13 +155,7 @@ namespace elle
     | Threads management |
     `-------------------*/
     public:
-      using Threads = boost::multi_index::multi_index_container<
-      Thread*,
-      boost::multi_index::indexed_by<
-        boost::multi_index::hashed_unique<boost::multi_index::identity<Thread*>>,
-        boost::multi_index::sequenced<>
-        >
-      >;
+      using Threads = std::vector<Thread*>;
       /// Return a pointer to the current Thread.
       ///
       /// @pre Being called from a Thread managed by a scheduler.
@@ -171,6 +194,14 @@ namespace elle
       /// @returns Whether the Thread is done.
       bool
       _terminate(Thread* thread);
+      /// Queue @a thread to start in the next round.
+      void
+      _queue_starting(Thread& thread);
+      /// Remove @a thread from the starting queue, if it is still there.
+      ///
+      /// @returns Whether the thread was starting.
+      bool
+      _discard_starting(Thread& thread);
       /// Terminate the given Thread and wait until it's done.
       ///
       /// If the given Thread is the current Thread and suicide is false, this
@@ -182,11 +213,29 @@ namespace elle
       void
       _terminate_now(Thread* thread,
                      bool suicide);
+      /// Queue of Threads, linked through their ThreadQueueHook so that state
+      /// changes neither allocate nor hash.
+      using Queue = boost::intrusive::list<
+        Thread,
+        boost::intrusive::base_hook<ThreadQueueHook>,
+        boost::intrusive::constant_time_size<false>>;
       ELLE_ATTRIBUTE(Thread*, current);
-      ELLE_ATTRIBUTE(Threads, starting);
+      /// Threads to start in the next round. While running, only touched from
+      /// the scheduler system thread: other system threads go through
+      /// submissions.
+      ELLE_ATTRIBUTE(Queue, starting);
+      /// Bumped whenever starting is moved to running: a linked Thread queued
+      /// in the current batch is still starting.
+      ELLE_ATTRIBUTE(std::size_t, starting_batch);
+      /// Guards starting while no system thread runs the scheduler, and the
+      /// running thread changes.
       ELLE_ATTRIBUTE(std::mutex, starting_mtx);
-      ELLE_ATTRIBUTE(Threads, running);
-      ELLE_ATTRIBUTE(Threads, frozen);
+      /// Threads scheduled for the current round.
+      ELLE_ATTRIBUTE(Queue, running);
+      /// Threads unfrozen during the current round, scheduled from the next
+      /// one.
+      ELLE_ATTRIBUTE(Queue, woken);
+      ELLE_ATTRIBUTE(Queue, frozen);
 
     /*-------------------------.
     | Thread Exception Handler |
@@ -200,6 +249,10 @@ namespace elle
     public:
       /// Allow for using the Scheduler in a multi-threaded environment.
       ///
+      /// Block the calling system thread until @a action has run in a Thread
+      /// of this scheduler.
+      ///
+      /// @pre Not being called from the scheduler system thread.
       /// @tparam R The return-type of the given function.
       /// @param name A descriptive name of Thread to be spawn.
       /// @param action The function to be run.
@@ -208,6 +261,38 @@ namespace elle
       R
       mt_run(std::string const& name,
              std::function<R ()> const& action);
+      /// Run @a action in a Thread of this scheduler, from any system thread,
+      /// without blocking.
+      ///
+      /// @tparam R The return-type of the given function.
+      /// @param name A descriptive name of Thread to be spawn.
+      /// @param action The function to be run.
+      /// @returns A future holding the result of invoking `action`, or the
+      ///          exception it threw.
+      template <typename R>
+      std::future<R>
+      mt_run_async(std::string const& name,
+                   std::function<R ()> const& action);
+    private:
+      /// Work submitted from other system threads.
+      struct Submission;
+      /// Whether the caller is another system thread than the running
+      /// scheduler's.
+      bool
+      _foreign() const;
+      /// Run @a action in a new Thread, from any system thread.
+      void
+      _submit(std::string const& name, std::function<void ()> action);
+      /// Queue @a submission, waking the scheduler if it is the first one
+      /// since the last drain.
+      void
+      _submit(std::unique_ptr<Submission> submission);
+      /// Start everything submitted from other system threads, in order.
+      void
+      _drain_submissions();
+      /// Lock-free stack of submissions, most recent first, pushed by any
+      /// system thread and drained at once by the scheduler.
+      ELLE_ATTRIBUTE(std::atomic<Submission*>, submissions);
 
     /*----------.
     | Printable |
@@ -222,6 +307,8 @@ namespace elle
     public:
       /// Run the given operation in the next cycle.
       ///
+      /// May be called from any system thread.
+      ///
       /// @param name A descriptive name of the operation, for debugging.
       /// @param f The operation to run later.
       void
@@ -241,16 +328,49 @@ namespace elle
     | Background jobs |
     `----------------*/
     public:
-      /// Number of threads spawned to run background jobs.
+      /// Activity of a background pool.
+      struct BackgroundStatistics
+      {
+        /// Number of system threads spawned.
+        int threads = 0;
+        /// Jobs waiting for a thread: the queue depth.
+        int queued = 0;
+        /// Jobs being run.
+        int running = 0;
+        /// Jobs completed.
+        std::size_t jobs = 0;
+        /// Cumulated time jobs spent waiting for a thread.
+        Duration wait_time;
+        /// Cumulated time jobs spent running.
+        Duration run_time;
+      };
+      /// Number of threads spawned to run background jobs, in all pools.
       int
       background_pool_size() const;
+      /// Number of threads spawned to run background jobs of class @a c.
+      int
+      background_pool_size(BackgroundClass c) const;
+      /// Maximum number of threads running background jobs of class @a c.
+      ///
+      /// Defaults to the number of cores for BackgroundClass::cpu and to 16,
+      /// or REACTOR_BACKGROUND_BLOCKING_MAX, for BackgroundClass::blocking.
+      int
+      background_pool_max(BackgroundClass c) const;
+      /// Set the maximum number of threads running background jobs of class
+      /// @a c. Spawned threads are kept if above.
+      void
+      background_pool_max(BackgroundClass c, int max);
+      /// Activity of the pool running background jobs of class @a c.
+      BackgroundStatistics
+      background_statistics(BackgroundClass c) const;
     private:
       template <typename T>
       friend class BackgroundOperation;
       /// Run function in a system thread. Run the result back in the scheduler.
       ///
-      /// It is guaranteed that a thread will immediately start executing the
-      /// action, spawning a new one if needed. The system thread runs freely,
+      /// The action is run by the pool of class @a c. A thread is spawned if
+      /// none is idle and the pool is below its maximum, otherwise the action
+      /// is queued until a thread is available. The system thread runs freely,
       /// all race condition issues apply, use at your own risks. The thread is
       /// joined upon destruction of the scheduler. The returned function is
       /// then run in the scheduler context.
@@ -260,15 +380,18 @@ namespace elle
       /// potentially non-pure epilogue in the non-parallel scheduler context.
       ///
       /// @param action The Action to run in a system thread.
+      /// @param c      The class of the action.
       void
-      _run_background(std::function<std::function<void ()> ()> action);
-      ELLE_ATTRIBUTE(boost::asio::io_service, background_service);
-      ELLE_ATTRIBUTE(std::unique_ptr<boost::asio::io_service::work>, background_service_work);
-      ELLE_ATTRIBUTE(std::vector<std::thread>, background_pool);
-      ELLE_ATTRIBUTE(int, background_pool_free);
+      _run_background(std::function<std::function<void ()> ()> action,
+                      BackgroundClass c = BackgroundClass::blocking);
+      class BackgroundPool;
+      BackgroundPool&
+      _background_pool(BackgroundClass c) const;
+      ELLE_ATTRIBUTE(std::unique_ptr<BackgroundPool>, background_cpu);
+      ELLE_ATTRIBUTE(std::unique_ptr<BackgroundPool>, background_blocking);
       friend
       void
-      background(std::function<void()> const& action);
+      background(std::function<void()> const& action, BackgroundClass c);
 
     /*--------.
     | Signals |
@@ -291,6 +414,16 @@ namespace elle
       ELLE_ATTRIBUTE_RX(boost::asio::io_service, io_service);
       ELLE_ATTRIBUTE(std::unique_ptr<boost::asio::io_service::work>, io_service_work);
 
+    /*-------.
+    | Timers |
+    `-------*/
+    public:
+      /// The wheel driving Sleep, wait timeouts, TimeoutGuard and Timer.
+      ///
+      /// Its resolution defaults to one millisecond and can be set with
+      /// REACTOR_TIMER_RESOLUTION, in milliseconds.
+      ELLE_ATTRIBUTE_RX(TimerWheel, timers);
+
     /*--------.
     | Details |
     `--------*/
@@ -300,10 +433,14 @@ namespace elle
       /// @returns Non-const reference to the manager.
       backend::Backend&
       manager();
+      /// Usage of the coroutine stacks: in use, pooled and high-water mark.
+      backend::StackStatistics
+      stack_statistics() const;
     private:
       friend class Thread;
       std::unique_ptr<backend::Backend> _manager;
-      std::thread::id _running_thread;
+      /// The system thread running the scheduler, read by other ones.
+      std::atomic<std::thread::id> _running_thread;
     };
 
     /*---------------.
@@ -316,8 +453,10 @@ namespace elle
     /// Run an action in a system thread and yield until completion.
     ///
     /// @param action The action to run in background.
+    /// @param c      The class of the action, selecting the pool running it.
     void
-    background(std::function<void()> const& action);
+    background(std::function<void()> const& action,
+               BackgroundClass c = BackgroundClass::blocking);
     /// Yield execution for this scheduler round.
     void
     yield();
@@ -1,4 +1,4 @@
-#include <condition_variable>
+#include <future>
 
 #include <elle/assert.hh>
 #include <elle/meta.hh>
@@ -15,46 +15,66 @@ namespace elle
     | Multithread API |
     `----------------*/
 
+    namespace _details
+    {
+      template <typename R>
+      void
+      fulfill(std::promise<R>& promise, std::function<R ()> const& action)
+      {
+        promise.set_value(action());
+      }
+
+      inline
+      void
+      fulfill(std::promise<void>& promise,
+              std::function<void ()> const& action)
+      {
+        action();
+        promise.set_value();
+      }
+    }
+
     template <typename R>
     R
     Scheduler::mt_run(const std::string& name,
                       const std::function<R ()>& action)
     {
       ELLE_ASSERT(!this->done());
-      R res;
-      std::mutex mutex;
-      std::condition_variable cond;
-      std::exception_ptr exn;
+      ELLE_ASSERT_NEQ(this->_running_thread.load(), std::this_thread::get_id());
+      auto res = this->mt_run_async(name, action);
+      try
       {
-        std::unique_lock<std::mutex> lock(mutex);
-        this->run_later(name, [&, action]
-                        {
-                          try
-                          {
-                            res = action();
-                          }
-                          catch (Terminate const&)
-                          {
-                            // Ignore
-                          }
-                          catch (...)
-                          {
-                            exn = std::current_exception();
-                          }
-                          std::unique_lock<std::mutex> lock(mutex);
-                          cond.notify_one();
-                        });
-        cond.wait(lock);
-        if (exn)
-          std::rethrow_exception(exn);
+        return res.get();
+      }
+      catch (Terminate const&)
+      {
+        // Ignore
+        return R();
       }
-      return res;
     }
 
-    template <>
-    void
-    Scheduler::mt_run<void>(const std::string& name,
-                            const std::function<void ()>& action);
+    template <typename R>
+    std::future<R>
+    Scheduler::mt_run_async(const std::string& name,
+                            const std::function<R ()>& action)
+    {
+      ELLE_ASSERT(!this->done());
+      // std::function requires copyable callables.
+      auto promise = std::make_shared<std::promise<R>>();
+      auto res = promise->get_future();
+      this->_submit(name, [promise, action]
+                    {
+                      try
+                      {
+                        _details::fulfill(*promise, action);
+                      }
+                      catch (...)
+                      {
+                        promise->set_exception(std::current_exception());
+                      }
+                    });
+      return res;
+    }
 
     class Waiter
       : public Barrier
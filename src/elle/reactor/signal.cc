@@ -4,6 +4,14 @@ namespace elle
 {
   namespace reactor
   {
+    Signal::Signal()
+      : Super()
+    {}
+
+    Signal::Signal(LiteralName name)
+      : Super(name)
+    {}
+
     Signal::Signal(const std::string& name)
       : Super(name)
     {}
@@ -30,7 +38,7 @@ namespace elle
     Signal::print(std::ostream& stream) const
     {
       stream << "signal ";
-      if (!this->name().empty())
+      if (*this->name())
         stream << this->name();
       else
         stream << this;
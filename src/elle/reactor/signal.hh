@@ -43,10 +43,16 @@ namespace elle
     public:
       using Self = elle::reactor::Signal;
       using Super = elle::reactor::Waitable;
-      /// Construct a signal.
+      /// Construct an unnamed signal.
+      Signal();
+      /// Construct a signal named by a string literal, without copying it.
       ///
       /// \param name A descriptive name of the Waitable, for debugging purpose.
-      Signal(const std::string& name = std::string());
+      Signal(LiteralName name);
+      /// Construct a signal with a copy of @a name.
+      ///
+      /// \param name A descriptive name of the Waitable, for debugging purpose.
+      Signal(const std::string& name);
       virtual
       ~Signal();
       Signal(Signal&&) = default;
@@ -80,7 +86,9 @@ namespace elle
     public:
       using Self = elle::reactor::Signal;
       using Super = elle::reactor::Waitable;
-      VSignal(std::string const& name = std::string());
+      VSignal();
+      VSignal(LiteralName name);
+      VSignal(std::string const& name);
       /// Set the value and signal.
       bool
       emit(V const& val);
@@ -4,6 +4,16 @@ namespace elle
 {
   namespace reactor
   {
+    template <typename V>
+    VSignal<V>::VSignal()
+      : Super()
+    {}
+
+    template <typename V>
+    VSignal<V>::VSignal(LiteralName name)
+      : Super(name)
+    {}
+
     template <typename V>
     VSignal<V>::VSignal(std::string const& name)
       : Super(name)
@@ -9,7 +9,7 @@ namespace elle
     Sleep::Sleep(Scheduler& scheduler, Duration d)
       : Operation(scheduler)
       , _duration(d)
-      , _timer(scheduler.io_service(), d)
+      , _timer()
     {}
 
     /*----------.
@@ -29,20 +29,11 @@ namespace elle
       _signal();
     }
 
-    void
-    Sleep::_wakeup(const boost::system::error_code& error)
-    {
-      if (error == boost::asio::error::operation_aborted)
-        return;
-      if (error)
-        _raise<Exception>(error.message());
-      _signal();
-    }
-
     void
     Sleep::_start()
     {
-      _timer.async_wait(boost::bind(&Sleep::_wakeup, this, _1));
+      this->sched().timers().arm(this->_timer, this->_duration,
+                                 [this] { this->_signal(); });
     }
   }
 }
@@ -1,7 +1,7 @@
 #pragma once
 
-# include <elle/reactor/asio.hh>
 # include <elle/reactor/Operation.hh>
+# include <elle/reactor/TimerWheel.hh>
 
 namespace elle
 {
@@ -47,10 +47,8 @@ namespace elle
       print(std::ostream& stream) const override;
 
     private:
-      void
-      _wakeup(const boost::system::error_code& error);
       Duration _duration;
-      boost::asio::deadline_timer _timer;
+      TimerWheel::Entry _timer;
     };
   }
 }
@@ -26,15 +26,11 @@ namespace elle
       : _scheduler(s)
       , _name(std::move(name))
       , _action(std::move(action))
-      , _timer(s.io_service())
+      , _timer()
       , _finished(false)
     {
-      _timer.expires_from_now(d);
       ELLE_TRACE_SCOPE("%s: trigger in %s", *this, d);
-      _timer.async_wait([this](const boost::system::error_code& erc)
-                        {
-                          this->_on_timer(erc);
-                        });
+      s.timers().arm(this->_timer, d, [this] { this->_on_timer(); });
     }
 
     Timer::~Timer()
@@ -43,37 +39,35 @@ namespace elle
     }
 
     void
-    Timer::_on_timer(const boost::system::error_code& erc)
+    Timer::_on_timer()
     {
-      ELLE_TRACE_SCOPE("%s: timer reached, canceled: %s", *this, !!erc);
+      ELLE_TRACE_SCOPE("%s: timer reached", *this);
       // Warning, we are not in a Thread!
-      if (!erc)
-      {
-        ELLE_TRACE("%s: start thread", *this);
-        _thread.reset(new Thread(_scheduler, _name,
-          [this]
-          {
-            ELLE_TRACE("%s: invoke callback", *this)
-              this->_action();
-          }));
-        _thread->released().connect([this]
-          {
-            ELLE_TRACE("%s: interrupted or finished, notify", *this);
-            this->_finished = true;
-            this->_signal();
-          });
-      }
-      else
-      {
-        this->_finished = true;
-        this->_signal();
-      }
+      ELLE_TRACE("%s: start thread", *this);
+      _thread.reset(new Thread(_scheduler, _name,
+        [this]
+        {
+          ELLE_TRACE("%s: invoke callback", *this)
+            this->_action();
+        }));
+      _thread->released().connect([this]
+        {
+          ELLE_TRACE("%s: interrupted or finished, notify", *this);
+          this->_finished = true;
+          this->_signal();
+        });
     }
 
     void
     Timer::cancel()
     {
-      this->_timer.cancel();
+      if (this->_timer.armed())
+      {
+        ELLE_TRACE("%s: canceled", *this);
+        this->_timer.cancel();
+        this->_finished = true;
+        this->_signal();
+      }
     }
 
     void
@@ -348,6 +348,44 @@ namespace elle
         ELLE_DEBUG("value: %s", res);
         return size;
       }
+
+      size_t
+      SerializerIn::serialize_number(elle::ConstWeakBuffer input,
+                                     int64_t& res)
+      {
+        auto const data = input.contents();
+        if (input.size() < 1)
+          err<Error>("unable to read number: empty input");
+        auto const c = data[0];
+        auto const size = number_size(c);
+        if (input.size() < size)
+          err<Error>("unable to read number: expected %s bytes, got %s",
+                     size, input.size());
+        int64_t value;
+        switch (size)
+        {
+          case 1:
+            value = c & 0x3f;
+            break;
+          case 2:
+            value = ((c & 0x1F) << 8) + data[1];
+            break;
+          case 3:
+            value = ((c & 0x0F) << 16) + (data[1] << 8) + data[2];
+            break;
+          default:
+            memcpy(&value, data + 1, 8);
+        }
+        res = (c & 0x80) ? - value : value;
+        ELLE_DUMP("deserialize %s from %s bytes", res, size);
+        return size;
+      }
+
+      size_t
+      SerializerIn::number_size(elle::Buffer::Byte c)
+      {
+        return !(c & 0x40) ? 1 : !(c & 0x20) ? 2 : !(c & 0x10) ? 3 : 9;
+      }
     }
   }
 }
@@ -98,6 +98,19 @@ namespace elle
         size_t
         serialize_number(std::istream& output,
                          int64_t& value);
+        /// Read a number from the beginning of @a input, without the overhead
+        /// of a stream.
+        ///
+        /// @returns The number of bytes consumed.
+        /// @throw Error if @a input is truncated.
+        static
+        size_t
+        serialize_number(elle::ConstWeakBuffer input,
+                         int64_t& value);
+        /// The size of a serialized number given its first byte.
+        static
+        size_t
+        number_size(elle::Buffer::Byte first);
         ELLE_ATTRIBUTE_R(std::istream&, input);
       private:
         int64_t _serialize_number();
@@ -68,6 +68,16 @@ namespace elle
 
       size_t
       SerializerOut::serialize_number(std::ostream& output,
+                                      int64_t n)
+      {
+        Buffer::Byte ser[number_max_size];
+        auto const size = serialize_number(ser, n);
+        output.write(reinterpret_cast<char const*>(ser), size);
+        return size;
+      }
+
+      size_t
+      SerializerOut::serialize_number(Buffer::Byte* ser,
                                       int64_t n_)
       {
         int64_t n = n_;
@@ -76,44 +86,32 @@ namespace elle
           n = -n;
         if (n <= 0x3f)
         { // sgn 0 val
-          unsigned char ser = (neg ? 0x80 : 0) + n;
-          ELLE_DUMP("serialize %s as 0x%02x", n_, int(ser));
-          output.write((const char*)&ser, 1);
+          ser[0] = (neg ? 0x80 : 0) + n;
+          ELLE_DUMP("serialize %s as 0x%02x", n_, int(ser[0]));
           return 1;
         }
         else if (n <= 0x1fff)
         { // sgn 1 0 val val2
-          unsigned char ser[2];
           ser[0] = (neg ? 0xC0 : 0x40) + (n >> 8);
           ser[1] = n;
           ELLE_DUMP("serialize %s as 0x%02x%02x", n_, int(ser[0]), int(ser[1]));
-          output.write((const char*)ser, 2);
           return 2;
         } // sgn 1 1 0 val val2 val3
         else if (n <= 0x0fffff)
         {
-          unsigned char ser[3];
           ser[0] = (neg ? 0xe0 : 0x60) + (n >> 16);
           ser[1] = n >> 8;
           ser[2] = n;
           ELLE_DUMP("serialize %s as 0x%02x%02x%02x",
                     n_, int(ser[0]), int(ser[1]), int(ser[2]));
-          output.write((const char*)ser, 3);
           return 3;
         }
         else
         {
-          unsigned char c = neg? 0xFF : 0x7F;
-          output.write((const char*)&c, 1);
-          output.write((const char*)(const void*)&n, 8);
-          ELLE_DUMP("serialize %s as 0x%02x%08x", n_, int(c), n);
-          return 9;
-          /*
-          unsigned char ser[9];
           ser[0] = neg? 0xFF : 0x7F;
-          for (int i=1; i<9; ++i)
-            ser[i] = n >> ((i-1)*8);
-          output.write((const char*)ser, 9);*/
+          memcpy(ser + 1, &n, 8);
+          ELLE_DUMP("serialize %s as 0x%02x%08x", n_, int(ser[0]), n);
+          return 9;
         }
       }
 
@@ -106,6 +106,16 @@ namespace elle
         size_t
         serialize_number(std::ostream& output,
                          int64_t number);
+        /// Maximum size of a serialized number.
+        static constexpr size_t number_max_size = 9;
+        /// Write a number to @a output, without the overhead of a stream.
+        ///
+        /// @param output Where to write, at least number_max_size bytes.
+        /// @returns The number of bytes written.
+        static
+        size_t
+        serialize_number(elle::Buffer::Byte* output,
+                         int64_t number);
         ELLE_ATTRIBUTE_R(std::ostream&, output);
       private:
         void
@@ -1,5 +1,7 @@
 #include <elle/serialization/json/SerializerIn.hh>
 
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 
 #include <elle/Backtrace.hh>
@@ -7,6 +9,7 @@
 #include <elle/finally.hh>
 #include <elle/format/base64.hh>
 #include <elle/json/exceptions.hh>
+#include <elle/json/parser.hh>
 #include <elle/memory.hh>
 #include <elle/meta.hh>
 #include <elle/printf.hh>
@@ -21,25 +24,727 @@ namespace elle
   {
     namespace json
     {
+      namespace
+      {
+        void
+        base64_decode(std::string const& str, elle::Buffer& buffer)
+        {
+          std::stringstream encoded(str);
+          elle::format::base64::Stream base64(encoded);
+          {
+            elle::IOStream output(buffer.ostreambuf());
+            std::copy(std::istreambuf_iterator<char>(base64),
+                      std::istreambuf_iterator<char>(),
+                      std::ostreambuf_iterator<char>(output));
+          }
+        }
+
+        void
+        iso8601_parse(std::string const& field,
+                      std::string const& str,
+                      boost::posix_time::ptime& time)
+        {
+          // Use the ISO extended input facet to interpret the string.
+          std::stringstream ss(str);
+          auto input_facet =
+            std::make_unique<boost::posix_time::time_input_facet>();
+          // ISO 8601
+          input_facet->format("%Y-%m-%dT%H:%M:%S%F");
+          ss.imbue(std::locale(ss.getloc(), input_facet.release()));
+          if (!(ss >> time))
+            throw FieldError(field,
+                             elle::sprintf("invalid ISO8601 date: %s", str));
+          // Check there isn't any leftover.
+          std::string leftover;
+          std::getline(ss, leftover);
+          if (leftover.empty())
+            return;
+          // Boost can't parse timezones, handle it manually.
+          if (leftover == "Z")
+            ; // Accept UTC suffix.
+          else if ((leftover[0] == '+' || leftover[0] == '-') &&
+                   leftover.size() == 5)
+          {
+            // Handle timezone.
+            std::stringstream tz(leftover);
+            int direction = tz.get() == '+' ? -1 : 1;
+            int amount;
+            tz >> amount;
+            if (tz.get() != -1)
+              throw FieldError(
+                field, elle::sprintf("garbage at end of date: %s", leftover));
+            time += boost::posix_time::hours(direction * amount / 100);
+          }
+          else
+            throw FieldError(
+              field, elle::sprintf("garbage at end of date: %s", leftover));
+          if (!ss.eof())
+          {
+            std::string leftover;
+            std::getline(ss, leftover);
+            throw FieldError(
+              field, elle::sprintf("garbage at end of date: %s", leftover));
+          }
+        }
+      }
+
+      /*-------.
+      | Reader |
+      `-------*/
+
+      /// Parse JSON values from the input text as they are deserialized.
+      ///
+      /// Every value being deserialized has a frame, pointing to its offset
+      /// in the text. Objects are indexed member by member, only as far as
+      /// needed to find the requested key: a key read in order is the next
+      /// one, while others are found back in the index.
+      class SerializerIn::Reader
+      {
+      public:
+        Reader(std::istream& input)
+          : _text(Reader::_value_text(input))
+          , _frames()
+          , _depth(0)
+        {
+          auto const start = this->_ws(0);
+          if (start == this->_text.size())
+            elle::err<Error>("json parse error: empty input");
+          this->_push(start, npos, npos);
+        }
+
+        /// Enter the member @a name of the current object.
+        ///
+        /// @param field The name of the current object, for errors.
+        /// @returns Whether the member exists, if @a partial.
+        bool
+        enter(std::string const& name, std::string const& field, bool partial)
+        {
+          auto const index = this->_find(this->_object(field), name);
+          if (index == npos)
+          {
+            if (partial)
+              return false;
+            throw MissingKey(name);
+          }
+          auto const& member = this->_top().members[index];
+          this->_push(member.begin, member.end, index);
+          return true;
+        }
+
+        void
+        leave()
+        {
+          ELLE_ASSERT_GT(this->_depth, 1u);
+          this->_pop();
+        }
+
+        /// Whether the current object has a member @a name.
+        bool
+        has(std::string const& name, std::string const& field)
+        {
+          return this->_find(this->_object(field), name) != npos;
+        }
+
+        /// Whether the current value is null.
+        bool
+        null()
+        {
+          auto& current = this->_top();
+          if (this->_data()[current.begin] != 'n')
+            return false;
+          current.end = this->_literal(current.begin, "null");
+          return true;
+        }
+
+        int64_t
+        integer(std::string const& field)
+        {
+          auto& current = this->_top();
+          auto const data = this->_data();
+          auto pos = current.begin;
+          auto const negative = data[pos] == '-';
+          if (negative)
+            ++pos;
+          if (!_digit(data[pos]))
+            this->_type_error(field, typeid(int64_t), current.begin);
+          auto value = uint64_t(0);
+          auto overflow = false;
+          for (; _digit(data[pos]); ++pos)
+          {
+            auto const digit = uint64_t(data[pos] - '0');
+            overflow = overflow ||
+              value > (std::numeric_limits<uint64_t>::max() - digit) / 10;
+            value = value * 10 + digit;
+          }
+          // Reals, or integers out of range, are not integers. Positive
+          // integers past the signed range wrap, and are read back as
+          // unsigned integers.
+          if (overflow ||
+              data[pos] == '.' || data[pos] == 'e' || data[pos] == 'E' ||
+              (negative && value > uint64_t(1) << 63))
+            throw TypeError(field, typeid(int64_t), typeid(double));
+          current.end = pos;
+          return negative ? -int64_t(value - 1) - 1 : int64_t(value);
+        }
+
+        double
+        real(std::string const& field)
+        {
+          auto& current = this->_top();
+          auto const kind = this->_kind(current.begin);
+          if (kind != Kind::integer && kind != Kind::real)
+            this->_type_error(field, typeid(double), current.begin);
+          auto const start = this->_data() + current.begin;
+          char* end = nullptr;
+          auto const res = std::strtod(start, &end);
+          current.end = current.begin + (end - start);
+          return res;
+        }
+
+        bool
+        boolean(std::string const& field)
+        {
+          auto& current = this->_top();
+          switch (this->_data()[current.begin])
+          {
+            case 't':
+              current.end = this->_literal(current.begin, "true");
+              return true;
+            case 'f':
+              current.end = this->_literal(current.begin, "false");
+              return false;
+            default:
+              this->_type_error(field, typeid(bool), current.begin);
+          }
+        }
+
+        std::string
+        string(std::string const& field)
+        {
+          auto& current = this->_top();
+          if (this->_data()[current.begin] != '"')
+            this->_type_error(field, typeid(std::string), current.begin);
+          auto res = std::string{};
+          current.end = this->_string(current.begin, res);
+          return res;
+        }
+
+        /// Deserialize every element of the current array with @a f.
+        void
+        array(std::string const& field, std::function<void ()> const& f)
+        {
+          auto const begin = this->_top().begin;
+          if (this->_data()[begin] != '[')
+            this->_type_error(field, typeid(elle::json::Array), begin);
+          auto pos = this->_ws(begin + 1);
+          if (this->_data()[pos] != ']')
+            while (true)
+            {
+              pos = this->_element(pos, f);
+              if (this->_data()[pos] == ']')
+                break;
+            }
+          this->_top().end = pos + 1;
+        }
+
+        /// Deserialize every member of the current object, or every pair of
+        /// the current array, with @a f.
+        void
+        dict(std::function<void (std::string const&)> const& f)
+        {
+          auto const begin = this->_top().begin;
+          auto const data = this->_data();
+          if (data[begin] == '{')
+            for (auto i = std::size_t(0); ; ++i)
+            {
+              auto& current = this->_top();
+              if (i == current.members.size() && !this->_next(current))
+                break;
+              auto const member = current.members[i];
+              this->_push(member.begin, member.end, i);
+              elle::SafeFinally pop([&] { this->_pop(); });
+              f(member.key);
+            }
+          else if (data[begin] == '[')
+          {
+            // Legacy representation as [[key, value], ...].
+            auto pos = this->_ws(begin + 1);
+            while (data[pos] != ']')
+            {
+              auto const end = this->_skip(pos);
+              auto key = std::string{};
+              auto p = pos;
+              if (data[p] == '[' && data[p = this->_ws(p + 1)] == '"' &&
+                  data[p = this->_ws(this->_string(p, key))] == ',')
+              {
+                auto const value = this->_ws(p + 1);
+                auto const value_end = this->_skip(value);
+                if (this->_ws(value_end) + 1 == end)
+                {
+                  this->_push(value, value_end, npos);
+                  elle::SafeFinally pop([&] { this->_pop(); });
+                  f(key);
+                }
+              }
+              pos = this->_separator(end, ']');
+            }
+            this->_top().end = pos + 1;
+          }
+        }
+
+      private:
+        enum class Kind
+        {
+          object,
+          array,
+          string,
+          boolean,
+          null,
+          integer,
+          real,
+        };
+
+        struct Member
+        {
+          std::string key;
+          /// The offset of the value.
+          std::size_t begin;
+          /// The offset past the value, npos until known.
+          std::size_t end;
+        };
+
+        struct Frame
+        {
+          /// The offset of the value.
+          std::size_t begin;
+          /// The offset past the value, npos until known.
+          std::size_t end;
+          /// The index of the value in its parent object, if any.
+          std::size_t origin;
+          /// The members of the object indexed so far.
+          std::vector<Member> members;
+          /// Whether all the members of the object are indexed.
+          bool complete;
+          /// Where to look up the next key.
+          std::size_t hint;
+        };
+
+        static std::size_t constexpr npos = std::string::npos;
+
+        char const*
+        _data() const
+        {
+          return this->_text.c_str();
+        }
+
+        Frame&
+        _top()
+        {
+          return this->_frames[this->_depth - 1];
+        }
+
+        /// Push a frame for the value at @a begin. Frames are reused to
+        /// keep their member index allocated.
+        void
+        _push(std::size_t begin, std::size_t end, std::size_t origin)
+        {
+          if (this->_depth == this->_frames.size())
+            this->_frames.emplace_back();
+          auto& frame = this->_frames[this->_depth++];
+          frame.begin = begin;
+          frame.end = end;
+          frame.origin = origin;
+          frame.members.clear();
+          frame.complete = false;
+          frame.hint = 0;
+        }
+
+        /// Pop the current frame, saving where its value ends in its parent.
+        void
+        _pop()
+        {
+          auto const& frame = this->_top();
+          if (frame.end != npos && frame.origin != npos)
+            this->_frames[this->_depth - 2].members[frame.origin].end =
+              frame.end;
+          --this->_depth;
+        }
+
+        /// The current value, which must be an object.
+        Frame&
+        _object(std::string const& field)
+        {
+          auto& current = this->_top();
+          if (this->_data()[current.begin] != '{')
+            this->_type_error(field, typeid(elle::json::Object), current.begin);
+          return current;
+        }
+
+        /// The index of the member @a name of @a object, or npos.
+        std::size_t
+        _find(Frame& object, std::string const& name)
+        {
+          auto& members = object.members;
+          auto const found = [&] (std::size_t i)
+            {
+              object.hint = i + 1;
+              return i;
+            };
+          // The same key again, like versions.
+          if (object.hint && members[object.hint - 1].key == name)
+            return object.hint - 1;
+          // The next keys, when read in order.
+          for (auto i = object.hint; i < members.size(); ++i)
+            if (members[i].key == name)
+              return found(i);
+          while (this->_next(object))
+            if (members.back().key == name)
+              return found(members.size() - 1);
+          // Keys read out of order.
+          for (auto i = std::size_t(0); i < object.hint; ++i)
+            if (members[i].key == name)
+              return found(i);
+          return npos;
+        }
+
+        /// Index the next member of @a object.
+        ///
+        /// @returns Whether there was one.
+        bool
+        _next(Frame& object)
+        {
+          if (object.complete)
+            return false;
+          auto pos = std::size_t(0);
+          if (object.members.empty())
+            pos = this->_ws(object.begin + 1);
+          else
+          {
+            auto& last = object.members.back();
+            if (last.end == npos)
+              last.end = this->_skip(last.begin);
+            pos = this->_separator(last.end, '}');
+          }
+          auto const data = this->_data();
+          if (data[pos] == '}')
+          {
+            object.complete = true;
+            object.end = pos + 1;
+            return false;
+          }
+          if (data[pos] != '"')
+            this->_error(pos, "expected a key");
+          auto member = Member{std::string(), npos, npos};
+          pos = this->_ws(this->_string(pos, member.key));
+          if (data[pos] != ':')
+            this->_error(pos, "expected ':'");
+          member.begin = this->_ws(pos + 1);
+          object.members.emplace_back(std::move(member));
+          return true;
+        }
+
+        /// Deserialize the array element at @a pos with @a f.
+        ///
+        /// @returns The offset of the next element, or of the closing
+        ///          bracket.
+        std::size_t
+        _element(std::size_t pos, std::function<void ()> const& f)
+        {
+          this->_push(pos, npos, npos);
+          {
+            elle::SafeFinally pop([&] { this->_pop(); });
+            f();
+            auto& element = this->_top();
+            if (element.end == npos)
+              element.end = this->_skip(element.begin);
+            pos = element.end;
+          }
+          return this->_separator(pos, ']');
+        }
+
+        /// Skip the separator after a value ending at @a pos.
+        ///
+        /// @returns The offset of the next value, or of the @a closing
+        ///          character.
+        std::size_t
+        _separator(std::size_t pos, char closing)
+        {
+          pos = this->_ws(pos);
+          auto const c = this->_data()[pos];
+          if (c == ',')
+          {
+            // Trailing commas are tolerated, like json_spirit does.
+            return this->_ws(pos + 1);
+          }
+          if (c != closing)
+            this->_error(pos, elle::sprintf("expected ',' or '%s'", closing));
+          return pos;
+        }
+
+        std::size_t
+        _ws(std::size_t pos) const
+        {
+          auto const data = this->_data();
+          while (data[pos] == ' ' || data[pos] == '\n' ||
+                 data[pos] == '\r' || data[pos] == '\t')
+            ++pos;
+          return pos;
+        }
+
+        /// The offset past the value at @a pos.
+        std::size_t
+        _skip(std::size_t pos)
+        {
+          auto const data = this->_data();
+          switch (data[pos])
+          {
+            case '"':
+              return this->_string_end(pos);
+            case '{':
+            case '[':
+            {
+              auto depth = 0;
+              while (true)
+              {
+                switch (data[pos])
+                {
+                  case '"':
+                    pos = this->_string_end(pos);
+                    continue;
+                  case '{':
+                  case '[':
+                    ++depth;
+                    break;
+                  case '}':
+                  case ']':
+                    if (!--depth)
+                      return pos + 1;
+                    break;
+                  case '\0':
+                    if (pos == this->_text.size())
+                      this->_error(pos, "unexpected end of input");
+                }
+                ++pos;
+              }
+            }
+            case 't':
+              return this->_literal(pos, "true");
+            case 'f':
+              return this->_literal(pos, "false");
+            case 'n':
+              return this->_literal(pos, "null");
+            default:
+            {
+              auto real = false;
+              return this->_number_end(pos, real);
+            }
+          }
+        }
+
+        static
+        bool
+        _digit(char c)
+        {
+          return c >= '0' && c <= '9';
+        }
+
+        std::size_t
+        _literal(std::size_t pos, char const* literal)
+        {
+          auto const size = std::strlen(literal);
+          if (this->_text.compare(pos, size, literal) != 0)
+            this->_error(pos, elle::sprintf("expected %s", literal));
+          return pos + size;
+        }
+
+        std::size_t
+        _number_end(std::size_t pos, bool& real)
+        {
+          auto const data = this->_data();
+          auto const start = pos;
+          if (data[pos] == '-')
+            ++pos;
+          auto const digits = pos;
+          while (_digit(data[pos]))
+            ++pos;
+          if (pos == digits)
+            this->_error(start, "expected a value");
+          real = false;
+          if (data[pos] == '.')
+          {
+            real = true;
+            ++pos;
+            while (_digit(data[pos]))
+              ++pos;
+          }
+          if (data[pos] == 'e' || data[pos] == 'E')
+          {
+            real = true;
+            ++pos;
+            if (data[pos] == '+' || data[pos] == '-')
+              ++pos;
+            while (_digit(data[pos]))
+              ++pos;
+          }
+          return pos;
+        }
+
+        /// The offset past the string at @a pos, without decoding it.
+        std::size_t
+        _string_end(std::size_t pos)
+        {
+          auto const data = this->_data();
+          auto const end = data + this->_text.size();
+          auto p = data + pos + 1;
+          while (true)
+          {
+            p = elle::json::parser::string_special(p, end);
+            if (p == end)
+              this->_error(pos, "unterminated string");
+            if (*p++ == '"')
+              return p - data;
+            if (p++ == end)
+              this->_error(pos, "unterminated string");
+          }
+        }
+
+        /// The text of the next value in @a input, leaving what follows it
+        /// so sockets and multi-document streams are not read past it.
+        static
+        std::string
+        _value_text(std::istream& input)
+        {
+          if (!input.rdbuf())
+            elle::err<Error>("json parse error: no input");
+          try
+          {
+            return elle::json::parser::frame(input);
+          }
+          catch (elle::json::ParseError const& e)
+          {
+            Error exception("json parse error");
+            exception.inner_exception(std::current_exception());
+            throw exception;
+          }
+        }
+
+        /// Decode the string at @a pos into @a res.
+        ///
+        /// @returns The offset past the string.
+        std::size_t
+        _string(std::size_t pos, std::string& res)
+        {
+          auto const data = this->_data();
+          try
+          {
+            return elle::json::parser::unescape(
+              data + pos + 1, data + this->_text.size(), res) - data;
+          }
+          catch (elle::json::ParseError const& e)
+          {
+            this->_error(pos, elle::sprintf("invalid string (%s)", e.what()));
+          }
+        }
+
+        /// The kind of the value at @a pos.
+        Kind
+        _kind(std::size_t pos)
+        {
+          switch (this->_data()[pos])
+          {
+            case '{':
+              return Kind::object;
+            case '[':
+              return Kind::array;
+            case '"':
+              return Kind::string;
+            case 't':
+            case 'f':
+              return Kind::boolean;
+            case 'n':
+              return Kind::null;
+            default:
+            {
+              auto real = false;
+              this->_number_end(pos, real);
+              return real ? Kind::real : Kind::integer;
+            }
+          }
+        }
+
+        ELLE_COMPILER_ATTRIBUTE_NORETURN
+        void
+        _type_error(std::string const& field,
+                    std::type_info const& expected,
+                    std::size_t pos)
+        {
+          auto const& effective = [&] () -> std::type_info const&
+            {
+              switch (this->_kind(pos))
+              {
+                case Kind::object:
+                  return typeid(elle::json::Object);
+                case Kind::array:
+                  return typeid(elle::json::Array);
+                case Kind::string:
+                  return typeid(std::string);
+                case Kind::boolean:
+                  return typeid(bool);
+                case Kind::null:
+                  return typeid(elle::json::NullType);
+                case Kind::integer:
+                  return typeid(int64_t);
+                case Kind::real:
+                  return typeid(double);
+              }
+              elle::unreachable();
+            }();
+          throw TypeError(field, expected, effective);
+        }
+
+        ELLE_COMPILER_ATTRIBUTE_NORETURN
+        void
+        _error(std::size_t pos, std::string const& message)
+        {
+          elle::err<Error>("json parse error: %s at offset %s", message, pos);
+        }
+
+        /// The whole input, null terminated.
+        std::string _text;
+        std::vector<Frame> _frames;
+        /// The number of frames in use.
+        std::size_t _depth;
+      };
+
+      std::size_t constexpr SerializerIn::Reader::npos;
+
       /*-------------.
       | Construction |
       `-------------*/
 
       SerializerIn::SerializerIn(std::istream& input,
-                                 bool versioned)
+                                 bool versioned,
+                                 bool stream)
         : Super(versioned)
         , _partial(false)
       {
-        this->_load_json(input);
+        if (stream)
+          this->_reader = std::make_unique<Reader>(input);
+        else
+          this->_load_json(input);
       }
 
       SerializerIn::SerializerIn(std::istream& input,
                                  Versions versions,
-                                 bool versioned)
+                                 bool versioned,
+                                 bool stream)
         : Super(std::move(versions), versioned)
         , _partial(false)
       {
-        this->_load_json(input);
+        if (stream)
+          this->_reader = std::make_unique<Reader>(input);
+        else
+          this->_load_json(input);
       }
 
       SerializerIn::SerializerIn(elle::json::Json input, bool versioned)
@@ -50,6 +755,11 @@ namespace elle
         this->_current.push_back(&this->_json);
       }
 
+      SerializerIn::SerializerIn(SerializerIn&&) = default;
+
+      SerializerIn::~SerializerIn()
+      {}
+
       void
       SerializerIn::_load_json(std::istream& input)
       {
@@ -69,7 +779,10 @@ namespace elle
       void
       SerializerIn::_serialize(int64_t& v)
       {
-        v = this->_check_type<int64_t>();
+        if (this->_reader)
+          v = this->_reader->integer(this->current_name());
+        else
+          v = this->_check_type<int64_t>();
       }
 
       void
@@ -153,13 +866,19 @@ namespace elle
       void
       SerializerIn::_serialize(double& v)
       {
-        v = this->_check_type<double, int64_t>();
+        if (this->_reader)
+          v = this->_reader->real(this->current_name());
+        else
+          v = this->_check_type<double, int64_t>();
       }
 
       void
       SerializerIn::_serialize(bool& v)
       {
-        v = this->_check_type<bool>();
+        if (this->_reader)
+          v = this->_reader->boolean(this->current_name());
+        else
+          v = this->_check_type<bool>();
       }
 
       void
@@ -167,9 +886,10 @@ namespace elle
                                             bool,
                                             std::function<void ()> const& f)
       {
-        auto& object = this->_check_type<elle::json::Object>();
-        auto it = object.find(name);
-        if (it != object.end())
+        auto const filled = this->_reader ?
+          this->_reader->has(name, this->current_name()) :
+          this->_check_type<elle::json::Object>().count(name);
+        if (filled)
           f();
         else
           ELLE_DEBUG("skip option as JSON key is missing");
@@ -179,7 +899,10 @@ namespace elle
       SerializerIn::_serialize_option(bool,
                                       std::function<void ()> const& f)
       {
-        if (this->_current.back()->type() != typeid(elle::json::NullType))
+        auto const null = this->_reader ?
+          this->_reader->null() :
+          this->_current.back()->type() == typeid(elle::json::NullType);
+        if (!null)
           f();
         else
           ELLE_DEBUG("skip option as JSON value is null");
@@ -188,70 +911,30 @@ namespace elle
       void
       SerializerIn::_serialize(std::string& v)
       {
-        v = this->_check_type<std::string>();
+        if (this->_reader)
+          v = this->_reader->string(this->current_name());
+        else
+          v = this->_check_type<std::string>();
       }
 
       void
       SerializerIn::_serialize(elle::Buffer& buffer)
       {
-        auto& str = this->_check_type<std::string>();
-        std::stringstream encoded(str);
-        elle::format::base64::Stream base64(encoded);
-        {
-          elle::IOStream output(buffer.ostreambuf());
-          std::copy(std::istreambuf_iterator<char>(base64),
-                    std::istreambuf_iterator<char>(),
-                    std::ostreambuf_iterator<char>(output));
-        }
+        if (this->_reader)
+          base64_decode(this->_reader->string(this->current_name()), buffer);
+        else
+          base64_decode(this->_check_type<std::string>(), buffer);
       }
 
       void
       SerializerIn::_serialize(boost::posix_time::ptime& time)
       {
-        auto& str = this->_check_type<std::string>();
-        // Use the ISO extended input facet to interpret the string.
-        std::stringstream ss(str);
-        auto input_facet =
-          std::make_unique<boost::posix_time::time_input_facet>();
-        // ISO 8601
-        input_facet->format("%Y-%m-%dT%H:%M:%S%F");
-        ss.imbue(std::locale(ss.getloc(), input_facet.release()));
-        if (!(ss >> time))
-          throw FieldError(this->current_name(),
-                           elle::sprintf("invalid ISO8601 date: %s", str));
-        // Check there isn't any leftover.
-        std::string leftover;
-        std::getline(ss, leftover);
-        if (leftover.empty())
-          return;
-        // Boost can't parse timezones, handle it manually.
-        if (leftover == "Z")
-          ; // Accept UTC suffix.
-        else if ((leftover[0] == '+' || leftover[0] == '-') && leftover.size() == 5)
-        {
-          // Handle timezone.
-          std::stringstream tz(leftover);
-          int direction = tz.get() == '+' ? -1 : 1;
-          int amount;
-          tz >> amount;
-          if (tz.get() != -1)
-            throw FieldError(
-              this->current_name(),
-              elle::sprintf("garbage at end of date: %s", leftover));
-          time += boost::posix_time::hours(direction * amount / 100);
-        }
+        if (this->_reader)
+          iso8601_parse(this->current_name(),
+                        this->_reader->string(this->current_name()), time);
         else
-          throw FieldError(
-            this->current_name(),
-            elle::sprintf("garbage at end of date: %s", leftover));
-        if (!ss.eof())
-        {
-          std::string leftover;
-          std::getline(ss, leftover);
-          throw FieldError(
-            this->current_name(),
-            elle::sprintf("garbage at end of date: %s", leftover));
-        }
+          iso8601_parse(this->current_name(),
+                        this->_check_type<std::string>(), time);
       }
 
       void
@@ -259,13 +942,18 @@ namespace elle
                                              std::int64_t& num,
                                              std::int64_t& denom)
       {
-        auto const repr = this->_check_type<std::string>();
+        auto const repr = this->_reader ?
+          this->_reader->string(this->current_name()) :
+          this->_check_type<std::string>();
         elle::chrono::duration_parse(repr, ticks, num, denom);
       }
 
       bool
       SerializerIn::_enter(std::string const& name)
       {
+        if (this->_reader)
+          return this->_reader->enter(
+            name, this->current_name(), this->_partial);
         auto& object = this->_check_type<elle::json::Object>();
         auto it = object.find(name);
         if (it == object.end())
@@ -283,6 +971,8 @@ namespace elle
       void
       SerializerIn::_leave(std::string const& name)
       {
+        if (this->_reader)
+          return this->_reader->leave();
         this->_current.pop_back();
       }
 
@@ -291,6 +981,8 @@ namespace elle
         int size,
         std::function<void ()> const& serialize_element)
       {
+        if (this->_reader)
+          return this->_reader->array(this->current_name(), serialize_element);
         auto& array = this->_check_type<elle::json::Array>();
         for (auto& elt: array)
         {
@@ -304,6 +996,8 @@ namespace elle
       SerializerIn::_deserialize_dict_key(
         std::function<void (std::string const&)> const& f)
       {
+        if (this->_reader)
+          return this->_reader->dict(f);
         auto& current = *this->_current.back();
         if (current.type() == typeid(elle::json::Object))
         {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include <elle/json/json.hh>
 #include <elle/serialization/SerializerIn.hh>
 
@@ -12,6 +14,13 @@ namespace elle
       /// A specialized SerializerIn for JSON.
       ///
       /// Deserialize objects from their JSON representations.
+      ///
+      /// By default, the whole input is parsed into a JSON object first. In
+      /// stream mode, values are parsed directly from the input text as they
+      /// are deserialized instead: each object is indexed as far as needed
+      /// to find the requested keys, so keys in the expected order are read
+      /// in a single pass and others are found back from their offset.
+      /// Malformed JSON is then only detected when reached.
       class ELLE_API SerializerIn
         : public serialization::SerializerIn
       {
@@ -29,18 +38,28 @@ namespace elle
         /// Construct a SerializerIn for JSON.
         ///
         /// @see elle::serialization::SerializerIn.
-        SerializerIn(std::istream& input, bool versioned = true);
+        ///
+        /// @param stream Whether to parse the JSON as it is deserialized.
+        SerializerIn(std::istream& input,
+                     bool versioned = true,
+                     bool stream = false);
         /// Construct a SerializerIn for JSON.
         ///
         /// @see elle::serialization::SerializerIn.
+        ///
+        /// @param stream Whether to parse the JSON as it is deserialized.
         SerializerIn(std::istream& input,
-                     Versions versions, bool versioned = true);
+                     Versions versions,
+                     bool versioned = true,
+                     bool stream = false);
         /// Construct a SerializerIn from a JSON object.
         ///
         /// @param input A json object.
         /// @param versioned Whether the Serializer will read the version of
         ///                  objects.
         SerializerIn(elle::json::Json input, bool versioned = true);
+        SerializerIn(SerializerIn&&);
+        ~SerializerIn();
       private:
         void
         _load_json(std::istream& input);
@@ -114,6 +133,9 @@ namespace elle
         template <typename T>
         void
         _serialize_int(T& v);
+        class Reader;
+        /// The JSON parser, in stream mode.
+        ELLE_ATTRIBUTE(std::unique_ptr<Reader>, reader);
       };
     }
   }
@@ -1,5 +1,10 @@
 #include <elle/serialization/json/SerializerOut.hh>
 
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 #include <elle/Lazy.hh>
 #include <elle/assert.hh>
 #include <elle/format/base64.hh>
@@ -15,16 +20,396 @@ namespace elle
   {
     namespace json
     {
+      namespace
+      {
+        std::string
+        base64(elle::Buffer const& buffer)
+        {
+          std::stringstream encoded;
+          {
+            elle::format::base64::Stream base64(encoded);
+            base64.write(reinterpret_cast<char const*>(buffer.contents()),
+                         buffer.size());
+          }
+          return encoded.str();
+        }
+
+        std::string
+        iso8601(boost::posix_time::ptime const& time)
+        {
+          std::stringstream ss;
+          auto output_facet =
+            std::make_unique<boost::posix_time::time_facet>();
+          // ISO 8601
+          output_facet->format("%Y-%m-%dT%H:%M:%S%F%q");
+          ss.imbue(std::locale(ss.getloc(), output_facet.release()));
+          ss << time;
+          return ss.str();
+        }
+
+        std::string
+        duration(std::int64_t ticks, std::int64_t num, std::int64_t denom)
+        {
+          auto const num_ = num;
+          auto const denom_ = denom;
+          auto order = 3;
+          while (denom % 1000 == 0)
+          {
+            denom /= 1000;
+            if (ticks % 1000 == 0)
+              ticks /= 1000;
+            else
+              ++order;
+          }
+          if (denom != 1)
+            if (1000 % denom == 0)
+            {
+              num *= 1000 / denom;
+              denom *= 1;
+              ++order;
+            }
+            else
+              ELLE_ABORT("cannot safely represent time with ratio %s:%s",
+                         num_, denom_);
+          ELLE_ASSERT_EQ(denom, 1);
+          char orders[][9] =
+            {"d", "h", "min", "s", "ms", "us", "ns", "ps", "fs"};
+          if (order >= 9)
+            ELLE_ABORT("cannot safely represent time with ratio %s:%s",
+                       num_, denom_);
+          ticks *= num;
+          if (order == 3)
+          {
+            if (ticks % 60 == 0)
+            {
+              ticks /= 60;
+              --order;
+              if (ticks % 60 == 0)
+              {
+                ticks /= 60;
+                --order;
+                if (ticks % 24 == 0)
+                {
+                  ticks /= 24;
+                  --order;
+                }
+              }
+            }
+          }
+          return elle::sprintf("%s%s", ticks, orders[order]);
+        }
+      }
+
+      /*-------.
+      | Writer |
+      `-------*/
+
+      /// Write JSON tokens as values are serialized.
+      ///
+      /// Every value being serialized has a frame, whose key is only written
+      /// along with the value. This way, omitted options are dropped without
+      /// ever being written, and commas only separate written values.
+      class SerializerOut::Writer
+      {
+      public:
+        Writer(std::ostream& output, bool pretty)
+          : _output(output)
+          , _pretty(pretty)
+          , _frames(1)
+        {
+          this->_buffer.reserve(buffer_size);
+        }
+
+        /// Enter a member of an object, or an element of an array.
+        ///
+        /// @returns Whether to serialize it, false for a duplicate version.
+        bool
+        enter(std::string const& name)
+        {
+          auto& current = this->_frames.back();
+          switch (current.kind)
+          {
+            case Kind::pending:
+              this->_open(Kind::object);
+              this->_buffer += '{';
+              // fallthrough
+            case Kind::object:
+              // FIXME: hackish way to not serialize version twice when
+              // serialize_forward is used.
+              if (name == ".version")
+              {
+                if (current.version)
+                  return false;
+                current.version = true;
+              }
+              this->_frames.emplace_back(name, true);
+              break;
+            case Kind::array:
+              this->_frames.emplace_back(std::string(), false);
+              break;
+            case Kind::scalar:
+              ELLE_ABORT("cannot serialize a composite and a fundamental "
+                         "object in key %s", name);
+          }
+          return true;
+        }
+
+        void
+        leave()
+        {
+          ELLE_ASSERT_GT(this->_frames.size(), 1u);
+          this->_close();
+          this->_frames.pop_back();
+        }
+
+        void
+        array()
+        {
+          this->_open(Kind::array);
+          this->_buffer += '[';
+        }
+
+        /// Drop the current value if it is a member, as if never entered.
+        void
+        omit()
+        {
+          auto const size = this->_frames.size();
+          if (size > 1 && this->_frames[size - 2].kind == Kind::object)
+            this->_frames.back().omitted = true;
+          else
+            this->null();
+        }
+
+        void
+        null()
+        {
+          this->_open(Kind::scalar);
+          this->_buffer += "null";
+        }
+
+        void
+        value(int64_t v)
+        {
+          char digits[24];
+          this->_scalar(
+            digits, std::snprintf(digits, sizeof(digits), "%" PRId64, v));
+        }
+
+        void
+        value(uint64_t v)
+        {
+          char digits[24];
+          this->_scalar(
+            digits, std::snprintf(digits, sizeof(digits), "%" PRIu64, v));
+        }
+
+        void
+        value(double v)
+        {
+          // The shortest of the two precisions that reads back exactly.
+          char digits[32];
+          auto size = std::snprintf(digits, sizeof(digits), "%.15g", v);
+          if (std::strtod(digits, nullptr) != v)
+            size = std::snprintf(digits, sizeof(digits), "%.17g", v);
+          // Keep the number a real number.
+          if (!std::strpbrk(digits, ".eani"))
+            digits[size++] = '.', digits[size++] = '0';
+          this->_scalar(digits, size);
+        }
+
+        void
+        value(bool v)
+        {
+          this->_open(Kind::scalar);
+          this->_buffer += v ? "true" : "false";
+        }
+
+        void
+        value(std::string const& v)
+        {
+          this->_open(Kind::scalar);
+          this->_string(v);
+        }
+
+        /// Close every value and flush the output.
+        void
+        finish()
+        {
+          while (this->_frames.size() > 1)
+            this->leave();
+          this->_close();
+          if (!this->_pretty)
+            this->_buffer += '\n';
+          this->_flush(true);
+          this->_output.flush();
+        }
+
+      private:
+        enum class Kind
+        {
+          /// Nothing written yet.
+          pending,
+          scalar,
+          object,
+          array,
+        };
+
+        struct Frame
+        {
+          Frame(std::string key = {}, bool keyed = false)
+            : kind(Kind::pending)
+            , key(std::move(key))
+            , keyed(keyed)
+            , omitted(false)
+            , version(false)
+            , count(0)
+          {}
+
+          Kind kind;
+          /// The member name, if keyed.
+          std::string key;
+          /// Whether the value is a member of an object.
+          bool keyed;
+          /// Whether the value is an omitted option.
+          bool omitted;
+          /// Whether the version was serialized in this object.
+          bool version;
+          /// The number of values written in this object or array.
+          int count;
+        };
+
+        /// The amount of output buffered before writing to the stream.
+        static std::size_t constexpr buffer_size = 1 << 16;
+
+        /// Start writing the current value, as @a kind.
+        void
+        _open(Kind kind)
+        {
+          auto& current = this->_frames.back();
+          if (current.kind != Kind::pending)
+            ELLE_ABORT("serializing in-place to an already filled object");
+          current.kind = kind;
+          auto const depth = this->_frames.size() - 1;
+          if (!depth)
+            return;
+          if (this->_frames[depth - 1].count++)
+            this->_buffer += ',';
+          this->_indent(depth);
+          if (current.keyed)
+          {
+            this->_string(current.key);
+            this->_buffer += this->_pretty ? " : " : ":";
+          }
+        }
+
+        /// Finish writing the current value.
+        void
+        _close()
+        {
+          auto& current = this->_frames.back();
+          switch (current.kind)
+          {
+            case Kind::pending:
+              // Entered but never filled, like an empty map.
+              if (!current.omitted)
+                this->null();
+              break;
+            case Kind::scalar:
+              break;
+            case Kind::object:
+            case Kind::array:
+              if (current.count)
+                this->_indent(this->_frames.size() - 1);
+              this->_buffer += current.kind == Kind::object ? '}' : ']';
+              break;
+          }
+          this->_flush(false);
+        }
+
+        void
+        _indent(std::size_t depth)
+        {
+          if (this->_pretty)
+          {
+            this->_buffer += '\n';
+            this->_buffer.append(4 * depth, ' ');
+          }
+        }
+
+        void
+        _scalar(char const* data, int size)
+        {
+          this->_open(Kind::scalar);
+          this->_buffer.append(data, size);
+        }
+
+        /// Write @a s as a quoted and escaped JSON string.
+        void
+        _string(std::string const& s)
+        {
+          static char const hex[] = "0123456789abcdef";
+          this->_buffer += '"';
+          auto start = s.data();
+          auto const end = start + s.size();
+          for (auto it = start; it != end; ++it)
+          {
+            auto const c = static_cast<unsigned char>(*it);
+            if (c >= 0x20 && c != '"' && c != '\\')
+              continue;
+            this->_buffer.append(start, it);
+            start = it + 1;
+            this->_buffer += '\\';
+            switch (c)
+            {
+              case '"': this->_buffer += '"'; break;
+              case '\\': this->_buffer += '\\'; break;
+              case '\b': this->_buffer += 'b'; break;
+              case '\f': this->_buffer += 'f'; break;
+              case '\n': this->_buffer += 'n'; break;
+              case '\r': this->_buffer += 'r'; break;
+              case '\t': this->_buffer += 't'; break;
+              default:
+                this->_buffer += "u00";
+                this->_buffer += hex[c >> 4];
+                this->_buffer += hex[c & 0xf];
+            }
+          }
+          this->_buffer.append(start, end);
+          this->_buffer += '"';
+        }
+
+        /// Write the buffered output to the stream, if large enough or
+        /// @a force.
+        void
+        _flush(bool force)
+        {
+          if (force ? this->_buffer.empty() :
+              this->_buffer.size() < buffer_size)
+            return;
+          this->_output.write(this->_buffer.data(), this->_buffer.size());
+          this->_buffer.clear();
+        }
+
+        std::ostream& _output;
+        bool _pretty;
+        std::vector<Frame> _frames;
+        std::string _buffer;
+      };
+
+      std::size_t constexpr SerializerOut::Writer::buffer_size;
+
       /*-------------.
       | Construction |
       `-------------*/
 
       SerializerOut::SerializerOut(std::ostream& output,
                                    bool versioned,
-                                   bool pretty)
+                                   bool pretty,
+                                   bool stream)
         : Super(versioned)
         , _pretty(pretty)
         , _output(output)
+        , _writer(stream ? std::make_unique<Writer>(output, pretty) : nullptr)
       {
         this->_current.push_back(&this->_json);
       }
@@ -32,17 +417,42 @@ namespace elle
       SerializerOut::SerializerOut(std::ostream& output,
                                    Versions versions,
                                    bool versioned,
-                                   bool pretty)
+                                   bool pretty,
+                                   bool stream)
         : Super(std::move(versions), versioned)
         , _pretty(pretty)
         , _output(output)
+        , _writer(stream ? std::make_unique<Writer>(output, pretty) : nullptr)
       {
         this->_current.push_back(&this->_json);
       }
 
+      SerializerOut::SerializerOut(SerializerOut&& source)
+        : Super(std::move(source))
+        , _json(std::move(source._json))
+        , _current(std::move(source._current))
+        , _pretty(source._pretty)
+        , _output(source._output)
+        , _writer(std::move(source._writer))
+      {
+        // Nested values live in the moved JSON, only the root is relocated.
+        if (!this->_current.empty())
+          this->_current.front() = &this->_json;
+        // Leave the source nothing to write.
+        source._current.clear();
+      }
+
       SerializerOut::~SerializerOut() noexcept(false)
       {
+        // Moved from, the output belongs to another serializer.
+        if (this->_current.empty())
+          return;
         ELLE_TRACE_SCOPE("%s: write JSON %s", this, this->output());
+        if (this->_writer)
+        {
+          this->_writer->finish();
+          return;
+        }
         ELLE_DUMP(
           "%s",
           elle::lazy([&] { return elle::json::pretty_print(this->_json); }));
@@ -59,6 +469,8 @@ namespace elle
       bool
       SerializerOut::_enter(std::string const& name)
       {
+        if (this->_writer)
+          return this->_writer->enter(name);
         ELLE_ASSERT(!this->_current.empty());
         auto& current = *this->_current.back();
         if (current.empty())
@@ -95,6 +507,8 @@ namespace elle
       void
       SerializerOut::_leave(std::string const& name)
       {
+        if (this->_writer)
+          return this->_writer->leave();
         ELLE_ASSERT(!this->_current.empty());
         this->_current.pop_back();
       }
@@ -103,10 +517,15 @@ namespace elle
       SerializerOut::_serialize_array(int size,
                                       std::function<void ()> const& f)
       {
-        ELLE_ASSERT(!this->_current.empty());
-        auto& current = *this->_current.back();
-        ELLE_ASSERT(current.empty());
-        current = elle::json::Array();
+        if (this->_writer)
+          this->_writer->array();
+        else
+        {
+          ELLE_ASSERT(!this->_current.empty());
+          auto& current = *this->_current.back();
+          ELLE_ASSERT(current.empty());
+          current = elle::json::Array();
+        }
         f();
       }
 
@@ -123,6 +542,8 @@ namespace elle
       void
       SerializerOut::_serialize(int64_t& v)
       {
+        if (this->_writer)
+          return this->_writer->value(v);
         auto& current = this->_get_current();
         current = v;
       }
@@ -130,6 +551,8 @@ namespace elle
       void
       SerializerOut::_serialize(uint64_t& v)
       {
+        if (this->_writer)
+          return this->_writer->value(v);
         auto& current = this->_get_current();
         current = v;
       }
@@ -137,6 +560,8 @@ namespace elle
       void
       SerializerOut::_serialize(int32_t& v)
       {
+        if (this->_writer)
+          return this->_writer->value(int64_t(v));
         auto& current = this->_get_current();
         current = v;
       }
@@ -144,6 +569,8 @@ namespace elle
       void
       SerializerOut::_serialize(uint32_t& v)
       {
+        if (this->_writer)
+          return this->_writer->value(uint64_t(v));
         auto& current = this->_get_current();
         current = v;
       }
@@ -154,6 +581,8 @@ namespace elle
         meta::static_if<need_unsigned_long>
           ([this](unsigned long& v)
            {
+             if (this->_writer)
+               return this->_writer->value(uint64_t(v));
              auto& current = this->_get_current();
              current = v;
            },
@@ -167,6 +596,8 @@ namespace elle
       void
       SerializerOut::_serialize(int16_t& v)
       {
+        if (this->_writer)
+          return this->_writer->value(int64_t(v));
         auto& current = this->_get_current();
         current = v;
       }
@@ -174,6 +605,8 @@ namespace elle
       void
       SerializerOut::_serialize(uint16_t& v)
       {
+        if (this->_writer)
+          return this->_writer->value(uint64_t(v));
         auto& current = this->_get_current();
         current = v;
       }
@@ -181,6 +614,8 @@ namespace elle
       void
       SerializerOut::_serialize(int8_t& v)
       {
+        if (this->_writer)
+          return this->_writer->value(int64_t(v));
         auto& current = this->_get_current();
         current = int(v);
       }
@@ -188,6 +623,8 @@ namespace elle
       void
       SerializerOut::_serialize(uint8_t& v)
       {
+        if (this->_writer)
+          return this->_writer->value(uint64_t(v));
         auto& current = this->_get_current();
         current = int(v);
       }
@@ -195,6 +632,8 @@ namespace elle
       void
       SerializerOut::_serialize(double& v)
       {
+        if (this->_writer)
+          return this->_writer->value(v);
         auto& current = this->_get_current();
         current = v;
       }
@@ -202,6 +641,8 @@ namespace elle
       void
       SerializerOut::_serialize(bool& v)
       {
+        if (this->_writer)
+          return this->_writer->value(v);
         auto& current = this->_get_current();
         current = v;
       }
@@ -209,6 +650,8 @@ namespace elle
       void
       SerializerOut::_serialize(std::string& v)
       {
+        if (this->_writer)
+          return this->_writer->value(v);
         auto& current = this->_get_current();
         current = v;
       }
@@ -216,82 +659,29 @@ namespace elle
       void
       SerializerOut::_serialize(elle::Buffer& buffer)
       {
-        std::stringstream encoded;
-        {
-          elle::format::base64::Stream base64(encoded);
-          base64.write(reinterpret_cast<char*>(buffer.contents()),
-                       buffer.size());
-        }
+        if (this->_writer)
+          return this->_writer->value(base64(buffer));
         auto& current = this->_get_current();
-        current = encoded.str();
+        current = base64(buffer);
       }
 
       void
       SerializerOut::_serialize(boost::posix_time::ptime& time)
       {
-        std::stringstream ss;
-        auto output_facet =
-          std::make_unique<boost::posix_time::time_facet>();
-        // ISO 8601
-        output_facet->format("%Y-%m-%dT%H:%M:%S%F%q");
-        ss.imbue(std::locale(ss.getloc(), output_facet.release()));
-        ss << time;
-        this->_get_current() = ss.str();
+        if (this->_writer)
+          return this->_writer->value(iso8601(time));
+        this->_get_current() = iso8601(time);
       }
 
       void
-      SerializerOut::_serialize_time_duration(std::int64_t& ticks_,
-                                              std::int64_t& num_,
-                                              std::int64_t& denom_)
+      SerializerOut::_serialize_time_duration(std::int64_t& ticks,
+                                              std::int64_t& num,
+                                              std::int64_t& denom)
       {
-        auto ticks = ticks_;
-        auto num = num_;
-        auto denom = denom_;
-        auto order = 3;
-        while (denom % 1000 == 0)
-        {
-          denom /= 1000;
-          if (ticks % 1000 == 0)
-            ticks /= 1000;
-          else
-            ++order;
-        }
-        if (denom != 1)
-          if (1000 % denom == 0)
-          {
-            num *= 1000 / denom;
-            denom *= 1;
-            ++order;
-          }
-          else
-            ELLE_ABORT("cannot safely represent time with ratio %s:%s",
-                       num_, denom_);
-        ELLE_ASSERT_EQ(denom, 1);
-        char orders[][9] = {"d", "h", "min", "s", "ms", "us", "ns", "ps", "fs"};
-        if (order >= 9)
-          ELLE_ABORT("cannot safely represent time with ratio %s:%s",
-                       num_, denom_);
-        ticks *= num;
-        if (order == 3)
-        {
-          if (ticks % 60 == 0)
-          {
-            ticks /= 60;
-            --order;
-            if (ticks % 60 == 0)
-            {
-              ticks /= 60;
-              --order;
-              if (ticks % 24 == 0)
-              {
-                ticks /= 24;
-                --order;
-              }
-            }
-          }
-        }
+        if (this->_writer)
+          return this->_writer->value(duration(ticks, num, denom));
         auto& current = this->_get_current();
-        current = elle::sprintf("%s%s", ticks, orders[order]);
+        current = duration(ticks, num, denom);
       }
 
       void
@@ -309,6 +699,8 @@ namespace elle
       {
         if (filled)
           f();
+        else if (this->_writer)
+          this->_writer->omit();
         else
         {
           *this->_current.back() = elle::json::NullType();
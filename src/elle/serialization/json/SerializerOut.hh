@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include <boost/any.hpp>
@@ -22,6 +23,12 @@ namespace elle
       /// - unordered_map and map are serialized dict {x: y}.
       /// - unordered_multimap are serialized list of list [[x, x], [x, y]].
       /// - empty maps and unordered_multimap are serialized as null.
+      ///
+      /// By default, the whole document is built in memory and written on
+      /// destruction. In stream mode, it is written to the output as it is
+      /// serialized instead, which keeps memory usage flat for large
+      /// documents and writes keys in the order they are serialized rather
+      /// than sorted.
       class ELLE_API SerializerOut
         : public serialization::SerializerOut
       {
@@ -41,18 +48,23 @@ namespace elle
         /// @see elle::serialization::SerializerOut
         ///
         /// @param pretty Whether the JSON should be formatted.
+        /// @param stream Whether to write the JSON as it is serialized.
         SerializerOut(std::ostream& output,
                       bool versioned = true,
-                      bool pretty = false);
+                      bool pretty = false,
+                      bool stream = false);
         /// Construct a SerializerOut for JSON.
         ///
         /// @see elle::serialization::SerializerOut
         ///
         /// @param pretty Whether the JSON should be formatted.
+        /// @param stream Whether to write the JSON as it is serialized.
         SerializerOut(std::ostream& output,
                       Versions versions,
                       bool versioned = true,
-                      bool pretty = false);
+                      bool pretty = false,
+                      bool stream = false);
+        SerializerOut(SerializerOut&&);
         ~SerializerOut() noexcept(false);
 
       /*--------------.
@@ -141,6 +153,9 @@ namespace elle
         ELLE_ATTRIBUTE(std::vector<boost::any*>, current);
         ELLE_ATTRIBUTE(bool, pretty);
         ELLE_ATTRIBUTE_R(std::ostream&, output);
+        class Writer;
+        /// The token writer, in stream mode.
+        ELLE_ATTRIBUTE(std::unique_ptr<Writer>, writer);
       };
     }
   }
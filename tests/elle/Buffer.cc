@@ -226,6 +226,28 @@ test_assign()
   BOOST_TEST(b2.size() == 0);
 }
 
+static
+void
+test_pop_front()
+{
+  auto b = elle::Buffer("0123456789abcdef");
+  auto const contents = b.contents();
+  b.pop_front(4);
+  BOOST_TEST(b.contents() == contents + 4);
+  BOOST_TEST(b == "456789abcdef");
+  b.append("ghijklmnopqrstuv", 16);
+  BOOST_TEST(b == "456789abcdefghijklmnopqrstuv");
+  b.pop_front(b.size());
+  BOOST_TEST(b.empty());
+  b.append("wxyz", 4);
+  BOOST_TEST(b == "wxyz");
+  b.pop_front();
+  auto released = b.release();
+  BOOST_TEST(released.second == 3u);
+  BOOST_TEST(std::string(reinterpret_cast<char*>(released.first.get()), 3) ==
+             "xyz");
+}
+
 static
 void
 delete_noop(elle::Buffer::Byte*)
@@ -377,6 +399,7 @@ ELLE_TEST_SUITE()
   memory->add(BOOST_TEST_CASE(test_capacity));
   memory->add(BOOST_TEST_CASE(test_release));
   memory->add(BOOST_TEST_CASE(test_assign));
+  memory->add(BOOST_TEST_CASE(test_pop_front));
 
   boost::unit_test::test_suite* streams = BOOST_TEST_SUITE("streams");
   buffer->add(streams);
@@ -1,10 +1,15 @@
+#include <chrono>
 #include <string>
 
+#include <boost/optional.hpp>
+
 #include <elle/json/json.hh>
 #include <elle/serialization/Serializer.hh>
+#include <elle/serialization/binary.hh>
 #include <elle/serialization/json.hh>
 #include <elle/test.hh>
 
+#include <elle/das/binary.hh>
 #include <elle/das/printer.hh>
 #include <elle/das/serializer.hh>
 #include <elle/das/Symbol.hh>
@@ -13,9 +18,16 @@ ELLE_LOG_COMPONENT("das.serializer.test");
 
 namespace symbol
 {
+  ELLE_DAS_SYMBOL(big);
+  ELLE_DAS_SYMBOL(blob);
   ELLE_DAS_SYMBOL(device);
+  ELLE_DAS_SYMBOL(flag);
   ELLE_DAS_SYMBOL(id);
+  ELLE_DAS_SYMBOL(maybe);
   ELLE_DAS_SYMBOL(name);
+  ELLE_DAS_SYMBOL(ratio);
+  ELLE_DAS_SYMBOL(small);
+  ELLE_DAS_SYMBOL(users);
 }
 
 using elle::das::operator <<;
@@ -102,9 +114,58 @@ struct User
                                                            symbol::device))>;
 };
 
+/// A struct with every type das::binary handles.
+struct Sample
+{
+  bool
+  operator ==(Sample const& rhs) const
+  {
+    return this->flag == rhs.flag && this->small == rhs.small &&
+      this->big == rhs.big && this->ratio == rhs.ratio &&
+      this->blob == rhs.blob && this->maybe == rhs.maybe &&
+      this->device == rhs.device;
+  }
+
+  bool flag;
+  int8_t small;
+  int64_t big;
+  double ratio;
+  elle::Buffer blob;
+  boost::optional<std::string> maybe;
+  std::vector<DevicePOD> device;
+
+  using Model = elle::das::Model<
+    Sample,
+    decltype(elle::meta::list(symbol::flag,
+                              symbol::small,
+                              symbol::big,
+                              symbol::ratio,
+                              symbol::blob,
+                              symbol::maybe,
+                              symbol::device))>;
+};
+
+struct Group
+{
+  std::string name;
+  std::vector<User> users;
+
+  bool
+  operator ==(Group const& rhs) const
+  {
+    return this->name == rhs.name && this->users == rhs.users;
+  }
+
+  using Model = elle::das::Model<Group,
+                                 decltype(elle::meta::list(symbol::name,
+                                                           symbol::users))>;
+};
+
 ELLE_DAS_SERIALIZE(DevicePOD);
 ELLE_DAS_SERIALIZE(Device);
 ELLE_DAS_SERIALIZE(User);
+ELLE_DAS_SERIALIZE(Sample);
+ELLE_DAS_SERIALIZE(Group);
 
 static
 void
@@ -155,9 +216,175 @@ composite()
   }
 }
 
+/// Check das::binary and the binary serializers agree on @a o.
+template <typename T>
+static
+void
+check_binary(T const& o)
+{
+  auto const buffer = elle::das::binary::serialize(o);
+  BOOST_TEST(buffer == elle::serialization::binary::serialize(o));
+  BOOST_TEST(elle::das::binary::deserialize<T>(buffer) == o);
+  BOOST_TEST(elle::serialization::binary::deserialize<T>(buffer) == o);
+}
+
+static
+Sample
+sample()
+{
+  return Sample{
+    true, -7, int64_t(1) << 40, 3.5, elle::Buffer("\0\1\2", 3),
+    std::string("maybe"), {DevicePOD{42, "towel"}, DevicePOD{-8191, ""}}};
+}
+
+/// A group of @a count users with ten devices each.
+static
+Group
+group(int count)
+{
+  auto res = Group{"heart of gold", {}};
+  for (int i = 0; i < count; ++i)
+  {
+    auto devices = std::vector<Device>{};
+    for (int j = 0; j < 10; ++j)
+      devices.emplace_back(i * 10 + j, elle::sprintf("device %s", j));
+    res.users.emplace_back(elle::sprintf("user %s", i), std::move(devices));
+  }
+  return res;
+}
+
+static
+void
+binary()
+{
+  ELLE_LOG("POD serialization")
+    check_binary(DevicePOD{42, "towel"});
+  ELLE_LOG("object serialization")
+    check_binary(Device{42, "towel"});
+  ELLE_LOG("composite serialization")
+  {
+    check_binary(User("Doug", {Device(42, "arthur"), Device(51, "ford")}));
+    check_binary(User("", {}));
+  }
+  ELLE_LOG("nested containers")
+    check_binary(group(3));
+  ELLE_LOG("all types")
+  {
+    check_binary(sample());
+    auto s = sample();
+    s.maybe.reset();
+    s.big = -(int64_t(1) << 62);
+    s.small = 63;
+    check_binary(s);
+  }
+  ELLE_LOG("serialize with custom model")
+  {
+    using Model = elle::das::Model<User,
+                                   decltype(elle::meta::list(symbol::name))>;
+    using S = elle::das::Serializer<User, Model>;
+    auto const u = User("Doug", {Device(42, "arthur")});
+    auto const buffer = elle::das::binary::serialize<User, Model>(u);
+    BOOST_TEST(buffer == elle::serialization::binary::serialize<S>(u));
+    BOOST_TEST((elle::das::binary::deserialize<User, Model>(buffer)) ==
+               User("Doug"));
+  }
+  ELLE_LOG("append")
+  {
+    auto buffer = elle::Buffer("prefix");
+    elle::das::binary::serialize(DevicePOD{42, "towel"}, buffer);
+    BOOST_TEST(buffer.range(0, 6) == "prefix");
+    BOOST_TEST(buffer.range(6) ==
+               elle::das::binary::serialize(DevicePOD{42, "towel"}));
+  }
+}
+
+struct Wide
+{
+  int64_t id;
+  std::string name;
+
+  using Model = elle::das::Model<Wide,
+                                 decltype(elle::meta::list(symbol::id,
+                                                           symbol::name))>;
+};
+
+static
+void
+binary_errors()
+{
+  auto const buffer = elle::das::binary::serialize(sample());
+  ELLE_LOG("truncated input")
+    for (auto size = 0u; size < buffer.size(); ++size)
+    {
+      auto const truncated = buffer.range(0, size);
+      BOOST_CHECK_THROW(elle::das::binary::deserialize<Sample>(truncated),
+                        elle::serialization::Error);
+    }
+  ELLE_LOG("trailing input")
+  {
+    auto trailing = buffer;
+    trailing.append("\0", 1);
+    BOOST_CHECK_THROW(elle::das::binary::deserialize<Sample>(trailing),
+                      elle::serialization::Error);
+  }
+  ELLE_LOG("wrong magic")
+  {
+    auto wrong = buffer;
+    wrong[0] = 1;
+    BOOST_CHECK_THROW(elle::das::binary::deserialize<Sample>(wrong),
+                      elle::serialization::Error);
+  }
+  ELLE_LOG("overflow")
+  {
+    auto const wide =
+      elle::das::binary::serialize(Wide{int64_t(1) << 40, "towel"});
+    BOOST_CHECK_THROW(elle::das::binary::deserialize<DevicePOD>(wide),
+                      elle::serialization::json::Overflow);
+  }
+}
+
+static
+void
+binary_benchmark()
+{
+  auto const group = ::group(100);
+  auto const buffer = elle::das::binary::serialize(group);
+  auto const count = 20;
+  auto const speed = [&] (auto const& f)
+    {
+      auto const start = std::chrono::steady_clock::now();
+      for (int i = 0; i < count; ++i)
+        f();
+      auto const seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+      return buffer.size() * count / seconds / (1 << 20);
+    };
+  auto const generic_out = speed(
+    [&] { elle::serialization::binary::serialize(group); });
+  auto const das_out = speed(
+    [&] { elle::das::binary::serialize(group); });
+  auto const generic_in = speed(
+    [&] { elle::serialization::binary::deserialize<Group>(buffer); });
+  auto const das_in = speed(
+    [&] { elle::das::binary::deserialize<Group>(buffer); });
+  BOOST_TEST_MESSAGE(
+    elle::sprintf("%s bytes serialized: %.1f MiB/s with SerializerOut, "
+                  "%.1f MiB/s with das::binary (x%.1f)",
+                  buffer.size(), generic_out, das_out,
+                  das_out / generic_out));
+  BOOST_TEST_MESSAGE(
+    elle::sprintf("%s bytes deserialized: %.1f MiB/s with SerializerIn, "
+                  "%.1f MiB/s with das::binary (x%.1f)",
+                  buffer.size(), generic_in, das_in, das_in / generic_in));
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
   suite.add(BOOST_TEST_CASE(simple), 0, valgrind(1));
   suite.add(BOOST_TEST_CASE(composite), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(binary), 0, valgrind(1));
+  suite.add(BOOST_TEST_CASE(binary_errors), 0, valgrind(1));
+  if (benchmarks())
+    suite.add(BOOST_TEST_CASE(binary_benchmark), 0, valgrind(10, 10));
 }
@@ -1,8 +1,17 @@
+#include <chrono>
+#include <fstream>
+#include <limits>
 #include <sstream>
 
+#include <elle/filesystem/TemporaryFile.hh>
+#include <elle/finally.hh>
+#include <elle/json/Value.hh>
+#include <elle/json/exceptions.hh>
 #include <elle/json/json.hh>
-#include <elle/test.hh>
+#include <elle/json/parser.hh>
 #include <elle/log.hh>
+#include <elle/printf.hh>
+#include <elle/test.hh>
 
 ELLE_LOG_COMPONENT("Test");
 
@@ -145,6 +154,525 @@ pretty_printer_utf_8()
   BOOST_CHECK_EQUAL(boost::any_cast<std::string>(read_object["utf-8"]), name);
 }
 
+static
+void
+read_numbers()
+{
+  auto const integer = [] (std::string const& text)
+    {
+      return boost::any_cast<int64_t>(elle::json::read(text));
+    };
+  auto const real = [] (std::string const& text)
+    {
+      return boost::any_cast<double>(elle::json::read(text));
+    };
+  BOOST_CHECK_EQUAL(integer("0"), 0);
+  BOOST_CHECK_EQUAL(integer("-42"), -42);
+  BOOST_CHECK_EQUAL(integer("-9223372036854775808"),
+                    std::numeric_limits<int64_t>::min());
+  // Like json_spirit, unsigned 64 bits integers wrap.
+  BOOST_CHECK_EQUAL(integer("18446744073709551615"), -1);
+  BOOST_CHECK_EQUAL(real("18446744073709551616"), 18446744073709551616.);
+  BOOST_CHECK_EQUAL(real("-9223372036854775809"), -9223372036854775809.);
+  BOOST_CHECK_EQUAL(real("1.5"), 1.5);
+  BOOST_CHECK_EQUAL(real("-2e3"), -2000);
+  BOOST_CHECK_EQUAL(real("2.5E-1"), 0.25);
+  for (auto invalid: {"-", "1.", "1e", "1e+", "12a", "--1", "tru", "nul"})
+    BOOST_CHECK_THROW(elle::json::read(std::string(invalid)),
+                      elle::json::ParseError);
+}
+
+static
+std::string
+read_string(std::string const& json)
+{
+  return boost::any_cast<std::string>(elle::json::read(json));
+}
+
+static
+void
+read_strings()
+{
+  BOOST_CHECK_EQUAL(read_string(R"("\"\\\/\b\f\n\r\t")"),
+                    "\"\\/\b\f\n\r\t");
+  BOOST_CHECK_EQUAL(read_string(R"("é€")"), "é€");
+  // Surrogate pairs, and lone surrogates kept as is.
+  BOOST_CHECK_EQUAL(read_string(R"("\ud83d\ude00")"), "😀");
+  BOOST_CHECK_EQUAL(read_string(R"("\ud83d")"), "\xed\xa0\xbd");
+  BOOST_CHECK_EQUAL(read_string(std::string("\"a\0b\"", 5)),
+                    std::string("a\0b", 3));
+  for (auto invalid: {R"("\x")", R"("\u12")", R"("\u12g4")", R"("abc)",
+                      "\"abc\\"})
+    BOOST_CHECK_THROW(read_string(invalid), elle::json::ParseError);
+  // Invalid, overlong and truncated UTF-8, encoded surrogates, code points
+  // past U+10FFFF.
+  for (auto invalid: {"\"\xff\"", "\"\x80\"", "\"\xc0\xaf\"",
+                      "\"\xe0\x80\xaf\"", "\"\xe2\x82\"", "\"\xed\xa0\x80\"",
+                      "\"\xf4\x90\x80\x80\""})
+    BOOST_CHECK_THROW(read_string(invalid), elle::json::ParseError);
+}
+
+static
+void
+read_containers()
+{
+  {
+    auto array = boost::any_cast<elle::json::Array>(
+      elle::json::read(std::string(" [ 1 , [ ] , { } , \"]\" , ] ")));
+    BOOST_CHECK_EQUAL(array.size(), 4);
+    BOOST_CHECK_EQUAL(boost::any_cast<std::string>(array[3]), "]");
+  }
+  {
+    auto object = boost::any_cast<elle::json::Object>(
+      elle::json::read(std::string(R"({"a": 1, "a": 2, "}": {},})")));
+    BOOST_CHECK_EQUAL(object.size(), 2);
+    BOOST_CHECK_EQUAL(boost::any_cast<int64_t>(object["a"]), 2);
+  }
+  for (auto invalid: {"", " ", "[", "[1 2]", "[1,,]", "{\"a\"}", "{1: 2}",
+                      "{\"a\": 1", "]", "[1}"})
+    BOOST_CHECK_THROW(elle::json::read(std::string(invalid)),
+                      elle::json::ParseError);
+  BOOST_CHECK_THROW(elle::json::read(std::string("{} {}")), elle::Error);
+}
+
+static
+void
+read_deep()
+{
+  auto const depth = 100000;
+  auto const json =
+    std::string(depth, '[') + "{\"a\": 1}" + std::string(depth, ']');
+  auto value = elle::json::read(json);
+  for (int i = 0; i < depth; ++i)
+  {
+    auto& array = boost::any_cast<elle::json::Array&>(value);
+    BOOST_REQUIRE_EQUAL(array.size(), 1);
+    auto element = std::move(array[0]);
+    value = std::move(element);
+  }
+  boost::any_cast<elle::json::Object&>(value);
+}
+
+static
+void
+read_stream()
+{
+  // Values are read one by one, leaving what follows in the stream.
+  std::stringstream input(
+    "{\"a\": [1, \"]\\\"}\"]}[2]\"\\\"s\"  -3\ntrue");
+  auto object = boost::any_cast<elle::json::Object>(elle::json::read(input));
+  BOOST_CHECK_EQUAL(
+    boost::any_cast<elle::json::Array>(object["a"]).size(), 2);
+  BOOST_CHECK_EQUAL(
+    boost::any_cast<elle::json::Array>(elle::json::read(input)).size(), 1);
+  BOOST_CHECK_EQUAL(
+    boost::any_cast<std::string>(elle::json::read(input)), "\"s");
+  BOOST_CHECK_EQUAL(boost::any_cast<int64_t>(elle::json::read(input)), -3);
+  BOOST_CHECK_EQUAL(boost::any_cast<bool>(elle::json::read(input)), true);
+  BOOST_CHECK_THROW(elle::json::read(input), elle::json::ParseError);
+}
+
+static
+void
+read_file()
+{
+  // Values following the first one are left in the file.
+  auto const file = elle::filesystem::TemporaryFile("values.json");
+  auto const count = 100000;
+  {
+    std::ofstream output(file.path().string());
+    output << "{\"a\": 1}\n[";
+    for (int i = 0; i < count; ++i)
+      output << (i ? ", " : "") << i;
+    output << "]\n\"end\"";
+  }
+  std::ifstream input(file.path().string());
+  auto object = boost::any_cast<elle::json::Object>(elle::json::read(input));
+  BOOST_CHECK_EQUAL(boost::any_cast<int64_t>(object["a"]), 1);
+  auto const array =
+    boost::any_cast<elle::json::Array>(elle::json::read(input));
+  BOOST_REQUIRE_EQUAL(array.size(), count);
+  BOOST_CHECK_EQUAL(boost::any_cast<int64_t>(array.back()), count - 1);
+  BOOST_CHECK_EQUAL(
+    boost::any_cast<std::string>(elle::json::read(input)), "end");
+}
+
+/// The instruction sets available to scan JSON.
+static
+std::vector<elle::json::parser::InstructionSet>
+instruction_sets()
+{
+  using elle::json::parser::InstructionSet;
+  auto res = std::vector<InstructionSet>{};
+  for (auto set: {InstructionSet::scalar,
+                  InstructionSet::sse2,
+                  InstructionSet::avx2})
+    if (elle::json::parser::supported(set))
+      res.emplace_back(set);
+  return res;
+}
+
+static
+void
+instruction_set()
+{
+  namespace parser = elle::json::parser;
+  auto const previous = parser::instruction_set();
+  elle::SafeFinally restore([&] { parser::instruction_set(previous); });
+  for (auto set: instruction_sets())
+  {
+    BOOST_TEST_MESSAGE(set);
+    parser::instruction_set(set);
+    BOOST_CHECK_EQUAL(parser::instruction_set(), set);
+    // Put escapes, quotes, brackets and multibyte characters at every
+    // position relative to the vector boundaries.
+    for (int size = 0; size < 80; ++size)
+    {
+      auto const padding = std::string(size, 'x');
+      auto const json = elle::sprintf(
+        "[\"%s\\n%s\\\"[]{}\", \"%s\", {\"%s\": \"é%s€\"}]",
+        padding, padding, padding, padding, padding);
+      auto array = boost::any_cast<elle::json::Array>(
+        elle::json::read(json));
+      BOOST_REQUIRE_EQUAL(array.size(), 3);
+      BOOST_CHECK_EQUAL(boost::any_cast<std::string>(array[0]),
+                        padding + "\n" + padding + "\"[]{}");
+      BOOST_CHECK_EQUAL(boost::any_cast<std::string>(array[1]), padding);
+      auto object = boost::any_cast<elle::json::Object>(array[2]);
+      BOOST_CHECK_EQUAL(boost::any_cast<std::string>(object.at(padding)),
+                        "é" + padding + "€");
+      std::stringstream input(json + "[]");
+      elle::json::read(input);
+      BOOST_CHECK_EQUAL(input.str().substr(input.tellg()), "[]");
+      BOOST_CHECK_THROW(
+        read_string("\"" + padding + "\xc3\x28" + padding + "\""),
+        elle::json::ParseError);
+    }
+  }
+}
+
+/*------.
+| Value |
+`------*/
+
+static
+void
+value_scalars()
+{
+  using elle::json::Value;
+  BOOST_CHECK(Value().type() == Value::Type::null);
+  BOOST_CHECK(Value(elle::json::NullType()) == Value());
+  BOOST_CHECK_EQUAL(Value(true).boolean(), true);
+  BOOST_CHECK_EQUAL(Value(42).integer(), 42);
+  BOOST_CHECK_EQUAL(Value(uint16_t(42)).integer(), 42);
+  BOOST_CHECK_EQUAL(Value(42).real(), 42);
+  BOOST_CHECK_EQUAL(Value(1.5).real(), 1.5);
+  BOOST_CHECK_EQUAL(Value("Paul").string(), "Paul");
+  BOOST_CHECK(Value(1) != Value(1.0));
+  BOOST_CHECK_THROW(Value(1.5).integer(), elle::json::TypeError);
+  BOOST_CHECK_THROW(Value("1").integer(), elle::json::TypeError);
+  BOOST_CHECK_THROW(Value(1).size(), elle::json::TypeError);
+  auto value = Value(std::string(100, 'x'));
+  auto copy = value;
+  value = std::move(copy);
+  BOOST_CHECK_EQUAL(value.string(), std::string(100, 'x'));
+  value = 3;
+  BOOST_CHECK_EQUAL(value.integer(), 3);
+  // Unsigned integers past the int64_t range are kept unsigned.
+  auto const max = std::numeric_limits<uint64_t>::max();
+  BOOST_CHECK(Value(max).type() == Value::Type::unsigned_integer);
+  BOOST_CHECK_EQUAL(Value(max).unsigned_integer(), max);
+  BOOST_CHECK_EQUAL(elle::sprintf("%s", Value(max)), "18446744073709551615");
+  BOOST_CHECK_THROW(Value(max).integer(), elle::json::TypeError);
+  BOOST_CHECK(Value(uint64_t(42)) == Value(42));
+  BOOST_CHECK_EQUAL(Value(42).unsigned_integer(), 42u);
+  BOOST_CHECK_THROW(Value(-1).unsigned_integer(), elle::json::TypeError);
+  BOOST_CHECK(Value(Value(max).any()) == Value(max));
+  BOOST_CHECK(boost::any_cast<uint64_t>(Value(max).any()) == max);
+  BOOST_CHECK(elle::json::read_value(std::string("18446744073709551615")) ==
+              Value(max));
+}
+
+static
+void
+value_containers()
+{
+  using elle::json::Value;
+  // Members are sorted and the last of duplicate keys wins.
+  auto object = Value(Value::Object{{"b", 1}, {"a", 2}, {"b", 3}});
+  BOOST_CHECK_EQUAL(object.size(), 2);
+  BOOST_CHECK_EQUAL(object.object()[0].first, "a");
+  BOOST_CHECK_EQUAL(object["b"].integer(), 3);
+  BOOST_CHECK(!object.find("c"));
+  object["c"] = Value::Array{1, "two", Value()};
+  object["0"] = false;
+  BOOST_CHECK_EQUAL(object.size(), 4);
+  BOOST_CHECK_EQUAL(object["c"][1].string(), "two");
+  BOOST_CHECK_EQUAL(elle::sprintf("%s", object),
+                    "{\"0\":false,\"a\":2,\"b\":3,\"c\":[1,\"two\",null]}");
+  auto const& constant = object;
+  BOOST_CHECK_THROW(constant["d"], elle::Error);
+  BOOST_CHECK_THROW(constant["c"][3], elle::Error);
+  BOOST_CHECK_THROW(constant["a"]["b"], elle::json::TypeError);
+  // Self assignment from a member.
+  object = object["c"];
+  BOOST_CHECK_EQUAL(object.size(), 3);
+  auto empty = Value();
+  empty["a"]["b"] = 1.5;
+  BOOST_CHECK_EQUAL(elle::sprintf("%s", empty), "{\"a\":{\"b\":1.5}}");
+}
+
+static
+void
+value_json()
+{
+  using elle::json::Value;
+  auto json = elle::json::Object{
+    {"int", 1},
+    {"unsigned", uint64_t(2)},
+    {"real", 3.5},
+    {"string", std::string("\"quoted\"\n")},
+    {"array", elle::json::Array{true, elle::json::NullType(), 'x' == 'x'}},
+    {"object", elle::json::OrderedObject{{"b", 1}, {"a", 2}}},
+  };
+  auto value = Value(elle::json::Json(json));
+  BOOST_CHECK_EQUAL(value["int"].integer(), 1);
+  BOOST_CHECK_EQUAL(value["unsigned"].integer(), 2);
+  BOOST_CHECK_EQUAL(value["object"].object()[0].first, "a");
+  // Back and forth conversions, reading and printing agree.
+  BOOST_CHECK(Value(value.any()) == value);
+  BOOST_CHECK(elle::json::read_value(elle::sprintf("%s", value)) == value);
+  BOOST_CHECK(Value(elle::json::read(elle::sprintf("%s", value))) == value);
+  BOOST_CHECK_EQUAL(elle::json::pretty_print(value.any()),
+                    elle::json::pretty_print(elle::json::Json(json)));
+  struct Foo{};
+  BOOST_CHECK_THROW(Value(elle::json::Json(Foo{})), elle::json::TypeError);
+}
+
+static
+void
+value_read()
+{
+  using elle::json::Value;
+  auto value = elle::json::read_value(
+    std::string(R"({"b": [1, 2.5, "s", null, true], "a": {"b": 1, "b": 2}})"));
+  BOOST_CHECK_EQUAL(elle::sprintf("%s", value),
+                    R"({"a":{"b":2},"b":[1,2.5,"s",null,true]})");
+  std::stringstream input("{\"a\": 1} [2]");
+  BOOST_CHECK_EQUAL(elle::json::read_value(input)["a"].integer(), 1);
+  BOOST_CHECK_EQUAL(elle::json::read_value(input)[0].integer(), 2);
+  BOOST_CHECK_THROW(elle::json::read_value(input), elle::json::ParseError);
+  BOOST_CHECK_THROW(elle::json::read_value(std::string("[1, 2")),
+                    elle::json::ParseError);
+  BOOST_CHECK_THROW(elle::json::read_value(std::string("1 2")), elle::Error);
+}
+
+static
+void
+value_deep()
+{
+  // Printing and destroying do not recurse.
+  auto const depth = 100000;
+  auto const json = std::string(depth, '[') + R"({"a":[],"b":{}})" +
+    std::string(depth, ']');
+  auto const value = elle::json::read_value(json);
+  BOOST_CHECK(elle::sprintf("%s", value) == json);
+}
+
+/*----------.
+| Benchmark |
+`----------*/
+
+/// Tweets: objects with many keys, short strings, escapes and non-ASCII
+/// text.
+static
+std::string
+corpus_twitter(int count)
+{
+  auto res = std::string("{\"statuses\": [");
+  for (int i = 0; i < count; ++i)
+    res += elle::sprintf(
+      "%s{\"id\": %s, \"id_str\": \"%s\", "
+      "\"text\": \"RT @user%s: tweet n°%s about \\\"élan\\\" and 😀\\n"
+      "https://t.co/%x\", "
+      "\"user\": {\"id\": %s, \"name\": \"Ünïcödé User %s\", "
+      "\"screen_name\": \"user%s\", \"location\": \"東京\", "
+      "\"followers_count\": %s, \"verified\": %s, \"url\": null}, "
+      "\"entities\": {\"hashtags\": [{\"text\": \"elle\", "
+      "\"indices\": [%s, %s]}], \"urls\": []}, "
+      "\"retweet_count\": %s, \"favorited\": false, "
+      "\"coordinates\": null}",
+      i ? ", " : "", 505874924095815681 + i, 505874924095815681 + i,
+      i % 97, i, i * 7919, 1186275104 + i, i, i, i * 13 % 10007,
+      i % 2 ? "true" : "false", i % 140, i % 140 + 5, i % 100);
+  return res + "]}";
+}
+
+/// Polygons: arrays of arrays of full precision reals.
+static
+std::string
+corpus_canada(int count)
+{
+  auto res = std::string(
+    "{\"type\": \"FeatureCollection\", \"features\": [{\"type\": "
+    "\"Feature\", \"geometry\": {\"type\": \"Polygon\", \"coordinates\": "
+    "[[");
+  for (int i = 0; i < count; ++i)
+    res += elle::sprintf(
+      "%s[%.17g, %.17g]", i ? ", " : "",
+      -65.613616999999977 + i * 1e-5, 43.420273000000009 - i * 3e-6);
+  return res + "]]}}]}";
+}
+
+/// Buffers, serialized as long base64 strings.
+static
+std::string
+corpus_blobs(int count, int size)
+{
+  auto const alphabet = std::string(
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+  auto res = std::string("[");
+  for (int i = 0; i < count; ++i)
+  {
+    auto blob = std::string(size, 'A');
+    for (int j = 0; j < size; ++j)
+      blob[j] = alphabet[(i * 31 + j * 7) % alphabet.size()];
+    res += elle::sprintf("%s{\"id\": %s, \"data\": \"%s\"}",
+                         i ? ", " : "", i, blob);
+  }
+  return res + "]";
+}
+
+/// Deeply nested arrays and objects.
+static
+std::string
+corpus_nested(int count, int depth)
+{
+  auto res = std::string("[");
+  for (int i = 0; i < count; ++i)
+  {
+    if (i)
+      res += ", ";
+    for (int d = 0; d < depth; ++d)
+      res += "{\"a\": [";
+    res += std::to_string(i);
+    for (int d = 0; d < depth; ++d)
+      res += "]}";
+  }
+  return res + "]";
+}
+
+/// The best time, in seconds, to read and then destroy the value in
+/// @a json, out of three runs.
+template <typename Read>
+static
+std::pair<double, double>
+measure(Read const& read, std::string const& json)
+{
+  using Clock = std::chrono::steady_clock;
+  auto const seconds = [] (Clock::time_point start)
+    {
+      return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+  auto res = std::make_pair(std::numeric_limits<double>::max(),
+                            std::numeric_limits<double>::max());
+  for (int i = 0; i < 3; ++i)
+  {
+    auto start = Clock::now();
+    {
+      auto const value = read(json);
+      res.first = std::min(res.first, seconds(start));
+      start = Clock::now();
+    }
+    res.second = std::min(res.second, seconds(start));
+  }
+  return res;
+}
+
+/// The benchmark corpora, @a scale hundredths of their benchmarked size.
+static
+std::vector<std::pair<std::string, std::string>>
+corpora(int scale)
+{
+  return {
+    {"twitter", corpus_twitter(10 * scale)},
+    {"canada", corpus_canada(200 * scale)},
+    {"nested", corpus_nested(5 * scale / 2, 200)},
+    {"blobs", corpus_blobs(scale, 8192)},
+  };
+}
+
+static
+void
+corpora_instruction_sets()
+{
+  namespace parser = elle::json::parser;
+  auto const previous = parser::instruction_set();
+  elle::SafeFinally restore([&] { parser::instruction_set(previous); });
+  for (auto const& corpus: corpora(2))
+  {
+    auto const& json = corpus.second;
+    BOOST_TEST_MESSAGE(corpus.first);
+    // All instruction sets yield the same values.
+    auto reference = std::string{};
+    for (auto set: instruction_sets())
+    {
+      parser::instruction_set(set);
+      auto const printed = elle::json::pretty_print(elle::json::read(json));
+      if (reference.empty())
+        reference = printed;
+      else
+        BOOST_CHECK(printed == reference);
+    }
+    parser::instruction_set(previous);
+    BOOST_CHECK(elle::json::read_value(json) ==
+                elle::json::Value(elle::json::read(json)));
+  }
+}
+
+static
+void
+benchmark()
+{
+  namespace parser = elle::json::parser;
+  auto const previous = parser::instruction_set();
+  elle::SafeFinally restore([&] { parser::instruction_set(previous); });
+  auto const speed = [] (std::string const& json, double seconds)
+    {
+      return elle::sprintf("%.1f MiB/s", json.size() / seconds / (1 << 20));
+    };
+  auto const read = [] (std::string const& json)
+    {
+      return elle::json::read(json);
+    };
+  auto const read_value = [] (std::string const& json)
+    {
+      return elle::json::read_value(json);
+    };
+  for (auto const& corpus: corpora(100))
+  {
+    auto const& json = corpus.second;
+    BOOST_TEST_MESSAGE(
+      elle::sprintf("%s: %s bytes", corpus.first, json.size()));
+    for (auto set: instruction_sets())
+    {
+      parser::instruction_set(set);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("  read with %s: %s",
+                      set, speed(json, measure(read, json).first)));
+    }
+    parser::instruction_set(previous);
+    auto const any = measure(read, json);
+    auto const value = measure(read_value, json);
+    BOOST_TEST_MESSAGE(
+      elle::sprintf("  Json: read %s, destroyed in %.1f ms",
+                    speed(json, any.first), any.second * 1000));
+    BOOST_TEST_MESSAGE(
+      elle::sprintf("  Value: read %s, destroyed in %.1f ms",
+                    speed(json, value.first), value.second * 1000));
+  }
+}
+
 ELLE_TEST_SUITE()
 {
   auto timeout = 3;
@@ -159,4 +687,19 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(read_escaped_utf_8), 0, timeout);
   suite.add(BOOST_TEST_CASE(write_utf_8), 0, timeout);
   suite.add(BOOST_TEST_CASE(pretty_printer_utf_8), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_numbers), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_strings), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_containers), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_deep), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_stream), 0, timeout);
+  suite.add(BOOST_TEST_CASE(read_file), 0, timeout);
+  suite.add(BOOST_TEST_CASE(instruction_set), 0, timeout);
+  suite.add(BOOST_TEST_CASE(value_scalars), 0, timeout);
+  suite.add(BOOST_TEST_CASE(value_containers), 0, timeout);
+  suite.add(BOOST_TEST_CASE(value_json), 0, timeout);
+  suite.add(BOOST_TEST_CASE(value_read), 0, timeout);
+  suite.add(BOOST_TEST_CASE(value_deep), 0, timeout);
+  suite.add(BOOST_TEST_CASE(corpora_instruction_sets), 0, timeout);
+  if (benchmarks())
+    suite.add(BOOST_TEST_CASE(benchmark), 0, 60);
 }
@@ -4,9 +4,11 @@ ELLE_LOG_COMPONENT("elle.protocol.Channel.test");
 
 #include <elle/compiler.hh>
 #include <elle/test.hh>
+#include <elle/With.hh>
 
 #include <elle/protocol/ChanneledStream.hh>
 #include <elle/protocol/Serializer.hh>
+#include <elle/reactor/Scope.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/network/TCPServer.hh>
 #include <elle/reactor/network/TCPSocket.hh>
@@ -80,6 +82,182 @@ ELLE_TEST_SCHEDULED(eof_read)
     });
 }
 
+/*-------------.
+| Flow control |
+`-------------*/
+
+/// Two ChanneledStream connected through a local TCP socket.
+class Connection
+{
+public:
+  Connection(elle::Buffer::Size window,
+             elle::Buffer::Size frame_size,
+             elle::Version const& version = elle::Version(0, 5, 0))
+  {
+    auto listener = elle::reactor::network::TCPServer{};
+    listener.listen();
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+    {
+      scope.run_background("server", [&] {
+        this->server_socket = listener.accept();
+        this->server_serializer = std::make_unique<elle::protocol::Serializer>(
+          *this->server_socket, version);
+        this->server = std::make_unique<elle::protocol::ChanneledStream>(
+          *this->server_serializer, window, frame_size);
+      });
+      this->client_socket =
+        std::make_unique<elle::reactor::network::TCPSocket>(
+          elle::reactor::network::TCPSocket::EndPoint(
+            boost::asio::ip::address::from_string("127.0.0.1"),
+            listener.port()));
+      this->client_serializer = std::make_unique<elle::protocol::Serializer>(
+        *this->client_socket, version);
+      this->client = std::make_unique<elle::protocol::ChanneledStream>(
+        *this->client_serializer, window, frame_size);
+      elle::reactor::wait(scope);
+    };
+  }
+
+  std::unique_ptr<elle::reactor::network::Socket> server_socket;
+  std::unique_ptr<elle::protocol::Serializer> server_serializer;
+  std::unique_ptr<elle::protocol::ChanneledStream> server;
+  std::unique_ptr<elle::reactor::network::TCPSocket> client_socket;
+  std::unique_ptr<elle::protocol::Serializer> client_serializer;
+  std::unique_ptr<elle::protocol::ChanneledStream> client;
+};
+
+ELLE_TEST_SCHEDULED(legacy)
+{
+  auto c = Connection(1024, 256, elle::Version(0, 4, 0));
+  BOOST_TEST(!c.client->flow_control());
+  BOOST_TEST(!c.server->flow_control());
+  auto const data = elle::Buffer(std::string(4096, 'x'));
+  auto channel = elle::protocol::Channel(*c.client);
+  channel.write(data);
+  auto peer = c.server->accept();
+  BOOST_TEST(peer.read() == data);
+  BOOST_TEST(channel.statistics().frames_sent == 0u);
+}
+
+// A small packet on a channel with a higher priority is not held back by a
+// large packet being sent.
+ELLE_TEST_SCHEDULED(priority)
+{
+  auto c = Connection(1 << 22, 1024);
+  BOOST_TEST(c.client->flow_control());
+  BOOST_TEST(c.server->flow_control());
+  auto const bulk_data = elle::Buffer(std::string(1 << 20, 'b'));
+  auto const urgent_data = elle::Buffer("urgent");
+  auto bulk = elle::protocol::Channel(*c.client);
+  auto urgent = elle::protocol::Channel(*c.client);
+  urgent.priority(1);
+  auto bulk_frames = std::size_t{0};
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    scope.run_background("bulk", [&] { bulk.write(bulk_data); });
+    scope.run_background("urgent", [&] {
+      while (bulk.statistics().frames_sent < 2)
+        elle::reactor::yield();
+      urgent.write(urgent_data);
+      bulk_frames = bulk.statistics().frames_sent;
+    });
+    scope.run_background("server", [&] {
+      auto first = c.server->accept();
+      BOOST_TEST(first.read() == urgent_data);
+      auto second = c.server->accept();
+      BOOST_TEST(second.read() == bulk_data);
+    });
+    elle::reactor::wait(scope);
+  };
+  BOOST_TEST_MESSAGE(elle::sprintf("urgent packet sent after %s bulk frames",
+                                   bulk_frames));
+  BOOST_TEST(bulk_frames < bulk_data.size() / 1024);
+  BOOST_TEST(bulk.statistics().frames_sent == bulk_data.size() / 1024);
+  BOOST_TEST(urgent.statistics().frames_sent == 1u);
+}
+
+// A writer blocks once the peer holds a window worth of unread bytes, and
+// resumes as they are read.
+ELLE_TEST_SCHEDULED(window)
+{
+  auto const window = elle::Buffer::Size{4096};
+  auto const packet = elle::Buffer(std::string(1000, 'p'));
+  auto const count = 20;
+  auto c = Connection(window, 512);
+  auto channel = elle::protocol::Channel(*c.client);
+  auto written = 0;
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    scope.run_background("writer", [&] {
+      for (; written < count; ++written)
+        channel.write(packet);
+    });
+    auto peer = c.server->accept();
+    elle::reactor::sleep(100_ms);
+    // Packets are sent while the window is open: 4096, 3096, 2096, 1096, 96.
+    BOOST_TEST(written == 5);
+    BOOST_TEST(channel.statistics().send_window <= 0);
+    BOOST_TEST(peer.statistics().queued_packets == 5u);
+    BOOST_TEST(peer.statistics().queued_bytes == 5000u);
+    for (int i = 0; i < count; ++i)
+      BOOST_TEST(peer.read() == packet);
+    elle::reactor::wait(scope);
+    BOOST_TEST(peer.statistics().queued_bytes == 0u);
+    BOOST_TEST(peer.statistics().queued_bytes_max <= window + packet.size());
+  };
+  BOOST_TEST(written == count);
+  BOOST_TEST(channel.statistics().credit_wait > elle::Duration());
+}
+
+// A packet whose writer is terminated is dropped by the peer, and the channel
+// remains usable.
+ELLE_TEST_SCHEDULED(interrupt)
+{
+  auto c = Connection(1 << 22, 1024);
+  auto const big = elle::Buffer(std::string(1 << 20, 'b'));
+  auto const small = elle::Buffer("small");
+  auto channel = elle::protocol::Channel(*c.client);
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    auto& writer = scope.run_background("writer", [&] { channel.write(big); });
+    while (channel.statistics().frames_sent < 2)
+      elle::reactor::yield();
+    writer.terminate_now();
+    BOOST_TEST(channel.statistics().frames_sent < big.size() / 1024);
+    BOOST_TEST(channel.statistics().send_window == 1 << 22);
+    channel.write(small);
+    auto peer = c.server->accept();
+    BOOST_TEST(peer.read() == small);
+  };
+}
+
+// Invalid parameters are rejected before the handshake, which would block
+// since the peer never builds its ChanneledStream.
+ELLE_TEST_SCHEDULED(invalid_parameters)
+{
+  auto listener = elle::reactor::network::TCPServer{};
+  listener.listen();
+  auto done = elle::reactor::Barrier{};
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    scope.run_background("server", [&] {
+      auto socket = listener.accept();
+      auto&& ser = elle::protocol::Serializer(*socket);
+      elle::reactor::wait(done);
+    });
+    auto socket = elle::reactor::network::TCPSocket(
+      elle::reactor::network::TCPSocket::EndPoint(
+        boost::asio::ip::address::from_string("127.0.0.1"), listener.port()));
+    auto&& ser = elle::protocol::Serializer(socket);
+    BOOST_CHECK_THROW(elle::protocol::ChanneledStream(ser, 0, 512),
+                      elle::Error);
+    BOOST_CHECK_THROW(elle::protocol::ChanneledStream(ser, 4096, 0),
+                      elle::Error);
+    done.open();
+    elle::reactor::wait(scope);
+  };
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
@@ -89,4 +267,13 @@ ELLE_TEST_SUITE()
     eof->add(ELLE_TEST_CASE(eof_accept, "accept"), 0, valgrind(2));
     eof->add(ELLE_TEST_CASE(eof_read, "read"), 0, valgrind(2));
   }
+  {
+    auto flow = BOOST_TEST_SUITE("flow_control");
+    suite.add(flow);
+    flow->add(BOOST_TEST_CASE(legacy), 0, valgrind(2));
+    flow->add(BOOST_TEST_CASE(priority), 0, valgrind(5));
+    flow->add(BOOST_TEST_CASE(window), 0, valgrind(2));
+    flow->add(BOOST_TEST_CASE(interrupt), 0, valgrind(5));
+    flow->add(BOOST_TEST_CASE(invalid_parameters), 0, valgrind(2));
+  }
 }
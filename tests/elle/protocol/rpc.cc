@@ -1,13 +1,18 @@
+#include <chrono>
+#include <deque>
+
 #include <elle/protocol/ChanneledStream.hh>
 #include <elle/protocol/RPC.hh>
 #include <elle/protocol/Serializer.hh>
 
+#include <elle/serialization/binary.hh>
+
 #include <elle/reactor/asio.hh>
+#include <elle/reactor/exception.hh>
 #include <elle/reactor/network/Error.hh>
 #include <elle/reactor/network/TCPServer.hh>
 #include <elle/reactor/network/TCPSocket.hh>
 #include <elle/reactor/scheduler.hh>
-#include <elle/reactor/scheduler.hh>
 #include <elle/reactor/semaphore.hh>
 #include <elle/reactor/Thread.hh>
 
@@ -20,18 +25,71 @@ struct TestConfig
   bool sync;
   bool checksum;
   elle::Version version;
+  /// Serve with pool_run with that many workers, if any.
+  int workers = 0;
+  int queue_size = 0;
 };
 
 static
 elle::reactor::Thread* suicide_thread(nullptr);
 
+// Archives streaming values through the binary serialization, as RPC expects.
+class InputArchive
+{
+public:
+  InputArchive(std::istream& input)
+    : _serializer(input, false)
+  {}
+
+  template <typename T>
+  InputArchive&
+  operator >>(T& v)
+  {
+    this->_serializer.serialize_forward(v);
+    return *this;
+  }
+
+  InputArchive&
+  operator >>(char& v)
+  {
+    auto c = int8_t{};
+    this->_serializer.serialize_forward(c);
+    v = c;
+    return *this;
+  }
+
+private:
+  elle::serialization::binary::SerializerIn _serializer;
+};
+
+class OutputArchive
+{
+public:
+  OutputArchive(std::ostream& output)
+    : _serializer(output, false)
+  {}
+
+  template <typename T>
+  OutputArchive&
+  operator <<(T const& v)
+  {
+    auto copy = v;
+    this->_serializer.serialize_forward(copy);
+    return *this;
+  }
+
+private:
+  elle::serialization::binary::SerializerOut _serializer;
+};
+
+using Input = InputArchive;
+using Output = OutputArchive;
+
 struct DummyRPC:
-  public elle::protocol::RPC<elle::serialize::InputBinaryArchive,
-                                elle::serialize::OutputBinaryArchive>
+  public elle::protocol::RPC<Input, Output>
 {
   DummyRPC(elle::protocol::ChanneledStream& channels)
-    : elle::protocol::RPC<elle::serialize::InputBinaryArchive,
-                             elle::serialize::OutputBinaryArchive>(channels)
+    : elle::protocol::RPC<Input, Output>(channels)
     , answer("answer", *this)
     , square("square", *this)
     , concat("concat", *this)
@@ -39,6 +97,8 @@ struct DummyRPC:
     , suicide("suicide", *this)
     , count("count", *this)
     , wait("wait", *this)
+    , delay("delay", *this)
+    , overloaded("overloaded", *this)
   {}
 
   RemoteProcedure<int> answer;
@@ -48,6 +108,8 @@ struct DummyRPC:
   RemoteProcedure<void> suicide;
   RemoteProcedure<int> count;
   RemoteProcedure<void> wait;
+  RemoteProcedure<int, int> delay;
+  RemoteProcedure<void> overloaded;
 };
 
 class RPCServer
@@ -56,7 +118,8 @@ public:
   RPCServer(TestConfig config)
     : _config(config)
     , _counter(0)
-    , _server()
+    , _rpc(nullptr)
+    , _server(true)
     , _thread(elle::sprintf("%s runner", *this), [this] { this->_run(); })
   {
     this->_server.listen();
@@ -82,12 +145,13 @@ public:
   void
   _run()
   {
-    auto& sched = *elle::reactor::Scheduler::scheduler();
     auto socket = this->_server.accept();
-    elle::protocol::Serializer s(sched, *socket, _config.version, _config.checksum);
-    elle::protocol::ChanneledStream channels(sched, s, _config.version);
+    elle::protocol::Serializer s(*socket, _config.version, _config.checksum);
+    elle::protocol::ChanneledStream channels(s);
 
     DummyRPC rpc(channels);
+    this->_rpc = &rpc;
+    elle::SafeFinally reset([this] { this->_rpc = nullptr; });
     rpc.answer = [] { return 42; };
     rpc.square = [] (int x) { return x * x; };
     rpc.concat = []
@@ -97,12 +161,8 @@ public:
       {
         suicide_thread->terminate();
         suicide_thread = nullptr;
-        elle::reactor::yield();
-        elle::reactor::yield();
-        elle::reactor::yield();
-        elle::reactor::yield();
-        elle::reactor::yield();
-        elle::reactor::yield();
+        // Terminated along with the server before waking up.
+        elle::reactor::sleep(5_sec);
         BOOST_CHECK(false);
       };
     rpc.count =
@@ -113,9 +173,20 @@ public:
         return this->_counter;
       };
     rpc.wait = [this] { ++this->_counter; elle::reactor::sleep(); };
+    rpc.delay = [] (int ms)
+      {
+        elle::reactor::sleep(boost::posix_time::milliseconds(ms));
+        return ms;
+      };
+    rpc.overloaded = []
+      {
+        throw std::runtime_error(elle::protocol::RPCOverloaded::reason);
+      };
     try
     {
-      if (this->_config.sync)
+      if (this->_config.workers)
+        rpc.pool_run(this->_config.workers, this->_config.queue_size);
+      else if (this->_config.sync)
         rpc.run();
       else
         rpc.parallel_run();
@@ -127,6 +198,8 @@ public:
   ELLE_ATTRIBUTE_R(TestConfig, config);
   ELLE_ATTRIBUTE_R(int, counter);
   ELLE_ATTRIBUTE_RX(elle::reactor::Barrier, count_barrier)
+  /// The served RPC, once connected.
+  ELLE_ATTRIBUTE_R(DummyRPC*, rpc);
   ELLE_ATTRIBUTE(elle::reactor::network::TCPServer, server);
   ELLE_ATTRIBUTE(elle::reactor::Thread, thread);
 };
@@ -140,7 +213,7 @@ ELLE_TEST_SCHEDULED(rpc, (TestConfig, config))
   RPCServer server(config);
   elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
   elle::protocol::Serializer s(socket, config.version, config.checksum);
-  elle::protocol::ChanneledStream channels(s, config.version);
+  elle::protocol::ChanneledStream channels(s);
   DummyRPC rpc(channels);
   BOOST_CHECK_EQUAL(rpc.answer(), 42);
   BOOST_CHECK_EQUAL(rpc.square(8), 64);
@@ -161,7 +234,7 @@ ELLE_TEST_SCHEDULED(terminate, (TestConfig, config))
     {
       elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
       elle::protocol::Serializer s(socket, config.version, config.checksum);
-      elle::protocol::ChanneledStream channels(s, config.version);
+      elle::protocol::ChanneledStream channels(s);
       DummyRPC rpc(channels);
       suicide_thread = &thread;
       BOOST_CHECK_THROW(rpc.suicide(), std::runtime_error);
@@ -178,7 +251,7 @@ ELLE_TEST_SCHEDULED(parallel, (TestConfig, config))
   RPCServer server(config);
   elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
   elle::protocol::Serializer s(socket, config.version, config.checksum);
-  elle::protocol::ChanneledStream channels(s, config.version);
+  elle::protocol::ChanneledStream channels(s);
   DummyRPC rpc(channels);
   std::vector<elle::reactor::Thread*> threads;
   std::list<int> inserted;
@@ -220,7 +293,7 @@ ELLE_TEST_SCHEDULED(disconnection, (TestConfig, config))
   RPCServer server(config);
   elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
   elle::protocol::Serializer s(socket, config.version, config.checksum);
-  elle::protocol::ChanneledStream channels(s, config.version);
+  elle::protocol::ChanneledStream channels(s);
   DummyRPC rpc(channels);
   elle::reactor::Thread call_1("call 1",
                          [&]
@@ -241,6 +314,397 @@ ELLE_TEST_SCHEDULED(disconnection, (TestConfig, config))
   elle::reactor::wait({call_1, call_2});
 }
 
+/*-------------.
+| Asynchronous |
+`-------------*/
+
+ELLE_TEST_SCHEDULED(pipeline, (TestConfig, config))
+{
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  // Send all calls before reading any response.
+  auto calls = std::vector<elle::protocol::PendingCall<Input, int>>{};
+  for (int i = 0; i < 16; ++i)
+    calls.emplace_back(rpc.square.call(i));
+  for (int i = 15; i >= 0; --i)
+  {
+    BOOST_TEST(calls[i].pending());
+    BOOST_TEST(calls[i].get() == i * i);
+    BOOST_TEST(!calls[i].pending());
+  }
+  // Responses of concurrent calls come back in any order.
+  auto slow = rpc.delay.call(200);
+  auto fast = rpc.delay.call(1);
+  BOOST_TEST(fast.get() == 1);
+  BOOST_TEST(slow.get() == 200);
+  auto raise = rpc.raise.call();
+  BOOST_CHECK_THROW(raise.get(), elle::protocol::RPCError);
+}
+
+ELLE_TEST_SCHEDULED(timeout, (TestConfig, config))
+{
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  {
+    auto call = rpc.delay.call(200);
+    BOOST_CHECK_THROW(call.get(10_ms), elle::reactor::Timeout);
+    BOOST_TEST(!call.pending());
+  }
+  {
+    auto call = rpc.delay.call(100);
+    call.cancel();
+    BOOST_TEST(!call.pending());
+  }
+  // Late responses are discarded and do not disturb other calls.
+  BOOST_TEST(rpc.delay(300) == 300);
+  BOOST_TEST(rpc.answer() == 42);
+}
+
+/*------.
+| Pool |
+`------*/
+
+ELLE_TEST_SCHEDULED(pool)
+{
+  RPCServer server(TestConfig{false, true, {0, 4, 0}, 2, 4});
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, elle::Version(0, 4, 0), true);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  BOOST_TEST(rpc.answer() == 42);
+  BOOST_CHECK_THROW(rpc.raise(), std::runtime_error);
+  // Two workers run concurrently, the other calls wait.
+  auto const start = std::chrono::steady_clock::now();
+  auto calls = std::vector<elle::protocol::PendingCall<Input, int>>{};
+  for (int i = 0; i < 6; ++i)
+    calls.emplace_back(rpc.delay.call(50));
+  for (auto& call: calls)
+    BOOST_TEST(call.get() == 50);
+  BOOST_TEST((std::chrono::steady_clock::now() - start >=
+              std::chrono::milliseconds(150)));
+  auto const& statistics = server.rpc()->statistics();
+  auto const& delay = statistics.at("delay");
+  BOOST_TEST(delay.calls == 6u);
+  BOOST_TEST(delay.rejected == 0u);
+  BOOST_TEST(delay.queued == 0);
+  BOOST_TEST(delay.running == 0);
+  BOOST_TEST(delay.run_time >= 300_ms);
+  BOOST_TEST(delay.wait_time >= 100_ms);
+  BOOST_TEST(statistics.at("answer").calls == 1u);
+  BOOST_TEST(statistics.at("raise").calls == 1u);
+}
+
+ELLE_TEST_SCHEDULED(pool_overload)
+{
+  RPCServer server(TestConfig{false, true, {0, 7, 0}, 1, 1});
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, elle::Version(0, 7, 0), true);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  // One call runs, one waits, the others are rejected.
+  auto running = rpc.delay.call(100);
+  auto waiting = rpc.delay.call(10);
+  auto rejected = rpc.delay.call(1);
+  auto square = rpc.square.call(3);
+  BOOST_CHECK_THROW(rejected.get(), elle::protocol::RPCOverloaded);
+  BOOST_CHECK_THROW(square.get(), elle::protocol::RPCOverloaded);
+  BOOST_TEST(running.get() == 100);
+  BOOST_TEST(waiting.get() == 10);
+  // Once the queue drained, calls are admitted again.
+  BOOST_TEST(rpc.square(4) == 16);
+  auto const& statistics = server.rpc()->statistics();
+  BOOST_TEST(statistics.at("delay").calls == 2u);
+  BOOST_TEST(statistics.at("delay").rejected == 1u);
+  BOOST_TEST(statistics.at("delay").wait_time >= 50_ms);
+  BOOST_TEST(statistics.at("square").calls == 1u);
+  BOOST_TEST(statistics.at("square").rejected == 1u);
+  // A procedure failing with the overload message was not rejected.
+  try
+  {
+    rpc.overloaded();
+    BOOST_FAIL("procedure did not fail");
+  }
+  catch (elle::protocol::RPCOverloaded const&)
+  {
+    BOOST_FAIL("procedure failure taken for an overload");
+  }
+  catch (elle::protocol::RPCError const&)
+  {}
+}
+
+ELLE_TEST_SCHEDULED(pool_overload_legacy)
+{
+  // Peers predating the overloaded status are sent a plain failure.
+  RPCServer server(TestConfig{false, true, {0, 4, 0}, 1, 0});
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, elle::Version(0, 4, 0), true);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  auto running = rpc.delay.call(100);
+  auto rejected = rpc.delay.call(1);
+  try
+  {
+    rejected.get();
+    BOOST_FAIL("call was not rejected");
+  }
+  catch (elle::protocol::RPCOverloaded const&)
+  {
+    BOOST_FAIL("overloaded status sent to a legacy peer");
+  }
+  catch (elle::protocol::RPCError const& e)
+  {
+    BOOST_TEST(std::string(e.what()).find(
+                 elle::protocol::RPCOverloaded::reason) != std::string::npos);
+  }
+  BOOST_TEST(running.get() == 100);
+}
+
+/*-------.
+| Codecs |
+`-------*/
+
+using BinaryIn = elle::serialization::binary::SerializerIn;
+using BinaryOut = elle::serialization::binary::SerializerOut;
+
+template <typename Writer>
+static
+elle::Buffer
+encode_values()
+{
+  auto writer = Writer();
+  writer << uint32_t(7) << 42 << int64_t(-(int64_t(1) << 40))
+         << std::string("foo") << true << 3.5 << elle::Buffer("bar")
+         << int8_t(-3) << std::vector<int>{1, 2, 3};
+  return writer.finish();
+}
+
+template <typename Reader>
+static
+void
+decode_values(elle::Buffer const& message)
+{
+  auto reader = Reader(message);
+  BOOST_TEST(reader.template get<uint32_t>() == 7u);
+  BOOST_TEST(reader.template get<int>() == 42);
+  BOOST_TEST(reader.template get<int64_t>() == -(int64_t(1) << 40));
+  BOOST_TEST(reader.template get<std::string>() == "foo");
+  BOOST_TEST(reader.template get<bool>());
+  BOOST_TEST(reader.template get<double>() == 3.5);
+  BOOST_TEST(reader.template get<elle::Buffer>() == "bar");
+  auto c = char{};
+  reader >> c;
+  BOOST_TEST(c == -3);
+  BOOST_TEST((reader.template get<std::vector<int>>() ==
+              std::vector<int>{1, 2, 3}));
+}
+
+// A value that can only be built by deserialization.
+struct Meters
+{
+  Meters(int value)
+    : value(value)
+  {}
+
+  Meters(elle::serialization::SerializerIn& input)
+    : value(input.deserialize<int>("value"))
+  {}
+
+  void
+  serialize(elle::serialization::Serializer& s)
+  {
+    s.serialize("value", this->value);
+  }
+
+  int value;
+};
+
+static
+void
+codec()
+{
+  // The binary codec is compatible with binary serializers.
+  auto const streamed = encode_values<elle::protocol::RPCWriter<Output>>();
+  auto const direct = encode_values<elle::protocol::RPCWriter<BinaryOut>>();
+  BOOST_TEST(streamed == direct);
+  decode_values<elle::protocol::RPCReader<Input>>(direct);
+  decode_values<elle::protocol::RPCReader<BinaryIn>>(streamed);
+  {
+    auto writer = elle::protocol::RPCWriter<BinaryOut>();
+    writer << 300 << std::string("truncated");
+    auto const message = writer.finish();
+    auto reader = elle::protocol::RPCReader<BinaryIn>(message);
+    BOOST_CHECK_THROW(reader.get<int8_t>(), elle::serialization::Error);
+    auto const truncated = message.range(0, message.size() - 1);
+    auto truncated_reader = elle::protocol::RPCReader<BinaryIn>(truncated);
+    BOOST_TEST(truncated_reader.get<int>() == 300);
+    BOOST_CHECK_THROW(truncated_reader.get<std::string>(),
+                      elle::serialization::Error);
+  }
+  // Arguments need not be default constructible.
+  {
+    auto writer = elle::protocol::RPCWriter<BinaryOut>();
+    writer << Meters(3) << Meters(4);
+    auto const message = writer.finish();
+    auto reader = elle::protocol::RPCReader<BinaryIn>(message);
+    BOOST_TEST(reader.get<Meters>().value == 3);
+    auto const f = std::function<int (Meters const&)>(
+      [] (Meters const& m) { return m.value; });
+    BOOST_TEST((elle::protocol::Call<elle::protocol::RPCReader<BinaryIn>,
+                int, Meters const&>::call(reader, f)) == 4);
+  }
+}
+
+// Marshal a 3 arguments call and its reply, as done by RPC.
+template <typename IS, typename OS>
+static
+double
+marshal(int count)
+{
+  auto const f = std::function<std::string (int, std::string const&,
+                                            std::string const&)>(
+    [] (int, std::string const& a, std::string const& b)
+    {
+      return a + b;
+    });
+  auto const a = std::string("some argument");
+  auto const b = std::string("some other argument");
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; ++i)
+  {
+    auto const id = uint32_t(3);
+    auto output = elle::protocol::RPCWriter<OS>(
+      elle::protocol::RPCWriter<OS>::size_hint(id, i, a, b));
+    output << id << i << a << b;
+    auto const question = output.finish();
+    auto input = elle::protocol::RPCReader<IS>(question);
+    BOOST_TEST(input.template get<uint32_t>() == id);
+    auto res = elle::protocol::Call<
+      elle::protocol::RPCReader<IS>, std::string,
+      int, std::string const&, std::string const&>::call(input, f);
+    auto reply = elle::protocol::RPCWriter<OS>();
+    reply << true << res;
+    auto const answer = reply.finish();
+    auto result = elle::protocol::RPCReader<IS>(answer);
+    BOOST_TEST(result.template get<bool>());
+    BOOST_TEST(result.template get<std::string>() == a + b);
+  }
+  return count / std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+}
+
+static
+void
+codec_benchmark()
+{
+  auto const count = 20000;
+  auto const streamed = marshal<Input, Output>(count);
+  auto const direct = marshal<BinaryIn, BinaryOut>(count);
+  BOOST_TEST_MESSAGE(
+    elle::sprintf("3 arguments calls marshalled: %.0f/s streamed, "
+                  "%.0f/s with the binary codec (x%.1f)",
+                  streamed, direct, direct / streamed));
+}
+
+struct BinaryRPC:
+  public elle::protocol::RPC<BinaryIn, BinaryOut>
+{
+  BinaryRPC(elle::protocol::ChanneledStream& channels)
+    : elle::protocol::RPC<BinaryIn, BinaryOut>(channels)
+    , answer("answer", *this)
+    , square("square", *this)
+    , concat("concat", *this)
+    , raise("raise", *this)
+  {}
+
+  RemoteProcedure<int> answer;
+  RemoteProcedure<int, int> square;
+  RemoteProcedure<std::string, std::string const&, std::string const&> concat;
+  RemoteProcedure<void> raise;
+};
+
+// Serve with the binary codec, call with streamed binary serializers and the
+// binary codec.
+ELLE_TEST_SCHEDULED(binary)
+{
+  elle::reactor::network::TCPServer server(true);
+  server.listen();
+  elle::reactor::Thread serve(
+    "serve",
+    [&]
+    {
+      auto socket = server.accept();
+      elle::protocol::Serializer s(*socket, elle::Version(0, 4, 0), true);
+      elle::protocol::ChanneledStream channels(s);
+      BinaryRPC rpc(channels);
+      rpc.answer = [] { return 42; };
+      rpc.square = [] (int x) { return x * x; };
+      rpc.concat = []
+        (std::string const& a, std::string const& b) { return a + b; };
+      rpc.raise = [] { throw std::runtime_error("blablabla"); };
+      rpc.run();
+    });
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, elle::Version(0, 4, 0), true);
+  elle::protocol::ChanneledStream channels(s);
+  {
+    DummyRPC rpc(channels);
+    BOOST_TEST(rpc.answer() == 42);
+    BOOST_TEST(rpc.square(8) == 64);
+    BOOST_TEST(rpc.concat("foo", "bar") == "foobar");
+    BOOST_CHECK_THROW(rpc.raise(), elle::protocol::RPCError);
+  }
+  {
+    BinaryRPC rpc(channels);
+    BOOST_TEST(rpc.answer() == 42);
+    BOOST_TEST(rpc.square(-9) == 81);
+    BOOST_TEST(rpc.concat("foo", "bar") == "foobar");
+    BOOST_CHECK_THROW(rpc.raise(), elle::protocol::RPCError);
+  }
+  serve.terminate_now();
+}
+
+/*-----.
+| Load |
+`-----*/
+
+// Measure calls per second depending on the number of calls in flight.
+ELLE_TEST_SCHEDULED(load, (TestConfig, config))
+{
+  RPCServer server(config);
+  elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+  elle::protocol::Serializer s(socket, config.version, config.checksum);
+  elle::protocol::ChanneledStream channels(s);
+  DummyRPC rpc(channels);
+  auto const count = 2000;
+  for (auto depth: {1, 4, 16, 64})
+  {
+    auto calls = std::deque<elle::protocol::PendingCall<Input, int>>{};
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+      if (calls.size() == unsigned(depth))
+      {
+        BOOST_TEST(calls.front().get() >= 0);
+        calls.pop_front();
+      }
+      calls.emplace_back(rpc.square.call(i % 1000));
+    }
+    for (auto& call: calls)
+      BOOST_TEST(call.get() >= 0);
+    auto const duration = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    BOOST_TEST_MESSAGE(
+      elle::sprintf("%s calls with %s in flight: %.0f calls/s",
+                    count, depth, count / duration));
+  }
+}
+
 /*-----------.
 | Test suite |
 `-----------*/
@@ -263,12 +727,33 @@ ELLE_TEST_SUITE()
   };
   auto test = [&](std::string const& name, std::function<void(TestConfig)> f)
   {
-    for (int i=0; i<8; ++i)
-      suite.add(
-        BOOST_TEST_CASE(std::bind(f, configs[i])), 0, valgrind(1, 10));
+    auto sub = BOOST_TEST_SUITE(name);
+    suite.add(sub);
+    for (auto const& config: configs)
+      sub->add(
+        ELLE_TEST_CASE(std::bind(f, config),
+                       elle::sprintf("%s_%s_%s",
+                                     config.sync ? "sync" : "async",
+                                     config.checksum ? "checksum" : "plain",
+                                     config.version)),
+        0, valgrind(1, 10));
   };
   test("rpc", &rpc);
   test("terminate", &terminate);
   test("parallel", &parallel);
   test("disconnection", &disconnection);
+  test("pipeline", &pipeline);
+  test("timeout", &timeout);
+  suite.add(BOOST_TEST_CASE(pool), 0, valgrind(1, 10));
+  suite.add(BOOST_TEST_CASE(codec), 0, valgrind(1, 10));
+  if (benchmarks())
+    suite.add(BOOST_TEST_CASE(codec_benchmark), 0, valgrind(10, 10));
+  suite.add(BOOST_TEST_CASE(binary), 0, valgrind(1, 10));
+  suite.add(BOOST_TEST_CASE(pool_overload), 0, valgrind(1, 10));
+  suite.add(BOOST_TEST_CASE(pool_overload_legacy), 0, valgrind(1, 10));
+  if (benchmarks())
+    suite.add(
+      ELLE_TEST_CASE(std::bind(load, TestConfig{false, true, {0, 4, 0}}),
+                     "load"),
+      0, valgrind(10, 10));
 }
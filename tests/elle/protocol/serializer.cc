@@ -10,6 +10,7 @@
 
 #include <elle/protocol/Channel.hh>
 #include <elle/protocol/ChanneledStream.hh>
+#include <elle/protocol/Checksum.hh>
 #include <elle/protocol/exceptions.hh>
 
 #include <elle/reactor/Barrier.hh>
@@ -21,6 +22,8 @@
 #include <elle/reactor/network/TCPSocket.hh>
 #include <elle/reactor/scheduler.hh>
 
+#include <elle/serialization/binary.hh>
+
 ELLE_LOG_COMPONENT("elle.protocol.test");
 
 constexpr static elle::Buffer::Size buffer_size = 4096;
@@ -407,7 +410,8 @@ dialog(elle::Version const& version,
 
 #define CASES(function)                                                 \
   for (auto const& version: {elle::Version{0, 1, 0},                    \
-                             elle::Version{0, 2, 0}})                   \
+                             elle::Version{0, 2, 0},                    \
+                             elle::Version{0, 4, 0}})                   \
     for (auto checksum: {true, false})                                  \
       ELLE_LOG("case: version = %s, checksum = %s", version, checksum)  \
         function(version, checksum)                                     \
@@ -500,6 +504,44 @@ ELLE_TEST_SCHEDULED(exchange)
   CASES(_exchange);
 }
 
+static
+void
+_exchange_header(elle::Version const& version,
+                 bool checksum)
+{
+  auto const header = elle::Buffer("header");
+  auto const packets = std::vector<elle::Buffer>{
+    elle::Buffer(),
+    elle::Buffer("some data 42"),
+    // Make sure the packet spans several chunks.
+    std::string((2 << 17) + 11, 'y'),
+  };
+  dialog<Connector>(version,
+         checksum,
+         [] (Connector&) {},
+         [&] (elle::protocol::Serializer& s)
+         {
+           for (auto const& p: packets)
+             s.write(header, p);
+         },
+         [&] (elle::protocol::Serializer& s)
+         {
+           for (auto const& p: packets)
+           {
+             auto expected = header;
+             expected.append(p.contents(), p.size());
+             BOOST_CHECK_EQUAL(s.read(), expected);
+           }
+         });
+}
+
+ELLE_TEST_SCHEDULED(exchange_header)
+{
+  CASES(_exchange_header);
+  for (auto checksum: {true, false})
+    _exchange_header(elle::Version{0, 3, 0}, checksum);
+}
+
 static
 void
 _connection_lost_reader(elle::Version const& version,
@@ -1091,14 +1133,477 @@ ELLE_TEST_SCHEDULED(read_interruption, (elle::Version, version))
   elle::reactor::wait(elle::reactor::Waitables({&writer, &reader}));
 }
 
+ELLE_TEST_SCHEDULED(checksum)
+{
+  using Checksum = elle::protocol::Checksum;
+  auto compute = [] (Checksum::Algorithm algorithm, std::string const& data)
+    {
+      auto checksum = Checksum(algorithm);
+      checksum.update(elle::ConstWeakBuffer(data));
+      return elle::sprintf("%x", checksum.finish());
+    };
+  BOOST_TEST(compute(Checksum::Algorithm::crc32c, "123456789") ==
+             "0xe3069283");
+  BOOST_TEST(compute(Checksum::Algorithm::xxhash64, "") ==
+             "0xef46db3751d8e999");
+  BOOST_TEST(compute(Checksum::Algorithm::xxhash64, "abc") ==
+             "0x44bc2cf5ad770999");
+  BOOST_TEST(compute(Checksum::Algorithm::xxhash64,
+                     "Nobody inspects the spammish repetition") ==
+             "0xfbcea83c8a378bf1");
+  BOOST_TEST(compute(Checksum::Algorithm::sha1, "abc") ==
+             "0xa9993e364706816aba3e25717850c26c9cd0d89d");
+  // Feeding data in pieces does not change the checksum.
+  auto const data = elle::cryptography::random::generate<elle::Buffer>(10000);
+  for (auto algorithm: {Checksum::Algorithm::sha1,
+                        Checksum::Algorithm::crc32c,
+                        Checksum::Algorithm::xxhash64})
+  {
+    auto whole = Checksum(algorithm);
+    whole.update(data);
+    auto pieces = Checksum(algorithm);
+    auto offset = elle::Buffer::Size{0};
+    for (auto size: {0, 1, 7, 31, 32, 33, 100, 1000})
+    {
+      pieces.update(elle::ConstWeakBuffer(data.contents() + offset, size));
+      offset += size;
+    }
+    pieces.update(elle::ConstWeakBuffer(data.contents() + offset,
+                                        data.size() - offset));
+    BOOST_TEST(whole.finish() == pieces.finish(), algorithm);
+  }
+  // Negotiation.
+  auto constexpr sha1 = Checksum::Algorithms(Checksum::Algorithm::sha1);
+  auto constexpr crc32c = Checksum::Algorithms(Checksum::Algorithm::crc32c);
+  auto constexpr xxhash64 = Checksum::Algorithms(Checksum::Algorithm::xxhash64);
+  BOOST_TEST(Checksum::negotiate(Checksum::all, Checksum::all) ==
+             Checksum::Algorithm::crc32c);
+  BOOST_TEST(Checksum::negotiate(Checksum::all, xxhash64 | sha1) ==
+             Checksum::Algorithm::xxhash64);
+  BOOST_TEST(Checksum::negotiate(sha1, Checksum::all) ==
+             Checksum::Algorithm::sha1);
+  BOOST_TEST(!Checksum::negotiate(0, Checksum::all));
+  BOOST_CHECK_THROW(Checksum::negotiate(crc32c, xxhash64),
+                    elle::protocol::Error);
+}
+
+static
+boost::optional<elle::protocol::Checksum::Algorithm>
+_negotiate(elle::Version const& alice_version,
+           bool alice_checksum,
+           elle::protocol::Checksum::Algorithms alice_checksums,
+           elle::Version const& bob_version,
+           bool bob_checksum,
+           elle::protocol::Checksum::Algorithms bob_checksums)
+{
+  SocketInstrumentation sockets;
+  std::unique_ptr<elle::protocol::Serializer> alice;
+  std::unique_ptr<elle::protocol::Serializer> bob;
+  elle::With<elle::reactor::Scope>() << [&](elle::reactor::Scope& scope)
+  {
+    scope.run_background(
+      "setup alice's serializer",
+      [&]
+      {
+        alice.reset(new elle::protocol::Serializer(
+                      sockets.alice(), alice_version, alice_checksum,
+                      {}, {}, 2 << 16, alice_checksums));
+      });
+    scope.run_background(
+      "setup bob's serializer",
+      [&]
+      {
+        bob.reset(new elle::protocol::Serializer(
+                    sockets.bob(), bob_version, bob_checksum,
+                    {}, {}, 2 << 16, bob_checksums));
+      });
+    scope.wait();
+  };
+  BOOST_TEST(alice->checksum_algorithm() == bob->checksum_algorithm());
+  BOOST_TEST(alice->checksum() == bool(alice->checksum_algorithm()));
+  auto const packet = elle::Buffer(std::string((2 << 16) + 11, 'y'));
+  alice->write(packet);
+  BOOST_TEST(bob->read() == packet);
+  return alice->checksum_algorithm();
+}
+
+ELLE_TEST_SCHEDULED(checksum_negotiation)
+{
+  using Checksum = elle::protocol::Checksum;
+  auto const v3 = elle::Version(0, 3, 0);
+  auto const v4 = elle::Version(0, 4, 0);
+  auto constexpr sha1 = Checksum::Algorithms(Checksum::Algorithm::sha1);
+  auto constexpr crc32c = Checksum::Algorithms(Checksum::Algorithm::crc32c);
+  auto constexpr xxhash64 = Checksum::Algorithms(Checksum::Algorithm::xxhash64);
+  BOOST_TEST(_negotiate(v4, true, Checksum::all, v4, true, Checksum::all) ==
+             Checksum::Algorithm::crc32c);
+  BOOST_TEST(_negotiate(v4, true, Checksum::all, v4, true, xxhash64 | sha1) ==
+             Checksum::Algorithm::xxhash64);
+  BOOST_TEST(_negotiate(v4, true, sha1, v4, true, Checksum::all) ==
+             Checksum::Algorithm::sha1);
+  // Checksums are only used if both ends enable them.
+  BOOST_TEST(!_negotiate(v4, false, Checksum::all, v4, true, Checksum::all));
+  // Older peers use SHA-1.
+  BOOST_TEST(_negotiate(v3, true, Checksum::all, v4, true, Checksum::all) ==
+             Checksum::Algorithm::sha1);
+  BOOST_CHECK_THROW(_negotiate(v4, true, crc32c, v4, true, xxhash64),
+                    elle::protocol::Error);
+}
+
+// The handshake and the first packet may be received in a single read: the
+// bytes the socket buffered past the handshake must not be lost.
+ELLE_TEST_SCHEDULED(handshake_read_ahead)
+{
+  using Checksum = elle::protocol::Checksum;
+  auto const v4 = elle::Version(0, 4, 0);
+  auto const crc32c = Checksum::Algorithms(Checksum::Algorithm::crc32c);
+  auto const packet = elle::Buffer("first packet");
+  // Record what a peer sends: its handshake followed by the packet.
+  auto peer = std::string{};
+  {
+    std::stringstream stream;
+    elle::serialization::binary::serialize(v4, stream);
+    stream.put(static_cast<char>(crc32c));
+    elle::protocol::Serializer s(stream, v4, true, boost::none, boost::none,
+                                 buffer_size, crc32c);
+    s.write(packet);
+    peer.assign(std::istreambuf_iterator<char>(stream),
+                std::istreambuf_iterator<char>());
+  }
+  auto server = elle::reactor::network::TCPServer{};
+  server.listen();
+  elle::reactor::network::TCPSocket client("127.0.0.1", server.port());
+  client.write(elle::ConstWeakBuffer(peer));
+  auto socket = server.accept();
+  elle::protocol::Serializer s(*socket, v4, true);
+  BOOST_TEST(s.checksum_algorithm() == Checksum::Algorithm::crc32c);
+  BOOST_TEST(s.read() == packet);
+}
+
+// Measure small request/response round-trips over loopback TCP, each on its
+// own channel as RPCs do.
+ELLE_TEST_SCHEDULED(benchmark_round_trips)
+{
+  namespace ip = elle::protocol;
+  auto const count = 2000;
+  auto server = elle::reactor::network::TCPServer{};
+  server.listen();
+  auto const request = elle::Buffer(std::string(32, 'q'));
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    scope.run_background(
+      "server",
+      [&]
+      {
+        auto socket = server.accept();
+        ip::Serializer s(*socket, elle::Version(0, 3, 0), true);
+        ip::ChanneledStream channels(s);
+        while (true)
+        {
+          auto channel = channels.accept();
+          channel.write(channel.read());
+        }
+      });
+    elle::reactor::network::TCPSocket socket("127.0.0.1", server.port());
+    ip::Serializer s(socket, elle::Version(0, 3, 0), true);
+    ip::ChanneledStream channels(s);
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+      ip::Channel channel(channels);
+      channel.write(request);
+      BOOST_TEST(channel.read() == request);
+    }
+    auto const duration = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    BOOST_TEST_MESSAGE(
+      elle::sprintf("%s round-trips in %.3fs: %.0f round-trips/s",
+                    count, duration, count / duration));
+    scope.terminate_now();
+  };
+}
+
+/*------------.
+| Compression |
+`------------*/
+
+ELLE_TEST_SCHEDULED(compression)
+{
+  using Compression = elle::protocol::Compression;
+  auto const header = elle::Buffer("header ");
+  auto const packet = elle::Buffer(
+    elle::sprintf("%s", std::vector<int>(1000, 42)));
+  auto const expected = [&]
+  {
+    auto res = header;
+    res.append(packet.contents(), packet.size());
+    return res;
+  }();
+  for (auto mode: {Compression::Mode::packet, Compression::Mode::stream})
+  {
+    auto writer = Compression(Compression::Algorithm::deflate, mode, 64);
+    auto reader = Compression(Compression::Algorithm::deflate, mode, 64);
+    for (int i = 0; i < 3; ++i)
+    {
+      auto compressed = writer.compress(header, packet);
+      BOOST_REQUIRE(compressed);
+      BOOST_TEST(compressed->size() < packet.size() / 10, mode);
+      // The last packet was lost: the next one restarts the stream.
+      if (i == 1)
+        writer.interrupted();
+      else
+        BOOST_TEST(reader.decompress(*compressed) == expected, mode);
+    }
+    // Small packets are sent as is.
+    auto const small = elle::Buffer("small");
+    BOOST_TEST(!writer.compress({}, small));
+    auto raw = writer.raw(header);
+    raw.append(small.contents(), small.size());
+    auto small_expected = header;
+    small_expected.append(small.contents(), small.size());
+    BOOST_TEST(reader.decompress(raw) == small_expected);
+    auto const& statistics = writer.statistics();
+    BOOST_TEST(statistics.compressed == 3u);
+    BOOST_TEST(statistics.uncompressed == 1u);
+    BOOST_TEST(statistics.bytes_in == 3 * expected.size());
+    BOOST_TEST(statistics.ratio() > 10);
+    BOOST_TEST(reader.statistics().decompressed == 2u);
+    BOOST_TEST_MESSAGE(elle::sprintf("%s mode: compression ratio %.1f",
+                                     mode, statistics.ratio()));
+  }
+  // Stream mode compresses repeated packets further.
+  {
+    auto independent = Compression(Compression::Algorithm::deflate,
+                                   Compression::Mode::packet, 0);
+    auto streamed = Compression(Compression::Algorithm::deflate,
+                                Compression::Mode::stream, 0);
+    auto const message = elle::Buffer(
+      "{\"name\": \"metadata\", \"owner\": \"alice\", \"size\": 1024}");
+    for (int i = 0; i < 10; ++i)
+    {
+      independent.compress({}, message);
+      streamed.compress({}, message);
+    }
+    BOOST_TEST(streamed.statistics().bytes_out <
+               independent.statistics().bytes_out / 2);
+  }
+  // Corruption.
+  {
+    auto writer = Compression(Compression::Algorithm::deflate);
+    auto reader = Compression(Compression::Algorithm::deflate);
+    auto compressed = *writer.compress(header, packet);
+    compressed.size(compressed.size() / 2);
+    BOOST_CHECK_THROW(reader.decompress(compressed), elle::protocol::Error);
+    BOOST_CHECK_THROW(reader.decompress(elle::Buffer("\x07")),
+                      elle::protocol::Error);
+    // A decompressed size the packet cannot hold is rejected before
+    // allocating it.
+    using BinaryOut = elle::serialization::binary::SerializerOut;
+    elle::Buffer::Byte size[BinaryOut::number_max_size];
+    auto bomb = elle::Buffer("\x01", 1);
+    bomb.append(size, BinaryOut::serialize_number(size, int64_t(1) << 40));
+    bomb.append("\x03\x00", 2);
+    BOOST_CHECK_THROW(reader.decompress(bomb), elle::protocol::Error);
+  }
+  BOOST_TEST(Compression::negotiate(Compression::all, Compression::all) ==
+             Compression::Algorithm::deflate);
+  BOOST_TEST(!Compression::negotiate(0, Compression::all));
+}
+
+// Set up two serializers with compression settings and exchange packets.
+static
+void
+_compression_negotiation(
+  elle::Version const& version,
+  boost::optional<elle::protocol::Compression::Settings> alice_settings,
+  boost::optional<elle::protocol::Compression::Settings> bob_settings,
+  bool compressed)
+{
+  SocketInstrumentation sockets;
+  std::unique_ptr<elle::protocol::Serializer> alice;
+  std::unique_ptr<elle::protocol::Serializer> bob;
+  elle::With<elle::reactor::Scope>() << [&](elle::reactor::Scope& scope)
+  {
+    scope.run_background(
+      "setup alice's serializer",
+      [&]
+      {
+        alice.reset(new elle::protocol::Serializer(
+                      sockets.alice(), version, true, {}, {}, 1024,
+                      elle::protocol::Checksum::all, {}, alice_settings));
+      });
+    scope.run_background(
+      "setup bob's serializer",
+      [&]
+      {
+        bob.reset(new elle::protocol::Serializer(
+                    sockets.bob(), version, true, {}, {}, 1024,
+                    elle::protocol::Checksum::all, {}, bob_settings));
+      });
+    scope.wait();
+  };
+  BOOST_TEST(alice->compression_algorithm() == bob->compression_algorithm());
+  BOOST_TEST(bool(alice->compression_algorithm()) == compressed);
+  auto const large = elle::Buffer(std::string(10000, 'c'));
+  auto const small = elle::Buffer("small");
+  for (int i = 0; i < 3; ++i)
+  {
+    alice->write(large);
+    BOOST_TEST(bob->read() == large);
+    bob->write(small);
+    BOOST_TEST(alice->read() == small);
+    bob->write(large);
+    BOOST_TEST(alice->read() == large);
+  }
+  BOOST_TEST(alice->compression_statistics().compressed ==
+             (compressed ? 3u : 0u));
+  BOOST_TEST(bob->compression_statistics().uncompressed ==
+             (compressed ? 3u : 0u));
+}
+
+ELLE_TEST_SCHEDULED(compression_negotiation)
+{
+  using Compression = elle::protocol::Compression;
+  auto const v5 = elle::Version(0, 5, 0);
+  auto const v6 = elle::Version(0, 6, 0);
+  auto const stream = Compression::Settings{
+    Compression::all, Compression::Mode::stream, 256, -1};
+  _compression_negotiation(v6, Compression::Settings{}, stream, true);
+  _compression_negotiation(v6, stream, stream, true);
+  // Compression is only used if both ends enable it.
+  _compression_negotiation(v6, stream, boost::none, false);
+  // Older peers don't compress.
+  _compression_negotiation(v5, stream, stream, false);
+}
+
+/*-----------.
+| Coalescing |
+`-----------*/
+
+// Run @a f with a coalescing serializer and its peer over loopback TCP.
+template <typename F>
+static
+void
+_coalescing(elle::protocol::Serializer::Coalescing coalescing,
+            elle::Buffer::Size chunk_size,
+            F const& f)
+{
+  namespace ip = elle::protocol;
+  auto server = elle::reactor::network::TCPServer{};
+  server.listen();
+  std::unique_ptr<elle::reactor::network::Socket> socket;
+  std::unique_ptr<ip::Serializer> reader;
+  elle::reactor::network::TCPSocket client("127.0.0.1", server.port());
+  std::unique_ptr<ip::Serializer> writer;
+  elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+  {
+    scope.run_background(
+      "reader",
+      [&]
+      {
+        socket = server.accept();
+        reader = std::make_unique<ip::Serializer>(
+          *socket, elle::Version(0, 4, 0), true,
+          boost::none, boost::none, chunk_size);
+      });
+    writer = std::make_unique<ip::Serializer>(
+      client, elle::Version(0, 4, 0), true,
+      boost::none, boost::none, chunk_size, ip::Checksum::all, coalescing);
+    elle::reactor::wait(scope);
+  };
+  f(*writer, *reader);
+}
+
+// Packets written concurrently are sent together, framed as usual.
+ELLE_TEST_SCHEDULED(coalescing_packets)
+{
+  auto const count = 50;
+  auto packets = std::vector<elle::Buffer>{};
+  for (int i = 0; i < count; ++i)
+    packets.emplace_back(elle::sprintf("packet %s", i));
+  // Larger than a chunk.
+  packets.emplace_back(std::string(5000, 'l'));
+  _coalescing(
+    {1 << 20, std::chrono::milliseconds(10)}, 1024,
+    [&] (elle::protocol::Serializer& writer,
+         elle::protocol::Serializer& reader)
+    {
+      elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+      {
+        for (auto const& packet: packets)
+          scope.run_background(
+            elle::sprintf("write %f", packet),
+            [&] { writer.write(packet); });
+        for (auto const& packet: packets)
+          BOOST_TEST(reader.read() == packet);
+        elle::reactor::wait(scope);
+      };
+      BOOST_TEST_MESSAGE(elle::sprintf("%s packets sent in %s writes",
+                                       packets.size(), writer.flushes()));
+      BOOST_TEST(writer.flushes() == 1u);
+    });
+}
+
+// Queued packets are sent as soon as they reach the threshold.
+ELLE_TEST_SCHEDULED(coalescing_threshold)
+{
+  auto const packet = elle::Buffer(std::string(100, 't'));
+  _coalescing(
+    {250, std::chrono::seconds(60)}, 1024,
+    [&] (elle::protocol::Serializer& writer,
+         elle::protocol::Serializer& reader)
+    {
+      elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+      {
+        for (int i = 0; i < 3; ++i)
+          scope.run_background(elle::sprintf("write %s", i),
+                               [&] { writer.write(packet); });
+        for (int i = 0; i < 3; ++i)
+          BOOST_TEST(reader.read() == packet);
+        elle::reactor::wait(scope);
+      };
+      BOOST_TEST(writer.flushes() == 1u);
+    });
+}
+
+// A packet whose writer is terminated before it is sent is dropped, without
+// disturbing the other ones.
+ELLE_TEST_SCHEDULED(coalescing_interruption)
+{
+  auto const dropped = elle::Buffer("dropped");
+  auto const sent = elle::Buffer("sent");
+  _coalescing(
+    {1 << 20, std::chrono::milliseconds(50)}, 1024,
+    [&] (elle::protocol::Serializer& writer,
+         elle::protocol::Serializer& reader)
+    {
+      elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& scope)
+      {
+        auto& interrupted = scope.run_background(
+          "dropped", [&] { writer.write(dropped); });
+        scope.run_background("sent", [&] { writer.write(sent); });
+        elle::reactor::yield();
+        interrupted.terminate_now();
+        BOOST_TEST(reader.read() == sent);
+        elle::reactor::wait(scope);
+        writer.write(sent);
+        BOOST_TEST(reader.read() == sent);
+      };
+    });
+}
+
 ELLE_TEST_SUITE()
 {
   auto& suite = boost::unit_test::framework::master_test_suite();
   suite.add(BOOST_TEST_CASE(exchange_packets), 0, valgrind(10, 10));
   suite.add(BOOST_TEST_CASE(exchange), 0, valgrind(20, 10));
+  suite.add(BOOST_TEST_CASE(exchange_header), 0, valgrind(20, 10));
   suite.add(BOOST_TEST_CASE(connection_lost_reader), 0, valgrind(3, 10));
   suite.add(BOOST_TEST_CASE(connection_lost_sender), 0, valgrind(3, 10));
   suite.add(BOOST_TEST_CASE(corruption), 0, valgrind(3, 10));
+  suite.add(BOOST_TEST_CASE(checksum), 0, valgrind(3));
+  suite.add(BOOST_TEST_CASE(checksum_negotiation), 0, valgrind(10));
+  suite.add(BOOST_TEST_CASE(handshake_read_ahead), 0, valgrind(3));
   suite.add(BOOST_TEST_CASE(interruption), 0, valgrind(6, 15));
   suite.add(BOOST_TEST_CASE(interruption2), 0, valgrind(6, 15));
   {
@@ -1115,4 +1620,24 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(eof), 0, valgrind(3));
   suite.add(BOOST_TEST_CASE(message), 0, valgrind(3));
   suite.add(BOOST_TEST_CASE(ping), 0, valgrind(3));
+  if (benchmarks())
+    suite.add(BOOST_TEST_CASE(benchmark_round_trips), 0, valgrind(10, 10));
+  {
+    auto compression = BOOST_TEST_SUITE("compression");
+    suite.add(compression);
+    compression->add(
+      ELLE_TEST_CASE(::compression, "compression"), 0, valgrind(3));
+    compression->add(
+      ELLE_TEST_CASE(compression_negotiation, "negotiation"), 0, valgrind(5));
+  }
+  {
+    auto coalescing = BOOST_TEST_SUITE("coalescing");
+    suite.add(coalescing);
+    coalescing->add(
+      ELLE_TEST_CASE(coalescing_packets, "packets"), 0, valgrind(3));
+    coalescing->add(
+      ELLE_TEST_CASE(coalescing_threshold, "threshold"), 0, valgrind(3));
+    coalescing->add(
+      ELLE_TEST_CASE(coalescing_interruption, "interruption"), 0, valgrind(3));
+  }
 }
@@ -6,8 +6,19 @@
 # include <elle/reactor/backend/boost/backend.hh>
 #endif
 
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <memory>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <boost/range/algorithm/for_each.hpp>
 
+#include <elle/os/environ.hh>
+#include <elle/printf.hh>
+
 using elle::reactor::backend::Thread;
 
 namespace
@@ -125,6 +136,125 @@ namespace
     val *= 10;
     t->step();
   }
+
+  /// A Backend with lazy stacks or not, whatever REACTOR_STACK_LAZY says.
+  template <typename Backend>
+  std::unique_ptr<Backend>
+  make_backend(bool lazy)
+  {
+    auto const previous =
+      elle::os::getenv("REACTOR_STACK_LAZY", std::string());
+    elle::os::setenv("REACTOR_STACK_LAZY", lazy ? "1" : "0");
+    auto res = std::make_unique<Backend>();
+    if (previous.empty())
+      elle::os::unsetenv("REACTOR_STACK_LAZY");
+    else
+      elle::os::setenv("REACTOR_STACK_LAZY", previous);
+    return res;
+  }
+
+  /// Check stacks are recycled, and time short-lived threads creation.
+  template <typename Backend>
+  void
+  stack_pool(bool lazy)
+  {
+    auto const backend = make_backend<Backend>(lazy);
+    auto& m = *backend;
+    auto const base = m.stack_statistics();
+    {
+      auto small = m.make_thread("small", empty, 64 * 1024);
+      auto big = m.make_thread("big", empty);
+      small->step();
+      big->step();
+#if defined REACTOR_CORO_BACKEND_BOOST_CONTEXT
+      BOOST_TEST(m.stack_statistics().in_use == base.in_use + 2);
+#endif
+    }
+    auto const stats = m.stack_statistics();
+#if defined REACTOR_CORO_BACKEND_BOOST_CONTEXT
+    BOOST_TEST(stats.in_use == base.in_use);
+    BOOST_TEST(stats.pooled == base.pooled + 2);
+    BOOST_TEST(stats.high_water == base.in_use + 2);
+    // Stacks beyond the maximum size are refused, not clamped.
+    BOOST_CHECK_THROW(m.make_thread("huge", empty, 64 * 1024 * 1024),
+                      elle::Error);
+#endif
+    auto const count = 10000;
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+      auto t = m.make_thread("bench", empty);
+      t->step();
+    }
+    auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+    BOOST_TEST_MESSAGE(elle::sprintf("%s threads created in %sus",
+                                     count, elapsed.count()));
+    BOOST_TEST(m.stack_statistics().pooled == stats.pooled);
+  }
+
+  template <typename Backend>
+  void
+  test_stack_pool()
+  {
+    stack_pool<Backend>(false);
+  }
+
+  template <typename Backend>
+  void
+  test_stack_pool_lazy()
+  {
+    stack_pool<Backend>(true);
+  }
+
+#if defined REACTOR_CORO_BACKEND_BOOST_CONTEXT
+  /// Whether writing at @a address kills a child process.
+  bool
+  faults(char* address)
+  {
+    auto const pid = ::fork();
+    if (pid == 0)
+    {
+      // Die from the signal instead of reporting it to Boost.Test.
+      ::signal(SIGSEGV, SIG_DFL);
+      ::signal(SIGBUS, SIG_DFL);
+      *static_cast<char volatile*>(address) = 0;
+      ::_exit(0);
+    }
+    auto status = 0;
+    ::waitpid(pid, &status, 0);
+    return WIFSIGNALED(status) &&
+      (WTERMSIG(status) == SIGSEGV || WTERMSIG(status) == SIGBUS);
+  }
+
+  /// Check overflowing a stack hits its guard page, in both modes.
+  template <typename Backend>
+  void
+  test_stack_guard()
+  {
+    auto const page = std::uintptr_t(::sysconf(_SC_PAGESIZE));
+    auto const size = std::uintptr_t(64 * 1024);
+    for (auto lazy: {false, true})
+    {
+      auto const backend = make_backend<Backend>(lazy);
+      char* bottom = nullptr;
+      auto t = backend->make_thread(
+        "guarded",
+        [&]
+        {
+          // The stack starts at a page boundary, right above our frame.
+          char local;
+          auto const address = reinterpret_cast<std::uintptr_t>(&local);
+          auto const top = (address + page - 1) / page * page;
+          bottom = reinterpret_cast<char*>(top - size);
+        },
+        size);
+      t->step();
+      BOOST_TEST(!faults(bottom));
+      BOOST_TEST(faults(bottom - 1));
+    }
+  }
+#endif
 }
 
 ELLE_TEST_SUITE()
@@ -146,4 +276,9 @@ ELLE_TEST_SUITE()
   TEST(deadlock_switch);
   TEST(status);
   TEST(stack);
+  TEST(stack_pool);
+  TEST(stack_pool_lazy);
+#if defined REACTOR_CORO_BACKEND_BOOST_CONTEXT
+  TEST(stack_guard);
+#endif
 }
@@ -1,3 +1,5 @@
+#include <numeric>
+
 #include <elle/log.hh>
 #include <elle/test.hh>
 
@@ -80,6 +82,45 @@ ELLE_TEST_SCHEDULED(mutable_copiable)
   }
 }
 
+ELLE_TEST_SCHEDULED(bounded)
+{
+  auto v = std::vector<int>(100);
+  std::iota(v.begin(), v.end(), 0);
+  auto running = 0;
+  auto max_running = 0;
+  auto sum = 0;
+  elle::reactor::for_each_parallel(
+    v,
+    [&] (int i)
+    {
+      max_running = std::max(max_running, ++running);
+      elle::reactor::yield();
+      sum += i;
+      --running;
+    },
+    4);
+  BOOST_TEST(max_running == 4);
+  BOOST_TEST(sum == 4950);
+}
+
+ELLE_TEST_SCHEDULED(bounded_break)
+{
+  auto v = std::vector<int>(100);
+  std::iota(v.begin(), v.end(), 0);
+  auto processed = 0;
+  elle::reactor::for_each_parallel(
+    v,
+    [&] (int i)
+    {
+      if (i == 10)
+        elle::reactor::break_parallel();
+      ++processed;
+      elle::reactor::yield();
+    },
+    4);
+  BOOST_TEST(processed == 10);
+}
+
 // ELLE_TEST_SCHEDULED(moved_not_copiable)
 // {
 //   std::vector<std::unique_ptr<int>> v;
@@ -105,5 +146,7 @@ ELLE_TEST_SUITE()
   master.add(BOOST_TEST_CASE(const_not_copiable));
   master.add(BOOST_TEST_CASE(mutable_not_copiable));
   master.add(BOOST_TEST_CASE(mutable_copiable));
+  master.add(BOOST_TEST_CASE(bounded));
+  master.add(BOOST_TEST_CASE(bounded_break));
   // master.add(BOOST_TEST_CASE(moved_not_copiable));
 }
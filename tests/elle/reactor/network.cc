@@ -799,6 +799,48 @@ ELLE_TEST_SCHEDULED(async_write)
   elle::reactor::wait(read);
 }
 
+ELLE_TEST_SCHEDULED(write_gather)
+{
+  elle::reactor::network::TCPServer server;
+  server.listen();
+  auto const big = elle::Buffer(std::string(1 << 20, 'x'));
+  auto expected = elle::Buffer("foobarbaz");
+  expected.append(big.contents(), big.size());
+  expected.append("quux", 4);
+  elle::reactor::Barrier read;
+  elle::reactor::Thread accept(
+    "accept",
+    [&]
+    {
+      auto socket = server.accept();
+      BOOST_TEST(socket->read(expected.size()) == expected);
+      read.open();
+    });
+  elle::reactor::network::TCPSocket socket(
+    "localhost", server.local_endpoint().port());
+  boost::asio::deadline_timer t(elle::reactor::scheduler().io_service());
+  t.expires_from_now(boost::posix_time::milliseconds(100));
+  elle::reactor::Barrier written;
+  // Outside of a Thread, buffers are concatenated and written asynchronously.
+  t.async_wait([&] (boost::system::error_code const& e)
+               {
+                 BOOST_TEST(!e);
+                 socket.write(elle::reactor::network::Socket::Buffers{
+                     elle::ConstWeakBuffer("foo"),
+                     elle::ConstWeakBuffer(),
+                     elle::ConstWeakBuffer("bar"),
+                   });
+                 written.open();
+               });
+  elle::reactor::wait(written);
+  socket.write(elle::reactor::network::Socket::Buffers{
+      elle::ConstWeakBuffer("baz"),
+      big,
+      elle::ConstWeakBuffer("quux"),
+    });
+  elle::reactor::wait(read);
+}
+
 /*-----------.
 | Test suite |
 `-----------*/
@@ -838,4 +880,5 @@ ELLE_TEST_SUITE()
   suite.add(BOOST_TEST_CASE(read_terminate_recover_iostream), 0, 1);
   suite.add(BOOST_TEST_CASE(read_terminate_deadlock), 0, 1);
   suite.add(BOOST_TEST_CASE(async_write), 0, 10);
+  suite.add(BOOST_TEST_CASE(write_gather), 0, 10);
 }
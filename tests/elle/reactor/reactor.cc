@@ -1,10 +1,18 @@
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <thread>
+
+#include <time.h>
 
 #include "reactor.hh"
 
 #include <elle/finally.hh>
+#include <elle/json/json.hh>
 #include <elle/test.hh>
 
 #include <elle/reactor/BackgroundFuture.hh>
@@ -12,8 +20,10 @@
 #include <elle/reactor/Channel.hh>
 #include <elle/reactor/MultiLockBarrier.hh>
 #include <elle/reactor/OrWaitable.hh>
+#include <elle/reactor/SchedulerPool.hh>
 #include <elle/reactor/Scope.hh>
 #include <elle/reactor/TimeoutGuard.hh>
+#include <elle/reactor/WorkQueue.hh>
 #include <elle/reactor/asio.hh>
 #include <elle/reactor/duration.hh>
 #include <elle/reactor/exception.hh>
@@ -144,6 +154,125 @@ nested_schedulers()
   BOOST_CHECK(elle::reactor::Scheduler::scheduler() == nullptr);
 }
 
+// Benchmark context switches, both yielding and freezing.
+static
+void
+context_switches()
+{
+  elle::reactor::Scheduler sched;
+  auto const threads = 100;
+  auto const rounds = 1000;
+  auto switches = 0;
+  auto yielders = std::vector<std::unique_ptr<elle::reactor::Thread>>{};
+  for (int i = 0; i < threads; ++i)
+    yielders.emplace_back(
+      std::make_unique<elle::reactor::Thread>(
+        sched, "yielder",
+        [&]
+        {
+          for (int r = 0; r < rounds; ++r)
+          {
+            ++switches;
+            elle::reactor::yield();
+          }
+        }));
+  elle::reactor::Channel<int> ping;
+  elle::reactor::Channel<int> pong;
+  elle::reactor::Thread pinger(
+    sched, "ping",
+    [&]
+    {
+      for (int r = 0; r < threads * rounds; ++r)
+      {
+        ping.put(r);
+        BOOST_CHECK_EQUAL(pong.get(), r);
+      }
+    });
+  elle::reactor::Thread ponger(
+    sched, "pong",
+    [&]
+    {
+      for (int r = 0; r < threads * rounds; ++r)
+      {
+        pong.put(ping.get());
+        ++switches;
+      }
+    });
+  auto const start = std::chrono::steady_clock::now();
+  sched.run();
+  auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start);
+  BOOST_CHECK_EQUAL(switches, 2 * threads * rounds);
+  BOOST_TEST_MESSAGE(
+    elle::sprintf("%s context switches in %sus: %s/s",
+                  switches, elapsed.count(),
+                  switches * 1000000ll / std::max<long long>(elapsed.count(), 1)));
+}
+
+ELLE_TEST_SCHEDULED(statistics)
+{
+  auto& sched = elle::reactor::scheduler();
+  sched.long_step_threshold(valgrind(10_ms, 10));
+  auto const before = sched.statistics();
+  elle::reactor::Barrier barrier;
+  elle::reactor::Thread yielder(
+    "yielder",
+    [&]
+    {
+      for (int i = 0; i < 10; ++i)
+        elle::reactor::yield();
+    });
+  elle::reactor::Thread waiter(
+    "waiter",
+    [&]
+    {
+      elle::reactor::wait(barrier);
+      ::usleep(valgrind(20_ms, 10).total_microseconds());
+    });
+  elle::reactor::Thread opener("opener", [&] { barrier.open(); });
+  elle::reactor::Thread spinner(
+    "spinner",
+    [&]
+    {
+      auto const start = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start <
+             std::chrono::milliseconds(5))
+        ;
+    });
+  elle::reactor::yield();
+  {
+    auto const json = sched.statistics_json();
+    auto const& threads =
+      boost::any_cast<elle::json::Array const&>(json.at("threads"));
+    auto names = std::set<std::string>{};
+    for (auto const& t: threads)
+      names.insert(boost::any_cast<std::string>(
+                     boost::any_cast<elle::json::Object const&>(t).at("name")));
+    BOOST_CHECK(names.count("yielder"));
+    BOOST_CHECK(names.count("waiter"));
+    BOOST_CHECK(
+      boost::any_cast<std::size_t>(json.at("rounds")) > before.rounds);
+  }
+  elle::reactor::wait({yielder, waiter, opener, spinner});
+  BOOST_CHECK_EQUAL(yielder.statistics().steps, 11u);
+  BOOST_CHECK_EQUAL(yielder.statistics().yields, 10u);
+  BOOST_CHECK_EQUAL(yielder.statistics().freezes, 0u);
+  BOOST_CHECK_EQUAL(waiter.statistics().freezes, 1u);
+  BOOST_CHECK_GE(waiter.statistics().run_time, valgrind(20_ms, 10));
+  BOOST_CHECK_GE(waiter.statistics().longest_step, valgrind(20_ms, 10));
+  // Sleeping is not CPU time, spinning is.
+  BOOST_CHECK_LT(waiter.statistics().cpu_time, waiter.statistics().run_time);
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  BOOST_CHECK_GT(spinner.statistics().cpu_time, elle::reactor::Duration());
+#endif
+  BOOST_CHECK_GT(yielder.statistics().runnable_time,
+                 elle::reactor::Duration());
+  auto const after = sched.statistics();
+  BOOST_CHECK_EQUAL(after.long_steps, before.long_steps + 1);
+  BOOST_CHECK_GE(after.steps, before.steps + 11 + 2 + 1);
+  BOOST_CHECK_GE(after.max_round_callbacks, after.round_callbacks);
+}
+
 ELLE_TEST_SCHEDULED(managed)
 {
   elle::reactor::Thread t(
@@ -308,6 +437,30 @@ namespace waitable
     BOOST_CHECK_THROW(elle::reactor::wait(waitable), BeaconException);
   }
 
+  ELLE_TEST_SCHEDULED(names)
+  {
+    BOOST_CHECK_EQUAL(elle::reactor::Barrier().name(), std::string());
+    {
+      using namespace elle::reactor::literals;
+      BOOST_CHECK_EQUAL(elle::reactor::Barrier("literal"_literal).name(),
+                        std::string("literal"));
+    }
+    // Other strings, including arrays, are copied.
+    {
+      char buffer[] = "buffer";
+      elle::reactor::Signal signal(buffer);
+      buffer[0] = 'B';
+      BOOST_CHECK_EQUAL(signal.name(), std::string("buffer"));
+    }
+    auto source = std::make_unique<elle::reactor::Barrier>(
+      elle::sprintf("computed %s", 42));
+    elle::reactor::Barrier moved(std::move(*source));
+    // The computed name moves along with its storage.
+    BOOST_CHECK_EQUAL(source->name(), std::string());
+    source.reset();
+    BOOST_CHECK_EQUAL(moved.name(), std::string("computed 42"));
+  }
+
   ELLE_TEST_SCHEDULED(logical_or)
   {
     elle::reactor::Barrier a("A");
@@ -420,6 +573,73 @@ namespace waitable
     signal();
     elle::reactor::wait(waiter);
   }
+
+  ELLE_TEST_SCHEDULED(benchmark)
+  {
+    auto const rounds = 20000;
+    auto const elapsed = [] (std::chrono::steady_clock::time_point start)
+      {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start).count();
+      };
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+      elle::reactor::Barrier b;
+      elle::reactor::Signal s;
+    }
+    BOOST_TEST_MESSAGE(elle::sprintf("%s barriers and signals created in %sus",
+                                     rounds, elapsed(start)));
+    {
+      elle::reactor::Signal ping, pong;
+      elle::reactor::Thread t(
+        "pong",
+        [&]
+        {
+          for (int i = 0; i < rounds; ++i)
+          {
+            elle::reactor::wait(ping);
+            pong.signal();
+          }
+        });
+      while (ping.waiters().empty())
+        elle::reactor::yield();
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < rounds; ++i)
+      {
+        BOOST_REQUIRE(ping.signal());
+        elle::reactor::wait(pong);
+      }
+      BOOST_TEST_MESSAGE(elle::sprintf("%s signal wait/signal pairs in %sus",
+                                       rounds, elapsed(start)));
+      elle::reactor::wait(t);
+    }
+    {
+      elle::reactor::Barrier ping, pong;
+      elle::reactor::Thread t(
+        "pong",
+        [&]
+        {
+          for (int i = 0; i < rounds; ++i)
+          {
+            elle::reactor::wait(ping);
+            ping.close();
+            pong.open();
+          }
+        });
+      elle::reactor::yield();
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < rounds; ++i)
+      {
+        ping.open();
+        elle::reactor::wait(pong);
+        pong.close();
+      }
+      BOOST_TEST_MESSAGE(elle::sprintf("%s barrier wait/open pairs in %sus",
+                                       rounds, elapsed(start)));
+      elle::reactor::wait(t);
+    }
+  }
 }
 
 /*--------.
@@ -1084,6 +1304,100 @@ ELLE_TEST_SCHEDULED(test_sleep_timing)
   }
 }
 
+ELLE_TEST_SCHEDULED(timer_wheel)
+{
+  auto& timers = elle::reactor::scheduler().timers();
+  using Entry = elle::reactor::TimerWheel::Entry;
+  auto fired = std::vector<int>{};
+  Entry e1, e2, e3, e4;
+  timers.arm(e1, 30_ms, [&] { fired.emplace_back(1); });
+  timers.arm(e2, 10_ms, [&] { fired.emplace_back(2); });
+  timers.arm(e3, 20_ms, [&] { fired.emplace_back(3); });
+  timers.arm(e4, 0_ms, [&] { fired.emplace_back(4); });
+  // Rearming replaces the callback.
+  timers.arm(e3, 20_ms, [&] { fired.emplace_back(30); });
+  {
+    Entry destroyed;
+    timers.arm(destroyed, 1_ms, [&] { fired.emplace_back(0); });
+  }
+  e1.cancel();
+  BOOST_TEST(!e1.armed());
+  BOOST_TEST(e2.armed());
+  BOOST_TEST(timers.size() == 3);
+  elle::reactor::sleep(valgrind(100_ms, 10));
+  BOOST_TEST(fired == (std::vector<int>{4, 2, 30}));
+  BOOST_TEST(timers.size() == 0);
+  auto& service = elle::reactor::scheduler().io_service();
+  // Beyond one revolution of the wheel.
+  {
+    auto const slots = 16;
+    elle::reactor::TimerWheel wheel(service, 1_ms, slots);
+    Entry entry;
+    auto const far = wheel.resolution() * slots + 10_ms;
+    auto const start = now();
+    wheel.arm(entry, far, [&] { fired.emplace_back(5); });
+    elle::reactor::sleep(far + valgrind(50_ms, 10));
+    BOOST_TEST(fired.back() == 5);
+    BOOST_TEST((now() - start) >= far);
+  }
+  // Slots spanning several occupancy words, around the ring.
+  {
+    elle::reactor::TimerWheel wheel(service, 1_ms, 100);
+    auto order = std::vector<int>{};
+    Entry a, b, c;
+    wheel.arm(c, 90_ms, [&] { order.emplace_back(90); });
+    wheel.arm(a, 5_ms, [&] { order.emplace_back(5); });
+    wheel.arm(b, 70_ms, [&] { order.emplace_back(70); });
+    elle::reactor::sleep(valgrind(150_ms, 10));
+    BOOST_TEST(order == (std::vector<int>{5, 70, 90}));
+    BOOST_TEST(wheel.size() == 0);
+  }
+  // Null timeouts don't wait for the next tick.
+  {
+    elle::reactor::TimerWheel wheel(service, 60_min);
+    Entry entry;
+    wheel.arm(entry, 0_ms, [&] { fired.emplace_back(6); });
+    elle::reactor::yield();
+    elle::reactor::yield();
+    BOOST_TEST(fired.back() == 6);
+    BOOST_TEST(wheel.size() == 0);
+  }
+  // Arming and canceling read timeouts, with and without the wheel.
+  auto const count = 100000;
+  auto entries = std::vector<Entry>(count);
+  auto bench_start = std::chrono::steady_clock::now();
+  for (auto& e: entries)
+    timers.arm(e, 30_sec, [] {});
+  for (auto& e: entries)
+    e.cancel();
+  auto const wheel = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - bench_start);
+  auto asio = std::chrono::microseconds{};
+  {
+    auto deadlines =
+      std::vector<std::unique_ptr<boost::asio::deadline_timer>>{};
+    deadlines.reserve(count);
+    for (int i = 0; i < count; ++i)
+      deadlines.emplace_back(
+        std::make_unique<boost::asio::deadline_timer>(service));
+    bench_start = std::chrono::steady_clock::now();
+    for (auto& t: deadlines)
+    {
+      t->expires_from_now(30_sec);
+      t->async_wait([] (boost::system::error_code const&) {});
+    }
+    for (auto& t: deadlines)
+      t->cancel();
+    // Stop before destroying the timers, like for the wheel entries.
+    asio = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - bench_start);
+  }
+  BOOST_TEST_MESSAGE(
+    elle::sprintf("%s timeouts armed and canceled in %sus, %sus with asio",
+                  count, wheel.count(), asio.count()));
+  elle::reactor::yield();
+}
+
 /*------.
 | Every |
 `------*/
@@ -1448,6 +1762,66 @@ test_multithread_run_exception()
   runner.join();
 }
 
+static
+void
+test_multithread_run_async()
+{
+  elle::reactor::Scheduler sched;
+  elle::reactor::Signal terminate;
+  elle::reactor::Thread holder(sched, "holder",
+                               [&] { sched.current()->wait(terminate); });
+  boost::thread runner(std::bind(&elle::reactor::Scheduler::run, &sched));
+  static int const iterations = 10000;
+  {
+    auto const start = std::chrono::steady_clock::now();
+    auto results = std::vector<std::future<int>>{};
+    for (int i = 0; i < iterations; ++i)
+      results.emplace_back(
+        sched.mt_run_async<int>("async", [i] { return i; }));
+    long sum = 0;
+    for (auto& r: results)
+      sum += r.get();
+    BOOST_CHECK_EQUAL(sum, long(iterations) * (iterations - 1) / 2);
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_TEST_MESSAGE(
+      elle::sprintf(
+        "%s mt_run_async: %sms", iterations,
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+        .count()));
+  }
+  {
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations / 10; ++i)
+      BOOST_CHECK_EQUAL(sched.mt_run<int>("sync", [i] { return i; }), i);
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_TEST_MESSAGE(
+      elle::sprintf(
+        "%s mt_run: %sms", iterations / 10,
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+        .count()));
+  }
+  {
+    auto thrower = sched.mt_run_async<void>(
+      "thrower", [] { throw BeaconException(); });
+    // The foreign thread may poll.
+    while (thrower.wait_for(std::chrono::milliseconds(1)) !=
+           std::future_status::ready)
+      continue;
+    BOOST_CHECK_THROW(thrower.get(), BeaconException);
+  }
+  // Threads created from another system thread start in submission order.
+  {
+    auto order = std::vector<int>{};
+    for (int i = 0; i < 100; ++i)
+      sched.run_later("ordered", [&order, i] { order.push_back(i); });
+    sched.mt_run<void>("sync", [] {});
+    BOOST_CHECK_EQUAL(order.size(), 100u);
+    BOOST_CHECK(std::is_sorted(order.begin(), order.end()));
+  }
+  sched.mt_run<void>("terminator", [&] { terminate.signal(); });
+  runner.join();
+}
+
 static
 void
 test_multithread_deadlock_assert()
@@ -2664,6 +3038,67 @@ namespace background
     }
   }
 
+  ELLE_TEST_SCHEDULED(classes)
+  {
+    using elle::reactor::BackgroundClass;
+    auto& sched = elle::reactor::scheduler();
+    auto const cores = sched.background_pool_max(BackgroundClass::cpu);
+    BOOST_CHECK_GE(cores, 1);
+    sched.background_pool_max(BackgroundClass::blocking, 2);
+    auto const sleep_time = valgrind(200_ms, 5);
+    // Saturate the blocking pool, queuing half of its jobs.
+    int blocking = 0;
+    auto blockers = std::vector<std::unique_ptr<elle::reactor::Thread>>{};
+    for (int i = 0; i < 4; ++i)
+      blockers.emplace_back(
+        std::make_unique<elle::reactor::Thread>(
+          elle::sprintf("blocking %s", i),
+          [&]
+          {
+            elle::reactor::background(
+              [&] { ::usleep(sleep_time.total_microseconds()); });
+            ++blocking;
+          }));
+    auto const submitted = [&]
+      {
+        auto const stats =
+          sched.background_statistics(BackgroundClass::blocking);
+        return stats.queued + stats.running;
+      };
+    while (submitted() < 4)
+      elle::reactor::yield();
+    BOOST_CHECK_EQUAL(sched.background_pool_size(BackgroundClass::blocking),
+                      2);
+    // CPU jobs are not stuck behind them.
+    auto const start = boost::posix_time::microsec_clock::local_time();
+    std::atomic<int> sum(0);
+    for (int i = 0; i < cores * 2; ++i)
+      elle::reactor::background([&] { ++sum; }, BackgroundClass::cpu);
+    BOOST_CHECK_LT(boost::posix_time::microsec_clock::local_time() - start,
+                   sleep_time);
+    BOOST_CHECK_EQUAL(sum.load(), cores * 2);
+    BOOST_CHECK_EQUAL(blocking, 0);
+    BOOST_CHECK_LE(sched.background_pool_size(BackgroundClass::cpu), cores);
+    for (auto const& t: blockers)
+      elle::reactor::wait(*t);
+    BOOST_CHECK_EQUAL(blocking, 4);
+    BOOST_CHECK_EQUAL(sched.background_pool_size(BackgroundClass::blocking),
+                      2);
+    auto const cpu = sched.background_statistics(BackgroundClass::cpu);
+    BOOST_CHECK_EQUAL(cpu.jobs, std::size_t(cores * 2));
+    BOOST_CHECK_EQUAL(cpu.queued, 0);
+    auto const stats = sched.background_statistics(BackgroundClass::blocking);
+    BOOST_TEST_MESSAGE(
+      elle::sprintf("blocking pool: %s jobs, waited %s, ran %s",
+                    stats.jobs, stats.wait_time, stats.run_time));
+    BOOST_CHECK_EQUAL(stats.jobs, 4u);
+    BOOST_CHECK_EQUAL(stats.queued, 0);
+    BOOST_CHECK_EQUAL(stats.running, 0);
+    // The two queued jobs waited for a whole sleep.
+    BOOST_CHECK_GE(stats.wait_time, sleep_time * 2 - 20_ms);
+    BOOST_CHECK_GE(stats.run_time, sleep_time * 4 - 20_ms);
+  }
+
   ELLE_TEST_SCHEDULED(future)
   {
     ELLE_LOG("test plain value")
@@ -2916,6 +3351,189 @@ namespace channel
       elle::reactor::wait(t);
     }
   }
+
+  ELLE_TEST_SCHEDULED(bounded)
+  {
+    elle::reactor::Channel<int> c(2);
+    auto put = 0;
+    elle::reactor::Thread writer(
+      "writer",
+      [&]
+      {
+        for (int i = 0; i < 5; ++i)
+        {
+          c.put(i);
+          ++put;
+        }
+      });
+    elle::reactor::yield();
+    elle::reactor::yield();
+    BOOST_TEST(put == 2);
+    BOOST_TEST(c.size() == 2);
+    for (int i = 0; i < 5; ++i)
+      BOOST_TEST(c.get() == i);
+    elle::reactor::wait(writer);
+    BOOST_TEST(put == 5);
+  }
+
+  ELLE_TEST_SCHEDULED(bounded_clear)
+  {
+    elle::reactor::Channel<int> c(1);
+    auto put = 0;
+    elle::reactor::Thread writer(
+      "writer",
+      [&]
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          c.put(i);
+          ++put;
+        }
+      });
+    elle::reactor::yield();
+    elle::reactor::yield();
+    BOOST_TEST(put == 1);
+    // Clearing the channel makes room for the blocked writer.
+    c.clear();
+    elle::reactor::yield();
+    elle::reactor::yield();
+    BOOST_TEST(put == 2);
+    BOOST_TEST(c.get() == 1);
+    elle::reactor::wait(writer);
+    BOOST_TEST(put == 3);
+    BOOST_TEST(c.get() == 2);
+  }
+
+  ELLE_TEST_SCHEDULED(batch)
+  {
+    elle::reactor::Channel<std::unique_ptr<int>> c(4);
+    auto batches = std::vector<std::size_t>{};
+    elle::reactor::Thread reader(
+      "reader",
+      [&]
+      {
+        auto expected = 0;
+        while (expected < 10)
+        {
+          auto batch = c.get_many(3);
+          BOOST_TEST(!batch.empty());
+          BOOST_TEST(batch.size() <= 3u);
+          batches.push_back(batch.size());
+          for (auto const& i: batch)
+            BOOST_TEST(*i == expected++);
+        }
+      });
+    auto data = std::vector<std::unique_ptr<int>>{};
+    for (int i = 0; i < 10; ++i)
+      data.emplace_back(std::make_unique<int>(i));
+    // The batch exceeds the capacity: put_many waits for the reader.
+    c.put_many(std::move(data));
+    elle::reactor::wait(reader);
+    BOOST_TEST(c.empty());
+    BOOST_TEST(batches.size() < 10u);
+    // Exceptions are raised once data is exhausted.
+    c.put_many({});
+    c.put(std::make_unique<int>(42));
+    c.raise<BeaconException>();
+    BOOST_TEST(c.get_many().size() == 1u);
+    BOOST_CHECK_THROW(c.get_many(), BeaconException);
+  }
+
+  static
+  void
+  ring_queue()
+  {
+    static int alive = 0;
+    struct Counted
+    {
+      Counted(int i) : i(i) { ++alive; }
+      Counted(Counted&& c) : i(c.i) { ++alive; }
+      ~Counted() { --alive; }
+      int i;
+    };
+    {
+      elle::reactor::RingQueue<Counted> q;
+      auto next = 0;
+      auto first = 0;
+      // Interleave pushes and pops so the ring wraps around while growing.
+      for (int round = 0; round < 100; ++round)
+      {
+        for (int i = 0; i < 3; ++i)
+          q.emplace(next++);
+        q.pop();
+        ++first;
+        BOOST_TEST(q.front().i == first);
+        BOOST_TEST(q.back().i == next - 1);
+        BOOST_TEST(q.size() == std::size_t(next - first));
+        BOOST_TEST(alive == next - first);
+      }
+      BOOST_TEST(q.capacity() == 256u);
+      auto moved = std::move(q);
+      BOOST_TEST(q.empty());
+      BOOST_TEST(moved.front().i == first);
+      q = std::move(moved);
+      BOOST_TEST(q.size() == 200u);
+    }
+    BOOST_TEST(alive == 0);
+  }
+
+  static
+  void
+  benchmark()
+  {
+    static int const count = 200000;
+    auto run = [] (auto& c, bool batch)
+      {
+        elle::reactor::Scheduler sched;
+        elle::reactor::Thread reader(
+          sched, "reader",
+          [&]
+          {
+            auto got = 0;
+            while (got < count)
+              if (batch)
+                got += c.get_many(64).size();
+              else
+              {
+                c.get();
+                ++got;
+              }
+          });
+        elle::reactor::Thread writer(
+          sched, "writer",
+          [&]
+          {
+            for (int i = 0; i < count; i += 64)
+              if (batch)
+                c.put_many(std::vector<int>(64, i));
+              else
+                for (int j = 0; j < 64; ++j)
+                  c.put(i);
+          });
+        auto const start = std::chrono::steady_clock::now();
+        sched.run();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start).count();
+      };
+    {
+      elle::reactor::Channel<int, std::queue<int>> c(1024);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("deque, put/get: %sms", run(c, false)));
+      BOOST_TEST(c.empty());
+    }
+    {
+      elle::reactor::Channel<int> c(1024);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("ring, put/get: %sms", run(c, false)));
+      BOOST_TEST(c.empty());
+    }
+    {
+      elle::reactor::Channel<int> c(1024);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("ring, put_many/get_many: %sms", run(c, true)));
+      BOOST_TEST(c.empty());
+    }
+  }
 }
 
 ELLE_TEST_SCHEDULED(test_released_signal)
@@ -3359,6 +3977,245 @@ namespace for_each
   }
 }
 
+/*-----------.
+| Work queue |
+`-----------*/
+
+namespace work_queue
+{
+  ELLE_TEST_SCHEDULED(unordered)
+  {
+    elle::With<elle::reactor::Scope>() << [] (elle::reactor::Scope& s)
+    {
+      auto running = 0;
+      auto max_running = 0;
+      elle::reactor::WorkQueue<int, int> q(
+        s, "square", 3,
+        [&] (int i)
+        {
+          max_running = std::max(max_running, ++running);
+          for (int y = 0; y <= i % 4; ++y)
+            elle::reactor::yield();
+          --running;
+          return i * i;
+        },
+        2);
+      for (int i = 0; i < 50; ++i)
+      {
+        q.push(i);
+        // Backpressure: at most one item per worker and the capacity pending.
+        BOOST_CHECK_LE(q.pushed() - q.processed(), 3u + 2u + 1u);
+      }
+      auto results = q.finish();
+      BOOST_CHECK_EQUAL(q.processed(), 50u);
+      BOOST_CHECK_EQUAL(max_running, 3);
+      std::sort(results.begin(), results.end());
+      BOOST_CHECK_EQUAL(results.size(), 50u);
+      for (int i = 0; i < 50; ++i)
+        BOOST_CHECK_EQUAL(results[i], i * i);
+    };
+  }
+
+  ELLE_TEST_SCHEDULED(ordered)
+  {
+    elle::With<elle::reactor::Scope>() << [] (elle::reactor::Scope& s)
+    {
+      // Later items complete first.
+      elle::reactor::WorkQueue<int, std::string> q(
+        s, "print", 10,
+        [] (int i)
+        {
+          for (int y = 0; y < 10 - i; ++y)
+            elle::reactor::yield();
+          return std::to_string(i);
+        },
+        10, true);
+      for (int i = 0; i < 10; ++i)
+        q.push(i);
+      BOOST_CHECK_EQUAL(
+        q.finish(),
+        (std::vector<std::string>{
+          "0", "1", "2", "3", "4", "5", "6", "7", "8", "9"}));
+    };
+  }
+
+  ELLE_TEST_SCHEDULED(exception)
+  {
+    auto processed = 0;
+    BOOST_CHECK_THROW(
+      elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+      {
+        elle::reactor::WorkQueue<int> q(
+          s, "throw", 2,
+          [&] (int i)
+          {
+            if (i == 5)
+              throw BeaconException();
+            ++processed;
+            elle::reactor::yield();
+          });
+        for (int i = 0; i < 100; ++i)
+          q.push(i);
+        q.finish();
+        BOOST_ERROR("finished despite the exception");
+      },
+      BeaconException);
+    BOOST_CHECK_LT(processed, 10);
+  }
+
+  ELLE_TEST_SCHEDULED(cancel)
+  {
+    elle::reactor::Barrier started;
+    elle::With<elle::reactor::Scope>() << [&] (elle::reactor::Scope& s)
+    {
+      elle::reactor::WorkQueue<int> q(
+        s, "block", 2,
+        [&] (int)
+        {
+          started.open();
+          elle::reactor::sleep();
+        });
+      for (int i = 0; i < 4; ++i)
+        q.push(i);
+      elle::reactor::wait(started);
+      BOOST_CHECK_EQUAL(q.processed(), 0u);
+      // Destruction terminates the blocked workers.
+    };
+    BOOST_CHECK(started.opened());
+  }
+}
+
+/*---------------.
+| Scheduler pool |
+`---------------*/
+
+namespace scheduler_pool
+{
+  static
+  void
+  basics()
+  {
+    elle::reactor::SchedulerPool pool(4);
+    BOOST_CHECK_EQUAL(pool.size(), 4);
+    // Boost.Test is not thread-safe: gather results and check them from the
+    // main thread.
+    std::mutex mutex;
+    auto schedulers = std::set<elle::reactor::Scheduler*>{};
+    for (int i = 0; i < 64; ++i)
+      pool.spawn(
+        elle::sprintf("job %s", i),
+        [&]
+        {
+          // Stay busy while the other jobs are spawned, so they're spread.
+          elle::reactor::sleep(10_ms);
+          std::unique_lock<std::mutex> lock(mutex);
+          schedulers.insert(&elle::reactor::scheduler());
+        });
+    pool.wait();
+    BOOST_CHECK_EQUAL(schedulers.size(), 4u);
+    for (int i = 0; i < pool.size(); ++i)
+      schedulers.erase(&pool.scheduler(i));
+    BOOST_CHECK(schedulers.empty());
+  }
+
+  static
+  void
+  exception()
+  {
+    elle::reactor::SchedulerPool pool(2);
+    pool.spawn("throw", [] { throw BeaconException(); });
+    pool.spawn("yield", [] { elle::reactor::yield(); });
+    BOOST_CHECK_THROW(pool.wait(), BeaconException);
+    // The pool is still usable.
+    pool.spawn("yield", [] { elle::reactor::yield(); });
+    pool.wait();
+  }
+
+  // Block both scheduler system threads, one of them for good, and check the
+  // jobs queued on the blocked one are picked up by the other.
+  static
+  void
+  steal()
+  {
+    elle::reactor::SchedulerPool pool(2);
+    std::atomic<bool> blocked(true);
+    std::atomic<int> started(0);
+    std::atomic<int> count(0);
+    pool.spawn("block",
+               [&]
+               {
+                 ++started;
+                 while (blocked)
+                   std::this_thread::sleep_for(std::chrono::milliseconds(1));
+               });
+    pool.spawn("hold",
+               [&]
+               {
+                 ++started;
+                 std::this_thread::sleep_for(std::chrono::milliseconds(50));
+               });
+    while (started != 2)
+      std::this_thread::yield();
+    for (int i = 0; i < 16; ++i)
+      pool.spawn("count",
+                 [&]
+                 {
+                   if (++count == 16)
+                     blocked = false;
+                 });
+    pool.wait();
+    BOOST_CHECK_EQUAL(count.load(), 16);
+    BOOST_CHECK_GT(pool.stolen(), 0);
+  }
+
+  // Benchmark ping-pong between pairs of threads on 1 to N schedulers.
+  static
+  void
+  ping_pong()
+  {
+    auto const pairs = 64;
+    auto const rounds = 1000;
+    auto const cores =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int size = 1; size <= cores; size *= 2)
+    {
+      elle::reactor::SchedulerPool pool(size);
+      // Boost.Test is not thread-safe: count mismatches, check them after.
+      std::atomic<int> mismatches(0);
+      auto const start = std::chrono::steady_clock::now();
+      for (int p = 0; p < pairs; ++p)
+        pool.spawn(
+          "pair",
+          [&]
+          {
+            elle::reactor::Channel<int> ping;
+            elle::reactor::Channel<int> pong;
+            elle::reactor::Thread ponger(
+              "pong",
+              [&]
+              {
+                for (int i = 0; i < rounds; ++i)
+                  pong.put(ping.get());
+              });
+            for (int i = 0; i < rounds; ++i)
+            {
+              ping.put(i);
+              if (pong.get() != i)
+                ++mismatches;
+            }
+            elle::reactor::wait(ponger);
+          });
+      pool.wait();
+      BOOST_CHECK_EQUAL(mismatches.load(), 0);
+      auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("ping-pong on %s schedulers: %s round trips in %sus",
+                      size, pairs * rounds, elapsed.count()));
+    }
+  }
+}
+
 /*-----.
 | Main |
 `-----*/
@@ -3371,6 +4228,8 @@ ELLE_TEST_SUITE()
     basics->add(BOOST_TEST_CASE(test_basics_one), 0, valgrind(1, 5));
     basics->add(BOOST_TEST_CASE(test_basics_interleave), 0, valgrind(1, 5));
     basics->add(BOOST_TEST_CASE(nested_schedulers), 0, valgrind(1, 5));
+    basics->add(BOOST_TEST_CASE(context_switches), 0, valgrind(30, 5));
+    basics->add(BOOST_TEST_CASE(statistics), 0, valgrind(1, 5));
     basics->add(BOOST_TEST_CASE(managed), 0, valgrind(1, 5));
     basics->add(BOOST_TEST_CASE(non_managed), 0, valgrind(1, 5));
     basics->add(BOOST_TEST_CASE(unique_ptr), 0, valgrind(1, 5));
@@ -3389,6 +4248,17 @@ ELLE_TEST_SUITE()
     channels->add(BOOST_TEST_CASE(open_close), 0, valgrind(1, 5));
     auto exception = &channel::exception;
     channels->add(BOOST_TEST_CASE(exception), 0, valgrind(1, 5));
+    auto bounded = &channel::bounded;
+    channels->add(BOOST_TEST_CASE(bounded), 0, valgrind(1, 5));
+    auto bounded_clear = &channel::bounded_clear;
+    channels->add(BOOST_TEST_CASE(bounded_clear), 0, valgrind(1, 5));
+    auto batch = &channel::batch;
+    channels->add(BOOST_TEST_CASE(batch), 0, valgrind(1, 5));
+    auto ring_queue = &channel::ring_queue;
+    channels->add(BOOST_TEST_CASE(ring_queue), 0, valgrind(1, 5));
+    auto benchmark = &channel::benchmark;
+    if (benchmarks())
+      channels->add(BOOST_TEST_CASE(benchmark), 0, valgrind(10, 5));
   }
 
   {
@@ -3396,11 +4266,14 @@ ELLE_TEST_SUITE()
     boost::unit_test::framework::master_test_suite().add(subsuite);
     using namespace waitable;
     subsuite->add(BOOST_TEST_CASE(exception_no_wait), 0, valgrind(1, 5));
+    subsuite->add(BOOST_TEST_CASE(names), 0, valgrind(1, 5));
     subsuite->add(BOOST_TEST_CASE(logical_or), 0, valgrind(1, 5));
     subsuite->add(BOOST_TEST_CASE(boost_signal), 0, valgrind(1, 5));
     subsuite->add(BOOST_TEST_CASE(boost_signal_args), 0, valgrind(1, 5));
     subsuite->add(BOOST_TEST_CASE(boost_signal_predicate), 0, valgrind(1, 5));
     subsuite->add(BOOST_TEST_CASE(boost_signal_waiter), 0, valgrind(1, 5));
+    if (benchmarks())
+      subsuite->add(BOOST_TEST_CASE(benchmark), 0, valgrind(10, 5));
   }
 
   boost::unit_test::test_suite* signals = BOOST_TEST_SUITE("Signals");
@@ -3476,6 +4349,7 @@ ELLE_TEST_SUITE()
     boost::unit_test::framework::master_test_suite().add(sleep);
     sleep->add(BOOST_TEST_CASE(test_sleep_interleave), 0, valgrind(1, 5));
     sleep->add(BOOST_TEST_CASE(test_sleep_timing), 0, valgrind(10, 3));
+    sleep->add(BOOST_TEST_CASE(timer_wheel), 0, valgrind(30, 3));
   }
 
   {
@@ -3536,6 +4410,7 @@ ELLE_TEST_SUITE()
   mt->add(BOOST_TEST_CASE(test_multithread_spawn_wake), 0, valgrind(1, 5));
   mt->add(BOOST_TEST_CASE(test_multithread_run), 0, valgrind(1, 5));
   mt->add(BOOST_TEST_CASE(test_multithread_run_exception), 0, valgrind(1, 5));
+  mt->add(BOOST_TEST_CASE(test_multithread_run_async), 0, valgrind(5, 5));
   mt->add(BOOST_TEST_CASE(test_multithread_deadlock_assert), 0, valgrind(1, 5));
 #endif
 
@@ -3582,6 +4457,7 @@ ELLE_TEST_SUITE()
     using namespace background;
     background->add(BOOST_TEST_CASE(aborted), 0, valgrind(1, 5));
     background->add(BOOST_TEST_CASE(aborted_throw), 0, valgrind(1, 5));
+    background->add(BOOST_TEST_CASE(classes), 0, valgrind(3, 10));
     background->add(BOOST_TEST_CASE(exception), 0, valgrind(1, 5));
     background->add(BOOST_TEST_CASE(future), 0, valgrind(2, 5));
     background->add(BOOST_TEST_CASE(operation), 0, valgrind(3, 10));
@@ -3630,4 +4506,29 @@ ELLE_TEST_SUITE()
     auto parallel_break = &for_each::parallel_break;
     s->add(BOOST_TEST_CASE(parallel_break));
   }
+
+  {
+    boost::unit_test::test_suite* s = BOOST_TEST_SUITE("work-queue");
+    boost::unit_test::framework::master_test_suite().add(s);
+    using namespace work_queue;
+    s->add(BOOST_TEST_CASE(unordered), 0, valgrind(1, 5));
+    s->add(BOOST_TEST_CASE(ordered), 0, valgrind(1, 5));
+    s->add(BOOST_TEST_CASE(exception), 0, valgrind(1, 5));
+    s->add(BOOST_TEST_CASE(cancel), 0, valgrind(1, 5));
+  }
+
+#if !defined INFINIT_ANDROID
+  {
+    boost::unit_test::test_suite* s = BOOST_TEST_SUITE("scheduler_pool");
+    boost::unit_test::framework::master_test_suite().add(s);
+    auto basics = &scheduler_pool::basics;
+    s->add(BOOST_TEST_CASE(basics), 0, valgrind(1, 5));
+    auto exception = &scheduler_pool::exception;
+    s->add(BOOST_TEST_CASE(exception), 0, valgrind(1, 5));
+    auto steal = &scheduler_pool::steal;
+    s->add(BOOST_TEST_CASE(steal), 0, valgrind(5, 5));
+    auto ping_pong = &scheduler_pool::ping_pong;
+    s->add(BOOST_TEST_CASE(ping_pong), 0, valgrind(30, 5));
+  }
+#endif
 }
@@ -1,5 +1,7 @@
+#include <chrono>
 #include <deque>
 #include <list>
+#include <map>
 #include <sstream>
 #include <string>
 #include <unordered_set>
@@ -15,6 +17,43 @@
 
 ELLE_LOG_COMPONENT("elle.serialization.test");
 
+/// JSON written and parsed as it is (de)serialized.
+class JsonStream
+{
+public:
+  class SerializerIn
+    : public elle::serialization::json::SerializerIn
+  {
+  public:
+    using Super = elle::serialization::json::SerializerIn;
+    SerializerIn(std::istream& input, bool versioned = true)
+      : Super(input, versioned, true)
+    {}
+
+    SerializerIn(std::istream& input,
+                 Versions versions,
+                 bool versioned = true)
+      : Super(input, std::move(versions), versioned, true)
+    {}
+  };
+
+  class SerializerOut
+    : public elle::serialization::json::SerializerOut
+  {
+  public:
+    using Super = elle::serialization::json::SerializerOut;
+    SerializerOut(std::ostream& output, bool versioned = true)
+      : Super(output, versioned, false, true)
+    {}
+
+    SerializerOut(std::ostream& output,
+                  Versions versions,
+                  bool versioned = true)
+      : Super(output, std::move(versions), versioned, false, true)
+    {}
+  };
+};
+
 class InPlace
 {
 public:
@@ -518,6 +557,7 @@ unordered_set()
   }
 }
 
+template <typename Format>
 static
 void
 unordered_map_string_legacy()
@@ -543,9 +583,9 @@ unordered_map_string_legacy()
                 [\"drip_ghost-reminder_template\",\"control\"],\
                 [\"drip_delight-sender_template\",\"a\"]\
                 ],}";
-  auto input = elle::serialization::json::SerializerIn{stream};
+  auto input = typename Format::SerializerIn{stream};
   BOOST_CHECK_EQUAL(reference,
-                    input.deserialize<Map>("features"));
+                    input.template deserialize<Map>("features"));
 }
 
 template <typename Format>
@@ -1307,6 +1347,7 @@ check_min_max(elle::serialization::json::SerializerIn& i,
 template <typename T>
 using lim = std::numeric_limits<T>;
 
+template <typename Format>
 static
 void
 json_overflows()
@@ -1338,7 +1379,7 @@ json_overflows()
     "  \"size_t_max\": " + std::to_string(lim<size_t>::max()) + ","
     "}"
     );
-  auto input = typename elle::serialization::json::SerializerIn(stream);
+  auto input = typename Format::SerializerIn(stream);
   using Overflow = elle::serialization::json::Overflow;
   int8_t i8;
   uint8_t ui8;
@@ -1522,13 +1563,15 @@ text_parser()
   std::stringstream stream;
   {
     typename Format::SerializerOut ser(stream);
-    BOOST_CHECK_EQUAL(ser.text(),
-                      (std::is_same<Format, elle::serialization::Json>::value));
+    BOOST_CHECK_EQUAL(
+      ser.text(),
+      (!std::is_same<Format, elle::serialization::Binary>::value));
   }
   {
     typename Format::SerializerIn ser(stream);
-    BOOST_CHECK_EQUAL(ser.text(),
-                      (std::is_same<Format, elle::serialization::Json>::value));
+    BOOST_CHECK_EQUAL(
+      ser.text(),
+      (!std::is_same<Format, elle::serialization::Binary>::value));
   }
 }
 
@@ -1742,11 +1785,288 @@ convert()
   }
 }
 
+static
+void
+json_stream_compact()
+{
+  std::stringstream stream;
+  {
+    JsonStream::SerializerOut output(stream, false);
+    auto name = std::string("\"quoted\\\" \n\t\x07 é");
+    output.serialize("name", name);
+    auto size = 42;
+    output.serialize("size", size);
+    auto missing = boost::optional<int>{};
+    output.serialize("missing", missing);
+    auto values = std::vector<boost::optional<int>>{1, boost::none, 3};
+    output.serialize("values", values);
+    auto ratio = 0.1;
+    output.serialize("ratio", ratio);
+    auto round = 2.;
+    output.serialize("round", round);
+    auto empty = std::map<std::string, int>{};
+    output.serialize("empty", empty);
+    auto point = Point(1, 2);
+    output.serialize("point", point);
+  }
+  // Keys come in the order they are serialized.
+  BOOST_CHECK_EQUAL(
+    stream.str(),
+    "{\"name\":\"\\\"quoted\\\\\\\" \\n\\t\\u0007 é\",\"size\":42,"
+    "\"values\":[1,null,3],\"ratio\":0.1,\"round\":2.0,\"empty\":null,"
+    "\"point\":{\"x\":1,\"y\":2}}\n");
+  auto const json = elle::json::read(stream);
+  auto const& object = boost::any_cast<elle::json::Object const&>(json);
+  BOOST_CHECK_EQUAL(boost::any_cast<std::string>(object.at("name")),
+                    "\"quoted\\\" \n\t\x07 é");
+  BOOST_CHECK_EQUAL(boost::any_cast<double>(object.at("ratio")), 0.1);
+  BOOST_CHECK(!object.count("missing"));
+}
+
+static
+void
+json_stream_pretty()
+{
+  std::stringstream stream;
+  {
+    elle::serialization::json::SerializerOut output(stream, false, true, true);
+    auto a = 1;
+    output.serialize("a", a);
+    auto b = std::vector<int>{1, 2};
+    output.serialize("b", b);
+    auto c = std::vector<int>{};
+    output.serialize("c", c);
+    auto d = std::map<std::string, std::string>{{"e", "f"}};
+    output.serialize("d", d);
+  }
+  BOOST_CHECK_EQUAL(stream.str(),
+                    "{\n"
+                    "    \"a\" : 1,\n"
+                    "    \"b\" : [\n"
+                    "        1,\n"
+                    "        2\n"
+                    "    ],\n"
+                    "    \"c\" : [],\n"
+                    "    \"d\" : {\n"
+                    "        \"e\" : \"f\"\n"
+                    "    }\n"
+                    "}");
+}
+
+// A moved serializer writes one document, the moved-from one nothing.
+static
+void
+json_move()
+{
+  for (auto stream_mode: {false, true})
+  {
+    std::stringstream stream;
+    {
+      elle::serialization::json::SerializerOut source(
+        stream, false, false, stream_mode);
+      auto a = 1;
+      source.serialize("a", a);
+      auto output =
+        elle::serialization::json::SerializerOut(std::move(source));
+      auto b = std::vector<int>{1, 2};
+      output.serialize("b", b);
+    }
+    auto const json = elle::json::read(stream);
+    auto const& object = boost::any_cast<elle::json::Object const&>(json);
+    BOOST_CHECK_EQUAL(object.size(), 2u);
+    BOOST_CHECK_EQUAL(boost::any_cast<int64_t>(object.at("a")), 1);
+    stream >> std::ws;
+    BOOST_CHECK(stream.peek() == std::char_traits<char>::eof());
+  }
+}
+
+static
+void
+json_stream_pull()
+{
+  std::stringstream stream(
+    "{"
+    "  \"list\": [1, 2, {\"x\": \"y\"}],"
+    "  \"dict\": {\"c\": 1.5, \"d\": null},"
+    "  \"string\": \"\\u00e9\\ud83d\\ude18\\n\\\"\","
+    "  \"bool\": true,"
+    "  \"big\": 18446744073709551615,"
+    "  \"small\": -9223372036854775808,"
+    "  \"large\": 5000000000,"
+    "}");
+  JsonStream::SerializerIn input(stream, false);
+  // Out of order.
+  auto string = std::string{};
+  input.serialize("string", string);
+  BOOST_CHECK_EQUAL(string, "é😘\n\"");
+  auto dict = std::map<std::string, boost::optional<double>>{};
+  input.serialize("dict", dict);
+  BOOST_CHECK_EQUAL(dict.size(), 2);
+  BOOST_CHECK_EQUAL(dict.at("c"), 1.5);
+  BOOST_CHECK(!dict.at("d"));
+  auto b = false;
+  input.serialize("bool", b);
+  BOOST_CHECK(b);
+  auto big = uint64_t{0};
+  input.serialize("big", big);
+  BOOST_CHECK_EQUAL(big, std::numeric_limits<uint64_t>::max());
+  auto small = int64_t{0};
+  input.serialize("small", small);
+  BOOST_CHECK_EQUAL(small, std::numeric_limits<int64_t>::min());
+  // Again.
+  string.clear();
+  input.serialize("string", string);
+  BOOST_CHECK_EQUAL(string, "é😘\n\"");
+  // Missing keys and options.
+  auto i = 42;
+  BOOST_CHECK_THROW(input.serialize("missing", i),
+                    elle::serialization::MissingKey);
+  auto option = boost::optional<int>{};
+  input.serialize("missing", option);
+  BOOST_CHECK(!option);
+  input.partial(true);
+  input.serialize("missing", i);
+  BOOST_CHECK_EQUAL(i, 42);
+  input.partial(false);
+  BOOST_CHECK_THROW(input.serialize("string", i),
+                    elle::serialization::TypeError);
+  BOOST_CHECK_THROW(input.serialize("dict", string),
+                    elle::serialization::TypeError);
+  BOOST_CHECK_THROW(input.serialize("large", i),
+                    elle::serialization::json::Overflow);
+}
+
+static
+void
+json_stream_pull_errors()
+{
+  auto const parse = [] (std::string const& json)
+    {
+      std::stringstream stream(json);
+      JsonStream::SerializerIn input(stream, false);
+      auto values = std::vector<int>{};
+      input.serialize("values", values);
+    };
+  BOOST_CHECK_THROW(parse(""), elle::serialization::Error);
+  BOOST_CHECK_THROW(parse("{\"values\" [1]}"), elle::serialization::Error);
+  BOOST_CHECK_THROW(parse("{\"values\": [1, 2}"), elle::serialization::Error);
+  BOOST_CHECK_THROW(parse("{\"values\": [1, \"2]}"),
+                    elle::serialization::Error);
+  BOOST_CHECK_THROW(parse("{\"other\": [1, 2"), elle::serialization::Error);
+  BOOST_CHECK_NO_THROW(parse("{\"values\": [1, 2]} garbage"));
+}
+
+// Only one value is read, leaving the following ones in the stream.
+static
+void
+json_stream_pull_documents()
+{
+  std::stringstream stream("{\"value\": 1}\n{\"value\": 2} [3]");
+  for (int i = 1; i <= 2; ++i)
+  {
+    JsonStream::SerializerIn input(stream, false);
+    auto value = 0;
+    input.serialize("value", value);
+    BOOST_CHECK_EQUAL(value, i);
+  }
+  auto const rest =
+    boost::any_cast<elle::json::Array>(elle::json::read(stream));
+  BOOST_CHECK_EQUAL(rest.size(), 1);
+}
+
+namespace
+{
+  struct Entry
+  {
+    Entry()
+      : size(0)
+    {}
+
+    Entry(int i)
+      : name(elle::sprintf("directory/file-%s.txt", i))
+      , size(i * 4096)
+      , owner("user")
+      , blocks{elle::sprintf("%040d", i), elle::sprintf("%040d", i + 1)}
+    {}
+
+    void
+    serialize(elle::serialization::Serializer& s)
+    {
+      s.serialize("name", this->name);
+      s.serialize("size", this->size);
+      s.serialize("owner", this->owner);
+      s.serialize("blocks", this->blocks);
+    }
+
+    bool
+    operator ==(Entry const& other) const
+    {
+      return this->name == other.name && this->size == other.size &&
+        this->owner == other.owner && this->blocks == other.blocks;
+    }
+
+    std::string name;
+    int64_t size;
+    std::string owner;
+    std::vector<std::string> blocks;
+  };
+}
+
+static
+void
+json_stream_benchmark()
+{
+  using Clock = std::chrono::steady_clock;
+  auto listing = std::vector<Entry>{};
+  for (int i = 0; i < 20000; ++i)
+    listing.emplace_back(i);
+  auto const run = [&] (bool stream)
+    {
+      auto output = std::stringstream{};
+      auto const start = Clock::now();
+      {
+        elle::serialization::json::SerializerOut serializer(
+          output, false, false, stream);
+        serializer.serialize("listing", listing);
+      }
+      auto const seconds = std::chrono::duration<double>(
+        Clock::now() - start).count();
+      auto const size = output.str().size();
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("%s: wrote %s bytes in %.3fs, %.1f MB/s",
+                      stream ? "stream" : "DOM", size, seconds,
+                      size / seconds / 1e6));
+      auto const read_start = Clock::now();
+      auto read = std::vector<Entry>{};
+      {
+        elle::serialization::json::SerializerIn serializer(
+          output, false, stream);
+        serializer.serialize("listing", read);
+      }
+      auto const read_seconds = std::chrono::duration<double>(
+        Clock::now() - read_start).count();
+      BOOST_TEST_MESSAGE(
+        elle::sprintf("%s: read %s bytes in %.3fs, %.1f MB/s",
+                      stream ? "stream" : "DOM", size, read_seconds,
+                      size / read_seconds / 1e6));
+      BOOST_CHECK_EQUAL(read.size(), listing.size());
+      BOOST_CHECK(read.back() == listing.back());
+      return output.str();
+    };
+  auto const dom = run(false);
+  auto const streamed = run(true);
+  BOOST_CHECK_EQUAL(
+    elle::json::pretty_print(elle::json::read(dom)),
+    elle::json::pretty_print(elle::json::read(streamed)));
+}
+
 #define FOR_ALL_SERIALIZATION_TYPES(Name)                               \
   {                                                                     \
     boost::unit_test::test_suite* subsuite = BOOST_TEST_SUITE(#Name);   \
     auto json = &Name<elle::serialization::Json>;                       \
     subsuite->add(BOOST_TEST_CASE(json));                               \
+    auto json_stream = &Name<JsonStream>;                               \
+    subsuite->add(BOOST_TEST_CASE(json_stream));                        \
     auto binary = &Name<elle::serialization::Binary>;                   \
     subsuite->add(BOOST_TEST_CASE(binary));                             \
     suite.add(subsuite);                                                \
@@ -1780,6 +2100,8 @@ ELLE_TEST_SUITE()
       boost::unit_test::test_suite* s = BOOST_TEST_SUITE("unversioned");
       auto json = &hierarchy<elle::serialization::Json, false>;
       s->add(BOOST_TEST_CASE(json));
+      auto json_stream = &hierarchy<JsonStream, false>;
+      s->add(BOOST_TEST_CASE(json_stream));
       auto binary = &hierarchy<elle::serialization::Binary, false>;
       s->add(BOOST_TEST_CASE(binary));
       subsuite->add(s);
@@ -1788,6 +2110,8 @@ ELLE_TEST_SUITE()
       boost::unit_test::test_suite* s = BOOST_TEST_SUITE("versioned");
       auto json = &hierarchy<elle::serialization::Json, true>;
       s->add(BOOST_TEST_CASE(json));
+      auto json_stream = &hierarchy<JsonStream, true>;
+      s->add(BOOST_TEST_CASE(json_stream));
       auto binary = &hierarchy<elle::serialization::Binary, true>;
       s->add(BOOST_TEST_CASE(binary));
       subsuite->add(s);
@@ -1808,11 +2132,35 @@ ELLE_TEST_SUITE()
   FOR_ALL_SERIALIZATION_TYPES(text_parser);
   FOR_ALL_SERIALIZATION_TYPES(convert);
   suite.add(BOOST_TEST_CASE(in_place));
-  suite.add(BOOST_TEST_CASE(unordered_map_string_legacy));
+  {
+    auto unordered_map_string_legacy =
+      &::unordered_map_string_legacy<elle::serialization::Json>;
+    suite.add(BOOST_TEST_CASE(unordered_map_string_legacy));
+  }
   suite.add(BOOST_TEST_CASE(json_type_error));
   suite.add(BOOST_TEST_CASE(json_missing_key));
-  suite.add(BOOST_TEST_CASE(json_overflows));
+  {
+    auto json_overflows = &::json_overflows<elle::serialization::Json>;
+    suite.add(BOOST_TEST_CASE(json_overflows));
+  }
   suite.add(BOOST_TEST_CASE(json_iso8601));
   suite.add(BOOST_TEST_CASE(json_unicode_surrogate));
   suite.add(BOOST_TEST_CASE(json_optionals));
+  {
+    auto subsuite = BOOST_TEST_SUITE("json_stream");
+    master.add(subsuite);
+    subsuite->add(BOOST_TEST_CASE(json_stream_compact));
+    subsuite->add(BOOST_TEST_CASE(json_stream_pretty));
+    subsuite->add(BOOST_TEST_CASE(json_move));
+    subsuite->add(BOOST_TEST_CASE(json_stream_pull));
+    subsuite->add(BOOST_TEST_CASE(json_stream_pull_errors));
+    subsuite->add(BOOST_TEST_CASE(json_stream_pull_documents));
+    auto unordered_map_string_legacy =
+      &::unordered_map_string_legacy<JsonStream>;
+    subsuite->add(BOOST_TEST_CASE(unordered_map_string_legacy));
+    auto json_overflows = &::json_overflows<JsonStream>;
+    subsuite->add(BOOST_TEST_CASE(json_overflows));
+    if (benchmarks())
+      subsuite->add(BOOST_TEST_CASE(json_stream_benchmark));
+  }
 }
@@ -14,6 +14,7 @@
 
 #include <elle/Error.hh>
 #include <elle/log.hh>
+#include <elle/os/environ.hh>
 #include <elle/reactor/scheduler.hh>
 
 /// This header includes boost Unit Test Framework and provides a simple macro
@@ -314,3 +315,12 @@ valgrind(T base, int factor = 50)
 {
   return base * (RUNNING_ON_VALGRIND ? factor : 1) * (ARM_FACTOR ? factor : 1);
 }
+
+/// Whether to register benchmarks, which measure rather than check and are
+/// too slow for regular runs. Opt in by setting ELLE_TEST_BENCHMARK.
+inline
+bool
+benchmarks()
+{
+  return elle::os::getenv("ELLE_TEST_BENCHMARK", false);
+}